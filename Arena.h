@@ -0,0 +1,123 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @class Arena
+ * @brief Bump allocator for objects that share one lifetime, such as a batch or simulation run
+ *
+ * Allocation is a pointer bump inside large blocks; nothing is freed
+ * individually. reset() runs the destructors of every object created with
+ * create() (newest first) and rewinds to the first block, keeping the blocks
+ * for the next batch. Not thread-safe; use one arena per thread.
+ */
+class Arena
+{
+private:
+    /**
+     * @struct Finalizer
+     * @brief Destructor to run for a non-trivially destructible object on reset
+     */
+    struct Finalizer
+    {
+        void (*destroy)(void *); ///< Calls the object's destructor
+        void *object;            ///< Object to destroy
+    };
+
+    unsigned char **blocks; ///< Allocated blocks
+    size_t *blockSizes;     ///< Size of each block
+    int blockCount;         ///< Blocks allocated
+    int blockCapacity;      ///< Capacity of the block arrays
+    int currentBlock;       ///< Block being bumped (-1 before the first allocation)
+    size_t used;            ///< Bytes used in the current block
+    size_t defaultBlockSize; ///< Size of new blocks
+    size_t bytesAllocated;  ///< Bytes handed out since the last reset
+
+    Finalizer *finalizers;  ///< Destructors pending for reset
+    int finalizerCount;     ///< Entries in finalizers
+    int finalizerCapacity;  ///< Capacity of finalizers
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief Remembers a destructor to run on reset
+     */
+    void addFinalizer(void (*destroy)(void *), void *object);
+
+    template <class T>
+    static void destroyObject(void *object)
+    {
+        static_cast<T *>(object)->~T();
+    }
+
+public:
+    /**
+     * @brief Creates an empty arena
+     * @param blockSize Bytes per block (larger requests get their own block)
+     */
+    Arena(size_t blockSize = 64 * 1024);
+
+    /**
+     * @brief Runs pending destructors and frees every block
+     */
+    ~Arena();
+
+    /**
+     * @brief Allocates raw memory
+     * @param bytes Size of the allocation
+     * @param alignment Power-of-two alignment
+     */
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Constructs an object in the arena; it is destroyed on reset
+     */
+    template <class T, class... Args>
+    T *create(Args &&...args)
+    {
+        void *memory = allocate(sizeof(T), alignof(T));
+        T *object = new (memory) T(std::forward<Args>(args)...);
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            addFinalizer(&destroyObject<T>, object);
+        }
+        return object;
+    }
+
+    /**
+     * @brief Allocates a zeroed array of a trivially copyable type
+     */
+    template <class T>
+    T *createArray(int count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "createArray needs a trivially copyable type");
+        T *array = static_cast<T *>(allocate(sizeof(T) * (size_t)(count > 0 ? count : 1), alignof(T)));
+        for (int i = 0; i < count; i++)
+        {
+            array[i] = T();
+        }
+        return array;
+    }
+
+    /**
+     * @brief Destroys every object and makes all memory reusable
+     */
+    void reset();
+
+    /**
+     * @brief Gets the bytes handed out since the last reset
+     */
+    size_t getBytesUsed() const;
+
+    /**
+     * @brief Gets the bytes held in blocks
+     */
+    size_t getBytesReserved() const;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,74 @@
+#ifndef BENCHCITY_H
+#define BENCHCITY_H
+
+#include <iostream>
+#include "Citydj.h"
+#include "GraphPartitioner.h"
+
+// Shared setup for the bench_*.cpp programs: a seeded grid city, optional
+// zones and shortcut roads, and a switch for the library's console logging.
+
+/**
+ * @brief Builds a side x side grid with seeded random road lengths
+ * @param maxWeight Roads are 1 .. maxWeight long
+ * @param seed Generator seed; the same seed gives the same city
+ */
+inline void buildGridCity(City &city, int side, int maxWeight = 9, unsigned int seed = 7)
+{
+    for (int i = 0; i < side * side; i++)
+        city.addLocation(i);
+
+    for (int y = 0; y < side; y++)
+    {
+        for (int x = 0; x < side; x++)
+        {
+            int v = y * side + x;
+            seed = seed * 1103515245u + 12345u;
+            if (x + 1 < side)
+                city.addRoad(v, v + 1, 1 + (seed >> 16) % maxWeight);
+            seed = seed * 1103515245u + 12345u;
+            if (y + 1 < side)
+                city.addRoad(v, v + side, 1 + (seed >> 16) % maxWeight);
+        }
+    }
+}
+
+/**
+ * @brief Adds random long roads between arbitrary locations to raise the density
+ * @param perNode Roads attempted per location (duplicates are rejected by addRoad)
+ */
+inline void addShortcutRoads(City &city, int perNode, unsigned int seed = 11)
+{
+    int nodes = city.getNodeCount();
+    for (int i = 0; i < nodes * perNode; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int a = (seed >> 8) % nodes;
+        seed = seed * 1103515245u + 12345u;
+        int b = (seed >> 8) % nodes;
+        if (a != b)
+            city.addRoad(a, b, 50 + (seed >> 20) % 400);
+    }
+}
+
+/**
+ * @brief Splits the city into balanced zones with GraphPartitioner
+ */
+inline void assignGridZones(City &city, int zoneCount)
+{
+    GraphPartitioner partitioner(city);
+    partitioner.partition(zoneCount);
+    partitioner.applyToCity(city);
+}
+
+/**
+ * @brief Silences cout, which the city and engine log every road and event to
+ *
+ * Results go to cerr, so the numbers measure the work rather than the logging.
+ */
+inline void silenceLibraryLogging()
+{
+    std::cout.setstate(std::ios::failbit);
+}
+
+#endif // BENCHCITY_H
@@ -1,12 +1,23 @@
 #ifndef CITY_H
 #define CITY_H
 
+class ZoneDistanceMatrix;
+class DistanceTreeCache;
+class DistanceMatrix;
+class TravelTimeProfiles;
+
 /**
  * @class City
  * @brief Represents a city as a weighted graph where nodes are locations and edges are roads with distances.
  *
  * This class provides graph operations with weighted edges, zone support, and shortest path finding.
  * It uses dynamic arrays instead of STL containers.
+ *
+ * Location IDs are expected to be dense: 0 .. getNodeCount()-1, each equal
+ * to its index. dijkstra and the structures built from a City (zone bounds,
+ * distance caches, CompactGraph, ...) index per-location arrays by ID.
+ * findNode still accepts sparse IDs, so adding and looking up locations and
+ * roads works with them, but searches do not.
  */
 class City
 {
@@ -17,8 +28,9 @@ private:
      */
     struct Road
     {
-        int toNodeId; ///< Destination node ID
-        int distance; ///< Distance/weight of the road
+        int toNodeId;  ///< Destination node ID
+        int distance;  ///< Distance/weight of the road (free-flow travel time)
+        int profileId; ///< Shared travel-time profile, -1 for a static road
 
         Road();                 ///< Default constructor
         Road(int to, int dist); ///< Parameterized constructor
@@ -42,17 +54,56 @@ private:
         void addRoad(int to, int distance); ///< Add a road with distance
         bool hasRoadTo(int nodeId) const;   ///< Check if road exists to a node
         int getRoadIndex(int nodeId) const; ///< Get index of road to a node
+        bool removeRoad(int to);            ///< Remove the road to a node (order not kept)
     };
 
     Node **nodes;  ///< Array of pointers to nodes
     int nodeCount; ///< Current number of nodes
     int capacity;  ///< Current capacity of nodes array
 
+    // ===== Connected Components (indexed like nodes) =====
+    int *componentLabel; ///< Component of each node (index of its representative)
+    int *componentNext;  ///< Next node in the same component, -1 at the end
+    int *componentTail;  ///< Last node of each component (valid for representatives)
+    int *componentSize;  ///< Node count of each component (valid for representatives)
+    int componentCount;  ///< Number of connected components
+
+    ZoneDistanceMatrix *zoneBounds; ///< Zone x zone lower bounds (nullptr until enabled)
+    DistanceTreeCache *distanceCache; ///< Cached shortest-path trees (nullptr until enabled)
+    DistanceMatrix *distanceMatrix;   ///< All-pairs distances (nullptr until enabled)
+    TravelTimeProfiles *profiles;     ///< Shared travel-time profiles (nullptr until the first is added)
+
     /**
      * @brief Resizes the nodes array when more capacity is needed
      */
     void resizeNodes();
 
+    /**
+     * @brief Merges the components of two nodes (union by size)
+     *
+     * Members of the smaller component are relabeled, so each node is
+     * relabeled O(log n) times overall and lookups stay O(1).
+     * @param indexA Index of the first node
+     * @param indexB Index of the second node
+     */
+    void mergeComponents(int indexA, int indexB);
+
+    /**
+     * @brief Rebuilds all component labels from scratch
+     *
+     * Needed after a road is removed, since union-find cannot split.
+     */
+    void recomputeComponents();
+
+    /**
+     * @brief Time-dependent Dijkstra shared by the public queries
+     * @param target Stops once this node is settled (-1 to settle all)
+     * @param distances Travel time per node, initialized to INT_MAX by the caller
+     * @param predecessors Predecessor per node, initialized to -1 by the caller
+     */
+    void runTimeDependentSearch(int sourceIndex, int departureTime, int target,
+                                int *distances, int *predecessors) const;
+
     /**
      * @brief Finds a node by ID
      * @param id The node ID to find
@@ -68,6 +119,22 @@ private:
     Node *getNode(int id) const;
 
 public:
+    static const int ROAD_CLOSED; ///< RoadUpdate distance that removes the road
+
+    /**
+     * @struct RoadUpdate
+     * @brief One traffic update: a new distance for a road, or a closure
+     */
+    struct RoadUpdate
+    {
+        int from;     ///< First location of the road
+        int to;       ///< Second location of the road
+        int distance; ///< New distance (adds the road if missing), or ROAD_CLOSED
+
+        RoadUpdate();                           ///< Default constructor
+        RoadUpdate(int a, int b, int distance); ///< Parameterized constructor
+    };
+
     /**
      * @struct ShortestPathResult
      * @brief Stores the result of Dijkstra's algorithm
@@ -78,9 +145,12 @@ public:
         int *predecessors; ///< Predecessor nodes for path reconstruction
         int nodeCount;     ///< Number of nodes in the result
 
-        ShortestPathResult();          ///< Default constructor
-        ShortestPathResult(int count); ///< Parameterized constructor
-        ~ShortestPathResult();         ///< Destructor
+        ShortestPathResult();                                ///< Default constructor
+        ShortestPathResult(int count);                       ///< Parameterized constructor
+        ShortestPathResult(ShortestPathResult &&other);      ///< Move constructor (takes ownership of arrays)
+        ~ShortestPathResult();                               ///< Destructor
+        ShortestPathResult(const ShortestPathResult &) = delete;
+        ShortestPathResult &operator=(const ShortestPathResult &) = delete;
 
         /**
          * @brief Gets the shortest distance to a specific node
@@ -129,6 +199,36 @@ public:
      */
     bool addRoad(int from, int to, int distance);
 
+    /**
+     * @brief Changes the distance of an existing road (both directions)
+     * @param from First location ID
+     * @param to Second location ID
+     * @param distance New positive distance
+     * @return true if updated, false if the road doesn't exist or the distance is invalid
+     */
+    bool setRoadWeight(int from, int to, int distance);
+
+    /**
+     * @brief Removes a road (both directions)
+     * @param from First location ID
+     * @param to Second location ID
+     * @return true if removed, false if the road doesn't exist
+     */
+    bool removeRoad(int from, int to);
+
+    /**
+     * @brief Applies a batch of traffic updates
+     *
+     * Each update sets a road's distance, adds the road if it is missing, or
+     * closes it with ROAD_CLOSED. Invalid updates are reported and skipped.
+     * Components, zone bounds and cached distance trees are repaired once
+     * for the whole batch.
+     * @param updates Array of updates
+     * @param count Number of updates
+     * @return Number of updates applied
+     */
+    int applyRoadUpdates(const RoadUpdate *updates, int count);
+
     /**
      * @brief Sets the zone for a location
      * @param nodeId The location ID
@@ -137,6 +237,19 @@ public:
      */
     bool setZone(int nodeId, int zoneId);
 
+    /**
+     * @brief Sets the zones of many locations at once
+     *
+     * Unlike calling setZone per location, zone bounds are marked stale once
+     * and rebuilt on the next query instead of being repaired per change.
+     * Invalid entries are reported and skipped.
+     * @param nodeIds Array of location IDs
+     * @param zoneIds Zone for each location in nodeIds
+     * @param count Number of entries
+     * @return Number of locations whose zone changed
+     */
+    int setZones(const int *nodeIds, const int *zoneIds, int count);
+
     /**
      * @brief Gets the zone ID for a location
      * @param nodeId The location ID
@@ -165,6 +278,91 @@ public:
      */
     bool locationExists(int id) const;
 
+    /**
+     * @brief Checks in O(1) whether two locations are connected by roads
+     * @param a First location ID
+     * @param b Second location ID
+     * @return true if a path exists, false if not or if either location doesn't exist
+     */
+    bool areConnected(int a, int b) const;
+
+    /**
+     * @brief Gets the connected component label of a location
+     * @param nodeId The location ID
+     * @return Component label, or -1 if location doesn't exist
+     */
+    int getComponentId(int nodeId) const;
+
+    /**
+     * @brief Gets the number of connected components
+     */
+    int getComponentCount() const;
+
+    /**
+     * @brief Enables the zone x zone lower-bound distance matrix
+     *
+     * Once enabled, the matrix is kept up to date incrementally by addRoad
+     * and setZone. It is built lazily on the first query and keeps one
+     * distance per location for every zone, so enable it only when
+     * dispatch needs the pruning.
+     */
+    void enableZoneBounds();
+
+    /**
+     * @brief Gets a lower bound on the distance between any locations of two zones
+     * @param zoneA First zone ID
+     * @param zoneB Second zone ID
+     * @return Lower bound (0 if bounds are disabled, zones match or are unassigned),
+     *         INT_MAX if no location of zoneB is reachable from zoneA
+     */
+    int getZoneLowerBound(int zoneA, int zoneB) const;
+
+    /**
+     * @brief Builds every lazily computed structure (zone bounds, distance matrix) now
+     *
+     * Call before sharing the city read-only between threads, so that no
+     * query triggers a rebuild concurrently.
+     */
+    void prepareForConcurrentReads();
+
+    /**
+     * @brief Enables caching of shortest-path trees for getShortestDistance
+     *
+     * Trees for the most recently used sources are kept and repaired
+     * incrementally on road changes instead of being recomputed. The cache
+     * is not safe for concurrent queries from several threads.
+     * @param maxTrees Number of source trees kept
+     */
+    void enableDistanceCache(int maxTrees = 8);
+
+    /**
+     * @brief Checks if the distance cache is enabled
+     */
+    bool hasDistanceCache() const;
+
+    /**
+     * @brief Prints distance cache statistics (if enabled)
+     */
+    void printDistanceCacheStats() const;
+
+    /**
+     * @brief Enables the all-pairs distance matrix for getShortestDistance
+     *
+     * Every shortest-distance query becomes one lookup. The matrix takes
+     * 2 bytes per pair of locations (4 if some distance needs more than 16
+     * bits), so it suits cities of up to a few thousand locations. It is
+     * built lazily on the first query, kept up to date on new or shorter
+     * roads and rebuilt after anything else changes the graph. Takes
+     * precedence over the distance cache.
+     * @param threadCount Threads to build with (0 = one per hardware thread)
+     */
+    void enableDistanceMatrix(int threadCount = 1);
+
+    /**
+     * @brief Prints distance matrix statistics (if enabled)
+     */
+    void printDistanceMatrixStats() const;
+
     /**
      * @brief Gets the distance between two locations
      * @param from Source location ID
@@ -173,6 +371,37 @@ public:
      */
     int getDistance(int from, int to) const;
 
+    /**
+     * @brief Gets the number of roads leaving a location
+     * @param nodeId The location ID
+     * @return Number of roads, or -1 if location doesn't exist
+     */
+    int getRoadCount(int nodeId) const;
+
+    /**
+     * @brief Gets all roads leaving a location
+     * @param nodeId The location ID
+     * @param neighborArray Array to store neighbor IDs (must hold getRoadCount(nodeId) entries)
+     * @param distanceArray Array to store road distances (must hold getRoadCount(nodeId) entries)
+     * @return Number of roads written, or -1 if location doesn't exist
+     */
+    int getRoads(int nodeId, int *neighborArray, int *distanceArray) const;
+
+    /**
+     * @brief Gets the number of bytes used by the adjacency structure
+     *
+     * Counts the node pointer array, the Node objects and the allocated
+     * Road arrays (including unused capacity), i.e. the current in-memory layout.
+     * @return Adjacency memory footprint in bytes
+     */
+    long long getAdjacencyBytes() const;
+
+    /**
+     * @brief Gets the number of undirected roads in the city
+     * @return Road count (each road is stored once per direction internally)
+     */
+    int getTotalRoadCount() const;
+
     /**
      * @brief Dijkstra's shortest path algorithm
      * @param source Source node ID
@@ -197,6 +426,90 @@ public:
      */
     int getShortestPath(int source, int destination, int *pathArray) const;
 
+    /**
+     * @brief Gets the shortest distance from every source to every target
+     *
+     * With the distance matrix enabled every entry is a lookup. Otherwise
+     * one search runs per location on the shorter side (roads are two-way,
+     * so the table is filled transposed when targets are fewer). Each
+     * search reaches all its goals at once and stops as soon as the last
+     * one in its connected component is settled, instead of one full
+     * search per pair.
+     * @param sources Source location IDs
+     * @param sourceCount Number of sources
+     * @param targets Target location IDs
+     * @param targetCount Number of targets
+     * @param table Receives sourceCount x targetCount distances, row by source
+     *              (-1 if unreachable or either location doesn't exist)
+     * @return true if filled, false if the arguments are invalid
+     */
+    bool distanceTable(const int *sources, int sourceCount,
+                       const int *targets, int targetCount, int *table) const;
+
+    // ===== Time-Dependent Travel Times =====
+
+    /**
+     * @brief Adds a travel-time profile, sharing an identical existing one
+     * @param times Breakpoint minutes of day, strictly increasing
+     * @param factors Per-mille factor of the free-flow time at each breakpoint
+     * @param count Number of breakpoints
+     * @return Profile ID, or -1 if invalid
+     * @see TravelTimeProfiles
+     */
+    int addTravelTimeProfile(const int *times, const int *factors, int count);
+
+    /**
+     * @brief Attaches a travel-time profile to a road (both directions)
+     * @param from First location ID
+     * @param to Second location ID
+     * @param profileId Profile from addTravelTimeProfile, or -1 to make the road static
+     * @return true if set, false if the road or profile doesn't exist
+     */
+    bool setRoadProfile(int from, int to, int profileId);
+
+    /**
+     * @brief Gets the travel-time profile of a road
+     * @return Profile ID, or -1 if the road is static or doesn't exist
+     */
+    int getRoadProfile(int from, int to) const;
+
+    /**
+     * @brief Gets the travel time of one road when entered at a given time
+     * @param departureTime Minutes since midnight (any day)
+     * @return Travel time, or -1 if no road
+     */
+    int getTravelTime(int from, int to, int departureTime) const;
+
+    /**
+     * @brief Time-dependent Dijkstra: earliest arrival from a source
+     *
+     * Road costs are evaluated at the time each road is entered. Distances
+     * in the result are travel times relative to the departure time. Roads
+     * without a profile use their static distance, so the result equals
+     * dijkstra() when no profile is set.
+     * @param source Source node ID
+     * @param departureTime Minutes since midnight
+     */
+    ShortestPathResult timeDependentDijkstra(int source, int departureTime) const;
+
+    /**
+     * @brief Gets the earliest-arrival travel time between two locations
+     *
+     * Stops the search as soon as the destination is settled.
+     * @return Travel time, or -1 if no path exists
+     */
+    int getTravelTimeAt(int source, int destination, int departureTime) const;
+
+    /**
+     * @brief Checks if any travel-time profile has been defined
+     */
+    bool hasTravelTimeProfiles() const;
+
+    /**
+     * @brief Prints all travel-time profiles
+     */
+    void printTravelTimeProfiles() const;
+
     /**
      * @brief Prints all locations and their connections with distances and zones
      *
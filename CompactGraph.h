@@ -0,0 +1,116 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include "Citydj.h"
+
+/**
+ * @class CompactGraph
+ * @brief Read-only, compressed adjacency encoding of a City for large graphs
+ *
+ * Each location's roads are sorted by neighbor ID and stored in one byte
+ * stream: the first neighbor as a zig-zag varint delta from the location's
+ * own ID, every following neighbor as a varint delta from the previous one,
+ * each followed by its distance. Distances take 2 bytes when every road in
+ * the city fits in 16 bits and 4 bytes otherwise. A per-location offset table
+ * gives O(1) access to the start of its roads.
+ *
+ * Only IDs 0 .. getNodeCount()-1 are encoded. In a City with sparse IDs
+ * (see City), a road into a larger ID is still stored, and a search that
+ * follows it reads past the tables.
+ */
+class CompactGraph
+{
+private:
+    int nodeCount;              ///< Number of locations
+    int arcCount;               ///< Number of stored (directed) roads
+    int *zones;                 ///< Zone ID per location
+    unsigned int *offsets;      ///< Byte offset of each location's roads (nodeCount + 1 entries)
+    unsigned char *adjacency;   ///< Encoded neighbor deltas and distances
+    unsigned int adjacencySize; ///< Number of bytes used in adjacency
+    int weightBytes;            ///< Bytes per distance: 2 (16-bit) or 4 (32-bit)
+
+    CompactGraph(const CompactGraph &) = delete;
+    CompactGraph &operator=(const CompactGraph &) = delete;
+
+    /**
+     * @brief Appends a varint to the byte stream
+     * @return Position after the written bytes
+     */
+    static unsigned int writeVarint(unsigned char *buffer, unsigned int pos, unsigned int value);
+
+    /**
+     * @brief Reads a varint from the byte stream
+     * @return Position after the read bytes
+     */
+    static unsigned int readVarint(const unsigned char *buffer, unsigned int pos, unsigned int &value);
+
+public:
+    /**
+     * @brief Encodes the current roads of a city
+     * @param city Source city (not modified; later changes are not reflected)
+     */
+    CompactGraph(const City &city);
+
+    /**
+     * @brief Destructor
+     */
+    ~CompactGraph();
+
+    /**
+     * @brief Gets the number of locations
+     */
+    int getNodeCount() const;
+
+    /**
+     * @brief Gets the number of undirected roads
+     */
+    int getRoadCount() const;
+
+    /**
+     * @brief Gets the zone of a location
+     * @return Zone ID, or -1 if the location doesn't exist or is unassigned
+     */
+    int getZone(int nodeId) const;
+
+    /**
+     * @brief Decodes all roads leaving a location
+     * @param nodeId The location ID
+     * @param neighborArray Array to store neighbor IDs
+     * @param distanceArray Array to store road distances
+     * @return Number of roads written, or -1 if location doesn't exist
+     */
+    int getRoads(int nodeId, int *neighborArray, int *distanceArray) const;
+
+    /**
+     * @brief Dijkstra's shortest path algorithm decoding roads on the fly
+     * @param source Source node ID
+     * @return ShortestPathResult with distances and predecessors from source
+     */
+    City::ShortestPathResult dijkstra(int source) const;
+
+    /**
+     * @brief Gets the shortest distance between two nodes
+     *
+     * Stops the search as soon as the destination is settled.
+     * @return Shortest distance, or -1 if no path exists
+     */
+    int getShortestDistance(int source, int destination) const;
+
+    /**
+     * @brief Gets the number of bytes used by the encoding
+     */
+    long long getMemoryBytes() const;
+
+    /**
+     * @brief Gets the average number of bytes per undirected road
+     */
+    double getBytesPerRoad() const;
+
+    /**
+     * @brief Prints bytes per road of this encoding against the City layout
+     * @param city The city this graph was built from
+     */
+    void printMemoryReport(const City &city) const;
+};
+
+#endif // COMPACTGRAPH_H
@@ -0,0 +1,37 @@
+#ifndef DEMOCITY_H
+#define DEMOCITY_H
+
+#include "StaticCity.h"
+
+/*
+ * The six-location city the console demo and the Qt dashboard dispatch on:
+ *
+ *        5        3        4        6
+ *   (0) ---- (1) ---- (3) ---- (4) ---- (5)
+ *    |                 |
+ *    +--- 10 --- (2) --+ 7
+ *
+ * Zone 1 = {0, 1}, zone 2 = {2, 3}, zone 3 = {4, 5}.
+ */
+
+constexpr StaticRoad DEMO_ROADS[] = {
+    {0, 1, 5},
+    {0, 2, 10},
+    {1, 3, 3},
+    {2, 3, 7},
+    {3, 4, 4},
+    {4, 5, 6},
+};
+
+constexpr int DEMO_ZONES[] = {1, 1, 2, 2, 3, 3};
+
+typedef StaticCity<6, 6> DemoCity;
+
+constexpr DemoCity DEMO_CITY(DEMO_ROADS, DEMO_ZONES);
+
+// Checked by the compiler, so an edit to the edge list cannot silently break the table
+static_assert(DEMO_CITY.distanceAt(0, 5) == 18, "0-1-3-4-5");
+static_assert(DEMO_CITY.distanceAt(2, 1) == 10, "2-3-1");
+static_assert(DEMO_CITY.zoneLowerBoundAt(1, 3) == 7, "1-3-4");
+
+#endif // DEMOCITY_H
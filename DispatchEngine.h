@@ -5,26 +5,67 @@
 #include "Driver.h"
 #include "Rider.h"
 #include "Trip.h"
+#include "WriteAheadLog.h"
+#include "ObjectPool.h"
+#include "TripHistory.h"
+#include "FleetStore.h"
+#include "ScoringPolicy.h"
+#include "DistanceOracle.h"
+#include "PendingTripQueue.h"
+#include "MultiMetricGraph.h"
+#include <future>
+
+class VersionedCity;
+class CitySnapshot;
+class EngineImage;
 
 /**
  * @class DispatchEngine
  * @brief Handles driver dispatch logic for ride-sharing system
+ *
+ * Drivers made with createDriver, riders made with createRider and every
+ * trip the engine creates live in engine-owned slab pools and are destroyed
+ * with the engine. Objects passed to registerDriver or createTrip stay owned
+ * by the caller.
+ *
+ * Only active trips are kept as Trip objects. A completed or cancelled trip
+ * is appended to the columnar TripHistory and dropped from the active set
+ * (and freed if the engine owns it), so pointers to it become invalid.
+ *
+ * The status, zone and location of every registered driver are mirrored in
+ * a FleetStore that the dispatch scans read, so change them through the
+ * engine (updateDriverLocation, setDriverStatus) rather than on the Driver.
+ *
+ * A requested trip that finds no driver waits in a pending queue, most
+ * urgent first. Whenever a driver becomes available (a trip completes or is
+ * cancelled, a driver registers or comes back online) the queue is offered
+ * to that driver before anything else happens.
  */
 class DispatchEngine
 {
 private:
     // ===== Core Data =====
     City *city;
+    VersionedCity *versionedCity; ///< Snapshot source used instead of city when set
+    const DistanceOracle *oracle; ///< Precomputed graph used instead of city when set
 
     // ===== Drivers =====
     Driver **drivers;
     int driverCount;
     int driverCapacity;
+    FleetStore fleet; ///< Packed status, zone and location of drivers[i] in slot i
+
+    // ===== Owned Objects =====
+    ObjectPool<Driver> driverPool; ///< Drivers created by the engine
+    ObjectPool<Rider> riderPool;   ///< Riders created by the engine
+    ObjectPool<Trip> tripPool;     ///< Trips created by the engine
 
     // ===== Trips =====
-    Trip **trips;
+    Trip **trips;     ///< Active trips only
     int tripCount;
     int tripCapacity;
+    TripHistory history; ///< Completed and cancelled trips
+    PendingTripQueue pendingTrips; ///< Requested trips still waiting for a driver
 
     // ===== Riders =====
     Rider **riders;    // 🔧 ADDED
@@ -33,24 +74,186 @@ private:
 
     // ===== Trip ID Generator =====
     int nextTripId; // 🔧 ADDED
+    int tripIdStep; ///< Increment between trip IDs (lets shards use disjoint ID sets)
+
+    // ===== Write-Ahead Log =====
+    WriteAheadLog *wal; ///< Log of lifecycle events (nullptr = not logged)
+    bool replaying;     ///< Applying log records; suppresses logging
+    long long restoredLsn;      ///< Last log record reflected by the loaded snapshot
+
+    // ===== Time-Dependent Scoring =====
+    bool timeDependentScoring; ///< Score and estimate with travel-time profiles
+    int currentTime;           ///< Dispatch clock in minutes since midnight
+
+    // ===== Scoring =====
+    ScoringPolicyKind scoringPolicy; ///< Policy findBestDriver dispatches to
+
+    // ===== Route Pricing =====
+    MultiMetricGraph *routeMetrics; ///< Graph trips are priced on (nullptr = shortest distance, no tolls)
+    MetricWeights routeWeights;     ///< Blend that picks the charged route
 
     // ===== Internal Helpers =====
     void resizeDrivers();
     void resizeTrips();
     void resizeRiders(); // 🔧 ADDED
 
+    /**
+     * @brief Allocates the driver, trip and rider arrays
+     */
+    void initializeStorage();
+
+    /**
+     * @brief Appends a lifecycle event to the log, if one is attached and not replaying
+     */
+    void logEvent(WalRecordType type, int f0 = 0, int f1 = 0, int f2 = 0, int f3 = 0, int f4 = 0);
+
+    /**
+     * @brief Applies one log record during recovery
+     * @return true if the event could be reapplied
+     */
+    bool applyLogRecord(const WalRecord &record);
+
+    /**
+     * @brief Copies every live driver, rider and trip into a columnar image
+     *
+     * Commits the attached log first, so the image's LSN is durable.
+     * @return The image, or nullptr if the log could not be committed
+     */
+    EngineImage *captureImage() const;
+
+    /**
+     * @brief Moves a finished trip from the active set into the history
+     * @param priorState State the trip left for its final state
+     */
+    void archiveTrip(Trip *trip, TripState priorState);
+
+    /**
+     * @brief Gets the zone of a location from the city, current snapshot or oracle
+     * @return Zone ID, or -1 if unknown
+     */
+    int zoneOf(int locationId);
+
     /**
      * @brief Validates whether a driver can be assigned to a trip
      */
     bool validateAssignment(Trip *trip, Driver *driver) const; // 🔧 ADDED
 
     /**
-     * @brief Calculates dispatch score
+     * @brief Finds a driver's index in drivers (and slot in fleet)
+     * @return Index, or -1 if not registered
      */
-    int calculateDispatchScore(Driver *driver,
+    int findDriverSlot(int driverId) const;
+
+    /**
+     * @brief Sets a driver's status on both the Driver and the fleet store
+     */
+    void setStatusAt(int slot, DriverStatus status);
+
+    /**
+     * @brief Moves a driver on both the Driver and the fleet store
+     */
+    void moveDriverAt(int slot, int location, int zone);
+
+    /**
+     * @brief Travel cost between two locations on a City
+     *
+     * Time-dependent travel time at currentTime when enabled, static
+     * shortest distance otherwise.
+     * @return Cost, or -1 if no path exists
+     */
+    int travelCost(const City &graph, int from, int to) const;
+
+    /**
+     * @brief Travel cost on a snapshot (static; snapshots carry no profiles)
+     */
+    int travelCost(const CitySnapshot &graph, int from, int to) const;
+
+    /**
+     * @brief Travel time at the dispatch clock, whether or not time-dependent scoring is on
+     */
+    int travelTime(const City &graph, int from, int to) const;
+
+    /**
+     * @brief Travel time on a snapshot (the static distance; snapshots carry no profiles)
+     */
+    int travelTime(const CitySnapshot &graph, int from, int to) const;
+
+    /**
+     * @brief Travel cost on an oracle (static; oracles carry no profiles)
+     */
+    int travelCost(const DistanceOracle &graph, int from, int to) const;
+
+    /**
+     * @brief Travel time on an oracle (the static distance; oracles carry no profiles)
+     */
+    int travelTime(const DistanceOracle &graph, int from, int to) const;
+
+    /**
+     * @brief Calculates dispatch score under a scoring policy
+     *
+     * Static costs go through getShortestDistance, so they are a single
+     * lookup when the City has a distance matrix enabled.
+     * @param graph City, CitySnapshot or DistanceOracle to measure distances on
+     * @param cost Receives the travel cost the score was based on
+     * @return Score, or INT_MAX if the driver cannot reach the location
+     */
+    template <class Policy, class Graph>
+    int calculateDispatchScore(const Graph &graph,
+                               int slot,
                                int riderLocation,
-                               int sameZoneBonus,
-                               int crossZonePenalty) const;
+                               int &cost) const;
+
+    /**
+     * @brief Scans available drivers under a compile-time scoring policy
+     * @param pickupCost If not null, receives the chosen driver's travel cost to the pickup
+     */
+    template <class Policy, class Graph>
+    Driver *scanDrivers(const Graph &graph, int riderPickupLocation, int *pickupCost);
+
+    /**
+     * @brief findBestDriver against a City, CitySnapshot or DistanceOracle, under the configured policy
+     * @param pickupCost If not null, receives the chosen driver's travel cost to the pickup
+     */
+    template <class Graph>
+    Driver *findBestDriverOn(const Graph &graph, int riderPickupLocation, int *pickupCost = nullptr);
+
+    /**
+     * @brief requestTrip against a City, CitySnapshot or DistanceOracle
+     */
+    template <class Graph>
+    Trip *requestTripOn(const Graph &graph, const Rider &rider, int priority);
+
+    /**
+     * @brief Offers the pending queue to a driver that just became available
+     *
+     * Does nothing while replaying: the log already holds the assignments
+     * the live engine made.
+     * @return true if the driver took a pending trip
+     */
+    bool matchPending(int slot);
+
+    /**
+     * @brief matchPending against a City, CitySnapshot or DistanceOracle
+     *
+     * Takes the most urgent pending trip whose pickup the driver can reach.
+     * Only the driver's own location is searched from, instead of scoring
+     * the fleet once per waiting trip.
+     */
+    template <class Graph>
+    bool matchPendingOn(const Graph &graph, int slot);
+
+    /**
+     * @brief Adds a REQUESTED trip to the pending queue
+     */
+    void queuePending(const Trip *trip);
+
+    /**
+     * @brief Refills the pending queue from the active REQUESTED trips
+     *
+     * Used after a snapshot load or log replay, which restore trips without
+     * going through requestTrip.
+     */
+    void rebuildPendingQueue();
 
 public:
     // ===== Constants =====
@@ -58,17 +261,215 @@ public:
     static const int DEFAULT_CROSS_ZONE_PENALTY;
 
     // ===== Constructor / Destructor =====
-    DispatchEngine(City *cityPtr);
+    /**
+     * @brief Constructor
+     *
+     * findBestDriver skips drivers whose zone cannot beat the best candidate
+     * only if the city has zone bounds (City::enableZoneBounds).
+     * @param cityPtr City to dispatch on
+     * @param firstTripId ID given to the first trip
+     * @param tripIdStep Increment between consecutive trip IDs
+     */
+    DispatchEngine(City *cityPtr, int firstTripId = 1000, int tripIdStep = 1);
+
+    /**
+     * @brief Constructor for dispatch on published snapshots
+     *
+     * Every request pins the current snapshot for its whole duration, so
+     * updater threads can edit and publish the city without blocking dispatch.
+     * @param source Versioned city to read snapshots from
+     * @param firstTripId ID given to the first trip
+     * @param tripIdStep Increment between consecutive trip IDs
+     */
+    DispatchEngine(VersionedCity *source, int firstTripId = 1000, int tripIdStep = 1);
+
+    /**
+     * @brief Constructor for dispatch on a precomputed graph (such as a StaticCity)
+     *
+     * Every distance comes from the oracle; time-dependent scoring is not
+     * available.
+     * @param source Oracle to query; must outlive the engine
+     * @param firstTripId ID given to the first trip
+     * @param tripIdStep Increment between consecutive trip IDs
+     */
+    DispatchEngine(const DistanceOracle *source, int firstTripId = 1000, int tripIdStep = 1);
     ~DispatchEngine();
 
+    // ===== Time-Dependent Scoring =====
+    /**
+     * @brief Scores drivers and estimates trips with time-dependent travel times
+     *
+     * Uses City::getTravelTimeAt at the dispatch clock instead of static
+     * distances. Static-weight dispatch is unaffected while disabled.
+     */
+    void setTimeDependentScoring(bool enabled);
+    bool isTimeDependentScoring() const;
+
+    /**
+     * @brief Sets the dispatch clock
+     *
+     * Changes are logged, so a recovered engine stamps finished trips with
+     * the same times.
+     * @param minuteOfDay Minutes since midnight
+     */
+    void setCurrentTime(int minuteOfDay);
+    int getCurrentTime() const;
+
+    // ===== Scoring Policy =====
+    /**
+     * @brief Chooses the policy findBestDriver and requestTrip score drivers with
+     *
+     * The choice is read once per request; each policy has its own compiled
+     * scan with the score inlined (see ScoringPolicy.h).
+     */
+    void setScoringPolicy(ScoringPolicyKind kind);
+    ScoringPolicyKind getScoringPolicy() const;
+
+    /**
+     * @brief Prices requested trips on the route a metric blend picks
+     *
+     * requestTrip then takes the trip distance and tolls from
+     * MultiMetricGraph::getRouteMetrics, so the fare includes the tolls along
+     * that route. The graph customizes itself on queries, so each engine
+     * needs its own.
+     * @param graph Graph over the same locations (nullptr prices by shortest distance without tolls; not owned)
+     * @param weights Blend that selects the route
+     */
+    void setRoutePricing(MultiMetricGraph *graph, const MetricWeights &weights = MetricWeights());
+
+    // ===== Write-Ahead Log =====
+    /**
+     * @brief Logs every later lifecycle event to a write-ahead log
+     *
+     * Events are appended once the in-memory change has succeeded; they are
+     * durable once the log's durable LSN reaches them (see WalSyncPolicy).
+     * After loadSnapshot the log numbers its records past the snapshot's LSN.
+     * @param log Log to append to (nullptr stops logging; not owned)
+     */
+    void setWriteAheadLog(WriteAheadLog *log);
+    WriteAheadLog *getWriteAheadLog() const;
+
+    /**
+     * @brief Rebuilds drivers and trips by replaying a log
+     *
+     * Call on a freshly constructed engine before attaching a log. Drivers
+     * already registered keep their objects; drivers missing from the engine
+     * are recreated and owned by it. Replay stops at a torn tail.
+     * @param path Log file to replay
+     * @return Number of records applied, or -1 if the log cannot be opened
+     */
+    long long recoverFromLog(const char *path);
+
+    // ===== Snapshots =====
+    /**
+     * @brief Writes drivers, riders, trips and the trip ID generator to a binary image
+     *
+     * Records the log LSN the image reflects, so recoverFromLog after
+     * loadSnapshot replays only newer records.
+     * @return true on success
+     */
+    bool saveSnapshot(const char *path) const;
+
+    /**
+     * @brief Copies the engine state now and writes it on a background thread
+     *
+     * Only the copy runs on the calling thread; dispatch can continue while
+     * the image is written and synced.
+     * @return Future set to true once the image is safely on disk
+     */
+    std::future<bool> saveSnapshotAsync(const char *path) const;
+
+    /**
+     * @brief Restores state saved by saveSnapshot into a freshly constructed engine
+     *
+     * Drivers already registered are updated in place; missing drivers and
+     * riders are recreated and owned by the engine. Cost is proportional to
+     * the live objects in the image. Refused once the engine has archived
+     * any trips, since the image's history would be appended a second time.
+     * @return true on success
+     */
+    bool loadSnapshot(const char *path);
+
+    /**
+     * @brief Gets the log LSN reflected by the last loaded snapshot (0 if none)
+     */
+    long long getRestoredLsn() const;
+
     // ===== Driver Management =====
+    /**
+     * @brief Creates an engine-owned driver and registers it
+     * @return The driver, or nullptr if the ID is already registered
+     */
+    Driver *createDriver(int driverId, int locationId, int zone);
+
+    /**
+     * @brief Registers a caller-owned driver (must outlive the engine or be removed first)
+     *
+     * From then on the driver's location, zone and status change only
+     * through the engine, which keeps its FleetStore in step.
+     */
     bool registerDriver(Driver *driver);
+
+    /**
+     * @brief Unregisters a driver, destroying it if the engine created it
+     * @return true if the driver was registered
+     */
     bool removeDriver(int driverId);
+
+    /**
+     * @brief Unregisters a driver without destroying it, to register it with another engine
+     *
+     * An engine-created driver stays allocated in this engine's pool, so
+     * this engine must outlive every later use of it.
+     * @return The driver, or nullptr if it was not registered
+     */
+    Driver *detachDriver(int driverId);
     Driver *findDriverById(int driverId) const;
 
-    Trip *requestTrip(const Rider &rider);
+    /**
+     * @brief Moves a driver and updates its zone from the city
+     * @return true if the driver exists
+     */
+    bool updateDriverLocation(int driverId, int locationId);
+
+    /**
+     * @brief Changes a driver's status outside the trip lifecycle (e.g. going offline)
+     * @return true if the driver exists
+     */
+    bool setDriverStatus(int driverId, DriverStatus status);
+
+    /**
+     * @brief Records a driver's rider rating (used by rating-weighted scoring)
+     * @param tenths Rating in tenths of a star
+     * @return true if the driver exists and the rating is in range
+     */
+    bool setDriverRating(int driverId, int tenths);
+
+    /**
+     * @brief Creates a trip for a rider and dispatches the best driver to it
+     *
+     * If no driver can take it, the trip stays REQUESTED in the pending
+     * queue and is matched as soon as a suitable driver becomes available.
+     * @param priority Pending-queue priority (0 to TripRecord::MAX_PRIORITY)
+     * @return The trip, or nullptr if the dropoff is unreachable
+     */
+    Trip *requestTrip(const Rider &rider, int priority = 0);
+
+    /**
+     * @brief Changes the priority of an active trip
+     *
+     * A pending trip moves in the queue accordingly; it keeps its place among
+     * trips of its new priority by how long it has waited.
+     * @return true if the trip is active and the priority is in range
+     */
+    bool setTripPriority(int tripId, int priority);
 
     // ===== Rider Management =====
+    /**
+     * @brief Creates an engine-owned rider
+     * @return The rider, or nullptr if the ID already exists
+     */
+    Rider *createRider(int riderId, int pickup, int dropoff);
     Rider *findRiderById(int riderId) const; // 🔧 ADDED
 
     // ===== Trip Management =====
@@ -78,17 +479,44 @@ public:
     bool assignDriverToTrip(int tripId, int driverId);
     Driver *findBestDriver(int riderPickupLocation);
 
+    /**
+     * @brief findBestDriver with the scoring policy fixed at compile time
+     *
+     * Instantiated for the policies declared in ScoringPolicy.h.
+     */
+    template <class Policy>
+    Driver *findBestDriverWith(int riderPickupLocation);
+
     bool startTrip(int tripId);    // 🔧 ADDED
     bool completeTrip(int tripId); // 🔧 ADDED
     bool cancelTrip(int tripId);   // 🔧 ADDED
 
     Trip *findTripById(int tripId) const;
 
+    /**
+     * @brief Gets a stable handle to an active engine-created trip
+     * @return Handle (resolves to nullptr once the trip is archived), or a
+     *         null handle if the trip is unknown or caller-owned
+     */
+    PoolHandle getTripHandle(int tripId) const;
+
+    /**
+     * @brief Resolves a trip handle
+     * @return The trip, or nullptr if it was released since
+     */
+    Trip *resolveTrip(PoolHandle handle) const;
+
+    /**
+     * @brief Gets the completed and cancelled trips
+     */
+    const TripHistory &getTripHistory() const;
+
     // ===== Queries =====
     int getAvailableDriverCount() const;
     int getTotalDriverCount() const;
     int getActiveTripCount() const;
-    int getTotalTripCount() const;
+    int getTotalTripCount() const; ///< Active plus archived trips
+    int getPendingTripCount() const; ///< Trips waiting for a driver
 
     // ===== Debug / Display =====
     void printStatus() const;
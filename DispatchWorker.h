@@ -0,0 +1,247 @@
+#ifndef DISPATCHWORKER_H
+#define DISPATCHWORKER_H
+
+#include "DispatchEngine.h"
+#include "RequestQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @struct TripRequestResult
+ * @brief Snapshot of a trip taken on the dispatcher thread right after a request
+ *
+ * Safe to read from any thread, unlike the Trip object itself.
+ */
+struct TripRequestResult
+{
+    int tripId;      ///< New trip ID, or -1 if the request was rejected
+    int driverId;    ///< Assigned driver, or -1 if none was available
+    TripState state; ///< Trip state after dispatch
+    float fare;      ///< Calculated fare
+
+    TripRequestResult() : tripId(-1), driverId(-1), state(CANCELLED), fare(0.0f) {}
+};
+
+/**
+ * @brief Callback invoked on the dispatcher thread when a trip request finishes
+ */
+typedef void (*TripRequestCallback)(const TripRequestResult &result, void *context);
+
+/**
+ * @brief Continuation run on the dispatcher thread when an async request finishes
+ */
+typedef std::function<void(const TripRequestResult &)> TripContinuation;
+
+class DispatchWorker;
+
+/**
+ * @class TripHandle
+ * @brief Awaitable handle to a trip request running on a DispatchWorker
+ *
+ * Returned immediately by DispatchWorker::requestTripAsync, so callers never
+ * block on dispatch unless they call get(). Any number of handles may be in
+ * flight. cancel() routes to DispatchEngine::cancelTrip on the dispatcher
+ * thread, or prevents dispatch entirely if the request has not run yet.
+ * Handles are cheap to copy; copies share the same request.
+ */
+class TripHandle
+{
+private:
+    friend class DispatchWorker;
+
+    /**
+     * @struct State
+     * @brief Request state shared between the handle copies and the dispatcher
+     */
+    struct State
+    {
+        std::atomic<bool> cancelRequested; ///< Set by cancel(); checked before dispatch
+        std::atomic<bool> dispatched;      ///< Set once the request ran on the engine
+        std::atomic<int> tripId;           ///< Trip ID once dispatched, -1 before or if rejected
+        std::promise<TripRequestResult> promise;     ///< Fulfilled by the dispatcher
+        std::shared_future<TripRequestResult> result; ///< Shared view of the promise
+
+        State() : cancelRequested(false), dispatched(false), tripId(-1),
+                  result(promise.get_future().share()) {}
+    };
+
+    std::shared_ptr<State> state; ///< Shared request state
+    DispatchWorker *worker;       ///< Worker executing the request
+
+    TripHandle(std::shared_ptr<State> sharedState, DispatchWorker *owner);
+
+public:
+    /**
+     * @brief Creates an empty handle (isValid() is false)
+     */
+    TripHandle();
+
+    /**
+     * @brief Checks if the handle refers to a request
+     */
+    bool isValid() const;
+
+    /**
+     * @brief Checks without blocking whether the request has finished
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Waits up to a timeout for the request to finish
+     * @param milliseconds Maximum time to wait
+     * @return true if the result is ready
+     */
+    bool waitFor(int milliseconds) const;
+
+    /**
+     * @brief Waits for and returns the dispatch result
+     */
+    TripRequestResult get() const;
+
+    /**
+     * @brief Gets the trip ID, or -1 if not dispatched yet or rejected
+     */
+    int getTripId() const;
+
+    /**
+     * @brief Requests cancellation
+     *
+     * If the request has not been dispatched yet it never will be; otherwise
+     * DispatchEngine::cancelTrip runs on the dispatcher thread.
+     * @return Future receiving true if the trip ended up cancelled
+     */
+    std::future<bool> cancel();
+};
+
+/**
+ * @class DispatchWorker
+ * @brief Dedicated dispatcher thread that owns a DispatchEngine
+ *
+ * Front-ends on any thread submit commands through a lock-free MPSC
+ * RequestQueue; the dispatcher thread executes them one at a time, so the
+ * engine and everything it owns is only ever touched by that thread and needs
+ * no locks. Results come back through a std::future or a callback.
+ *
+ * While the worker is running, the engine must not be used directly by other
+ * threads; use submitTask to run arbitrary code on the dispatcher thread.
+ */
+class DispatchWorker
+{
+private:
+    /**
+     * @struct Command
+     * @brief A queued unit of work
+     */
+    struct Command : public QueueNode
+    {
+        std::function<void(DispatchEngine &)> run; ///< Work executed on the dispatcher thread
+    };
+
+    DispatchEngine &engine;         ///< Engine owned by the dispatcher thread
+    RequestQueue queue;             ///< Pending commands
+    std::thread thread;             ///< Dispatcher thread
+    std::atomic<bool> running;      ///< Cleared to stop the dispatcher
+    std::atomic<int> pending;       ///< Commands pushed but not yet executed
+    std::atomic<bool> sleeping;     ///< Dispatcher is (about to be) blocked on wakeup
+    std::atomic<long long> processed; ///< Commands executed so far
+    std::mutex sleepMutex;          ///< Guards the wakeup condition only
+    std::condition_variable wakeup; ///< Signals new work to a sleeping dispatcher
+
+    DispatchWorker(const DispatchWorker &) = delete;
+    DispatchWorker &operator=(const DispatchWorker &) = delete;
+
+    /**
+     * @brief Dispatcher thread main loop
+     */
+    void run();
+
+    /**
+     * @brief Executes every command currently in the queue
+     * @return Number of commands executed
+     */
+    int drain();
+
+    /**
+     * @brief Pushes a command and wakes the dispatcher if needed
+     */
+    void enqueue(Command *command);
+
+    /**
+     * @brief Runs a trip request on the dispatcher thread and snapshots the result
+     */
+    static TripRequestResult executeRequest(DispatchEngine &engine, const Rider &rider);
+
+public:
+    /**
+     * @brief Constructor
+     * @param engineRef Engine to own; must outlive the worker
+     */
+    DispatchWorker(DispatchEngine &engineRef);
+
+    /**
+     * @brief Destructor (stops the thread after executing queued commands)
+     */
+    ~DispatchWorker();
+
+    /**
+     * @brief Starts the dispatcher thread
+     */
+    void start();
+
+    /**
+     * @brief Executes queued commands, then stops and joins the dispatcher thread
+     */
+    void stop();
+
+    /**
+     * @brief Checks if the dispatcher thread is running
+     */
+    bool isRunning() const;
+
+    // ===== Submission (safe from any thread) =====
+
+    /**
+     * @brief Submits a trip request
+     * @param rider Rider making the request (copied)
+     * @return Future that receives the dispatch result
+     */
+    std::future<TripRequestResult> submitTripRequest(const Rider &rider);
+
+    /**
+     * @brief Submits a trip request and reports the result through a callback
+     * @param rider Rider making the request (copied)
+     * @param callback Called on the dispatcher thread when done
+     * @param context Opaque pointer passed to the callback
+     */
+    void submitTripRequest(const Rider &rider, TripRequestCallback callback, void *context);
+
+    /**
+     * @brief Submits a trip request and returns an awaitable handle immediately
+     * @param rider Rider making the request (copied)
+     * @param onReady Optional continuation run on the dispatcher thread when done
+     * @return Handle for waiting on, polling or cancelling the request
+     */
+    TripHandle requestTripAsync(const Rider &rider, TripContinuation onReady = TripContinuation());
+
+    std::future<bool> submitStartTrip(int tripId);
+    std::future<bool> submitCompleteTrip(int tripId);
+    std::future<bool> submitCancelTrip(int tripId);
+
+    /**
+     * @brief Runs arbitrary code against the engine on the dispatcher thread
+     * @param task Work to execute
+     */
+    void submitTask(std::function<void(DispatchEngine &)> task);
+
+    /**
+     * @brief Gets the number of commands executed so far
+     */
+    long long getProcessedCount() const;
+};
+
+#endif // DISPATCHWORKER_H
@@ -1,12 +1,16 @@
 #include "DispatchEngine.h"
+#include "VersionedCity.h"
+#include "EngineSnapshot.h"
 #include <iostream>
 #include <climits>
+#include <cstring>
+#include <string>
 
 using namespace std;
 
 // Initialize static constants
-const int DispatchEngine::DEFAULT_SAME_ZONE_BONUS = -10;   // Bonus for same zone
-const int DispatchEngine::DEFAULT_CROSS_ZONE_PENALTY = 20; // Penalty for different zone
+const int DispatchEngine::DEFAULT_SAME_ZONE_BONUS = ZoneWeightedScoring::SAME_ZONE_BONUS;
+const int DispatchEngine::DEFAULT_CROSS_ZONE_PENALTY = ZoneWeightedScoring::CROSS_ZONE_PENALTY;
 
 // Initial capacities
 const int INITIAL_DRIVER_CAPACITY = 10;
@@ -15,8 +19,12 @@ const int INITIAL_RIDER_CAPACITY = 10;
 
 // ==================== DispatchEngine Implementation ====================
 
-DispatchEngine::DispatchEngine(City *cityPtr)
-    : city(cityPtr), driverCount(0), tripCount(0), riderCount(0), nextTripId(1000)
+DispatchEngine::DispatchEngine(City *cityPtr, int firstTripId, int tripIdStep)
+    : city(cityPtr), versionedCity(nullptr), oracle(nullptr), driverCount(0), tripCount(0), riderCount(0),
+      nextTripId(firstTripId), tripIdStep(tripIdStep > 0 ? tripIdStep : 1),
+      wal(nullptr), replaying(false), restoredLsn(0),
+      timeDependentScoring(false), currentTime(0), scoringPolicy(SCORING_ZONE_WEIGHTED),
+      routeMetrics(nullptr)
 {
 
     if (cityPtr == nullptr)
@@ -24,6 +32,44 @@ DispatchEngine::DispatchEngine(City *cityPtr)
         cout << "Warning: DispatchEngine created with null city pointer!" << endl;
     }
 
+    initializeStorage();
+    cout << "DispatchEngine initialized successfully! Next trip ID: " << nextTripId << endl;
+}
+
+DispatchEngine::DispatchEngine(VersionedCity *source, int firstTripId, int tripIdStep)
+    : city(nullptr), versionedCity(source), oracle(nullptr), driverCount(0), tripCount(0), riderCount(0),
+      nextTripId(firstTripId), tripIdStep(tripIdStep > 0 ? tripIdStep : 1),
+      wal(nullptr), replaying(false), restoredLsn(0),
+      timeDependentScoring(false), currentTime(0), scoringPolicy(SCORING_ZONE_WEIGHTED),
+      routeMetrics(nullptr)
+{
+    if (source == nullptr)
+    {
+        cout << "Warning: DispatchEngine created with null city pointer!" << endl;
+    }
+
+    initializeStorage();
+    cout << "DispatchEngine initialized on city snapshots! Next trip ID: " << nextTripId << endl;
+}
+
+DispatchEngine::DispatchEngine(const DistanceOracle *source, int firstTripId, int tripIdStep)
+    : city(nullptr), versionedCity(nullptr), oracle(source), driverCount(0), tripCount(0), riderCount(0),
+      nextTripId(firstTripId), tripIdStep(tripIdStep > 0 ? tripIdStep : 1),
+      wal(nullptr), replaying(false), restoredLsn(0),
+      timeDependentScoring(false), currentTime(0), scoringPolicy(SCORING_ZONE_WEIGHTED),
+      routeMetrics(nullptr)
+{
+    if (source == nullptr)
+    {
+        cout << "Warning: DispatchEngine created with null city pointer!" << endl;
+    }
+
+    initializeStorage();
+    cout << "DispatchEngine initialized on a precomputed city! Next trip ID: " << nextTripId << endl;
+}
+
+void DispatchEngine::initializeStorage()
+{
     // Initialize drivers array
     driverCapacity = INITIAL_DRIVER_CAPACITY;
     drivers = new Driver *[driverCapacity];
@@ -47,13 +93,11 @@ DispatchEngine::DispatchEngine(City *cityPtr)
     {
         riders[i] = nullptr;
     }
-
-    cout << "DispatchEngine initialized successfully! Next trip ID: " << nextTripId << endl;
 }
 
 DispatchEngine::~DispatchEngine()
 {
-    // Note: We don't delete drivers, riders, or trips here as they're managed elsewhere
+    // Engine-created objects are destroyed by the pools; registered ones belong to the caller
     delete[] drivers;
     delete[] trips;
     delete[] riders;
@@ -63,7 +107,8 @@ DispatchEngine::~DispatchEngine()
 bool DispatchEngine::assignDriverToTrip(int tripId, int driverId)
 {
     Trip *trip = findTripById(tripId);
-    Driver *driver = findDriverById(driverId);
+    int slot = findDriverSlot(driverId);
+    Driver *driver = slot == -1 ? nullptr : drivers[slot];
 
     if (!validateAssignment(trip, driver))
     {
@@ -74,7 +119,12 @@ bool DispatchEngine::assignDriverToTrip(int tripId, int driverId)
     if (trip->assignDriver(driverId))
     {
         // Update driver status
-        driver->setStatus(DRIVER_ASSIGNED);
+        setStatusAt(slot, DRIVER_ASSIGNED);
+        if (!pendingTrips.isEmpty())
+        {
+            pendingTrips.remove(tripId); // Assigned directly while waiting
+        }
+        logEvent(WAL_TRIP_ASSIGNED, tripId, driverId, trip->getPickupDistance());
         cout << "Driver " << driverId << " successfully assigned to trip " << tripId << endl;
         return true;
     }
@@ -96,11 +146,12 @@ bool DispatchEngine::startTrip(int tripId)
     if (trip->startTrip())
     {
         // Update driver status
-        Driver *driver = findDriverById(trip->getDriverId());
-        if (driver != nullptr)
+        int slot = findDriverSlot(trip->getDriverId());
+        if (slot != -1)
         {
-            driver->setStatus(DRIVER_ON_TRIP);
+            setStatusAt(slot, DRIVER_ON_TRIP);
         }
+        logEvent(WAL_TRIP_STARTED, tripId);
         return true;
     }
 
@@ -121,12 +172,12 @@ bool DispatchEngine::completeTrip(int tripId)
     if (trip->completeTrip())
     {
         // Update driver status
-        Driver *driver = findDriverById(trip->getDriverId());
-        if (driver != nullptr)
+        int slot = findDriverSlot(trip->getDriverId());
+        if (slot != -1)
         {
-            driver->setStatus(DRIVER_AVAILABLE);
+            setStatusAt(slot, DRIVER_AVAILABLE);
             // Update driver location to dropoff
-            driver->setCurrentLocation(trip->getDropoffLocation());
+            moveDriverAt(slot, trip->getDropoffLocation(), drivers[slot]->getZoneId());
         }
 
         // Update rider status
@@ -136,6 +187,14 @@ bool DispatchEngine::completeTrip(int tripId)
             rider->setActiveTripStatus(false);
         }
 
+        logEvent(WAL_TRIP_COMPLETED, tripId);
+        archiveTrip(trip, ONGOING);
+
+        // The driver is free at the dropoff; let the longest-waiting trip have it
+        if (slot != -1)
+        {
+            matchPending(slot);
+        }
         return true;
     }
 
@@ -152,18 +211,24 @@ bool DispatchEngine::cancelTrip(int tripId)
         return false;
     }
 
-    // Cancel the trip
+    // Cancel the trip (the dispatcher thread is the only writer, so this read is stable)
+    TripState priorState = trip->getState();
     if (trip->cancelTrip())
     {
         // Update driver status if trip was assigned or ongoing
+        int freedSlot = -1;
         if (trip->getDriverId() != -1)
         {
-            Driver *driver = findDriverById(trip->getDriverId());
-            if (driver != nullptr)
+            freedSlot = findDriverSlot(trip->getDriverId());
+            if (freedSlot != -1)
             {
-                driver->setStatus(DRIVER_AVAILABLE);
+                setStatusAt(freedSlot, DRIVER_AVAILABLE);
             }
         }
+        if (priorState == REQUESTED)
+        {
+            pendingTrips.remove(tripId);
+        }
 
         // Update rider status
         Rider *rider = findRiderById(trip->getRiderId());
@@ -172,6 +237,13 @@ bool DispatchEngine::cancelTrip(int tripId)
             rider->setActiveTripStatus(false);
         }
 
+        logEvent(WAL_TRIP_CANCELLED, tripId);
+        archiveTrip(trip, priorState);
+
+        if (freedSlot != -1)
+        {
+            matchPending(freedSlot);
+        }
         return true;
     }
 
@@ -217,6 +289,18 @@ bool DispatchEngine::validateAssignment(Trip *trip, Driver *driver) const
 
 // ==================== Driver ====================
 
+Driver *DispatchEngine::createDriver(int driverId, int locationId, int zone)
+{
+    if (findDriverById(driverId) != nullptr)
+    {
+        cout << "Error: Driver " << driverId << " is already registered!" << endl;
+        return nullptr;
+    }
+    Driver *driver = driverPool.create(driverId, locationId, zone);
+    registerDriver(driver);
+    return driver;
+}
+
 bool DispatchEngine::registerDriver(Driver *driver)
 {
     if (!driver)
@@ -224,32 +308,158 @@ bool DispatchEngine::registerDriver(Driver *driver)
     if (driverCount == driverCapacity)
         resizeDrivers();
     drivers[driverCount++] = driver;
+    fleet.add(driver->getId(), driver->getCurrentLocation(), driver->getZoneId(),
+              driver->getStatus());
+    logEvent(WAL_DRIVER_REGISTERED, driver->getId(), driver->getCurrentLocation(),
+             driver->getZoneId(), driver->getStatus());
+    matchPending(driverCount - 1);
     return true;
 }
 
 bool DispatchEngine::removeDriver(int driverId)
 {
-    for (int i = 0; i < driverCount; i++)
+    Driver *driver = detachDriver(driverId);
+    if (driver == nullptr)
+        return false;
+
+    driverPool.destroy(driver); // No-op for caller-owned drivers
+    return true;
+}
+
+Driver *DispatchEngine::detachDriver(int driverId)
+{
+    int slot = findDriverSlot(driverId);
+    if (slot == -1)
+        return nullptr;
+
+    // Same swap-with-last move on both arrays keeps their slots aligned
+    Driver *driver = drivers[slot];
+    drivers[slot] = drivers[--driverCount];
+    fleet.removeAt(slot);
+    logEvent(WAL_DRIVER_REMOVED, driverId);
+    return driver;
+}
+
+int DispatchEngine::findDriverSlot(int driverId) const
+{
+    // Scans the packed ID column rather than dereferencing every Driver
+    return fleet.findSlot(driverId);
+}
+
+Driver *DispatchEngine::findDriverById(int driverId) const
+{
+    int slot = findDriverSlot(driverId);
+    return slot == -1 ? nullptr : drivers[slot];
+}
+
+void DispatchEngine::setStatusAt(int slot, DriverStatus status)
+{
+    drivers[slot]->setStatus(status);
+    fleet.setStatus(slot, drivers[slot]->getStatus());
+}
+
+void DispatchEngine::moveDriverAt(int slot, int location, int zone)
+{
+    Driver *driver = drivers[slot];
+    driver->setCurrentLocation(location);
+    if (zone != driver->getZoneId())
     {
-        if (drivers[i]->getId() == driverId)
-        {
-            drivers[i] = drivers[--driverCount];
-            return true;
-        }
+        driver->setZoneId(zone);
     }
-    return false;
+    // Copy back what the Driver accepted, so a rejected value cannot desync the store
+    fleet.setLocation(slot, driver->getCurrentLocation(), driver->getZoneId());
 }
 
-Driver *DispatchEngine::findDriverById(int driverId) const
+bool DispatchEngine::updateDriverLocation(int driverId, int locationId)
 {
-    for (int i = 0; i < driverCount; i++)
-        if (drivers[i]->getId() == driverId)
-            return drivers[i];
-    return nullptr;
+    int slot = findDriverSlot(driverId);
+    if (slot == -1)
+    {
+        cout << "Error: Driver " << driverId << " not found!" << endl;
+        return false;
+    }
+
+    int zone = drivers[slot]->getZoneId();
+    if (city != nullptr || versionedCity != nullptr || oracle != nullptr)
+    {
+        zone = zoneOf(locationId);
+    }
+    moveDriverAt(slot, locationId, zone);
+
+    logEvent(WAL_DRIVER_LOCATION, driverId, locationId, zone);
+    return true;
+}
+
+int DispatchEngine::zoneOf(int locationId)
+{
+    if (city != nullptr)
+    {
+        return city->getZone(locationId);
+    }
+    if (versionedCity != nullptr)
+    {
+        SnapshotReader reader(*versionedCity);
+        return reader->getZone(locationId);
+    }
+    if (oracle != nullptr)
+    {
+        return oracle->getZone(locationId);
+    }
+    return -1;
+}
+
+bool DispatchEngine::setDriverStatus(int driverId, DriverStatus status)
+{
+    int slot = findDriverSlot(driverId);
+    if (slot == -1)
+    {
+        cout << "Error: Driver " << driverId << " not found!" << endl;
+        return false;
+    }
+
+    setStatusAt(slot, status);
+    logEvent(WAL_DRIVER_STATUS, driverId, status);
+    if (status == DRIVER_AVAILABLE)
+    {
+        matchPending(slot);
+    }
+    return true;
+}
+
+bool DispatchEngine::setDriverRating(int driverId, int tenths)
+{
+    Driver *driver = findDriverById(driverId);
+    if (driver == nullptr)
+    {
+        cout << "Error: Driver " << driverId << " not found!" << endl;
+        return false;
+    }
+
+    driver->setRating(tenths);
+    if (driver->getRating() != tenths)
+    {
+        return false; // Rejected as out of range
+    }
+    logEvent(WAL_DRIVER_RATING, driverId, tenths);
+    return true;
 }
 
 // ==================== Rider ====================
 
+Rider *DispatchEngine::createRider(int riderId, int pickup, int dropoff)
+{
+    if (findRiderById(riderId) != nullptr)
+    {
+        cout << "Error: Rider " << riderId << " already exists!" << endl;
+        return nullptr;
+    }
+    Rider *rider = riderPool.create(riderId, pickup, dropoff);
+    if (riderCount == riderCapacity)
+        resizeRiders();
+    riders[riderCount++] = rider;
+    return rider;
+}
+
 Rider *DispatchEngine::findRiderById(int riderId) const
 {
     for (int i = 0; i < riderCount; i++)
@@ -267,6 +477,8 @@ bool DispatchEngine::createTrip(Trip *trip)
     if (tripCount == tripCapacity)
         resizeTrips();
     trips[tripCount++] = trip;
+    logEvent(WAL_TRIP_CREATED, trip->getId(), trip->getRiderId(), trip->getPickupLocation(),
+             trip->getDropoffLocation(), trip->getDistance());
     return true;
 }
 
@@ -278,30 +490,500 @@ Trip *DispatchEngine::findTripById(int tripId) const
     return nullptr;
 }
 
+PoolHandle DispatchEngine::getTripHandle(int tripId) const
+{
+    return tripPool.handleOf(findTripById(tripId));
+}
+
+Trip *DispatchEngine::resolveTrip(PoolHandle handle) const
+{
+    return tripPool.get(handle);
+}
+
+void DispatchEngine::archiveTrip(Trip *trip, TripState priorState)
+{
+    history.append(*trip, priorState, zoneOf(trip->getPickupLocation()), currentTime);
+
+    // Active order carries no meaning, so fill the gap with the last trip
+    for (int i = 0; i < tripCount; i++)
+    {
+        if (trips[i] == trip)
+        {
+            trips[i] = trips[--tripCount];
+            break;
+        }
+    }
+    tripPool.destroy(trip); // No-op for caller-owned trips
+}
+
+const TripHistory &DispatchEngine::getTripHistory() const
+{
+    return history;
+}
+
+bool DispatchEngine::setTripPriority(int tripId, int priority)
+{
+    Trip *trip = findTripById(tripId);
+    if (trip == nullptr)
+    {
+        cout << "Error: Trip " << tripId << " not found!" << endl;
+        return false;
+    }
+
+    trip->setPriority(priority);
+    if (trip->getPriority() != priority)
+    {
+        return false; // Rejected as out of range
+    }
+    pendingTrips.setPriority(tripId, priority);
+    logEvent(WAL_TRIP_PRIORITY, tripId, priority);
+    return true;
+}
+
+// ==================== Pending Trips ====================
+
+void DispatchEngine::queuePending(const Trip *trip)
+{
+    PendingTrip entry;
+    entry.tripId = trip->getId();
+    entry.pickupLocation = trip->getPickupLocation();
+    entry.priority = trip->getPriority();
+    entry.sequence = trip->getId(); // Trip IDs grow with request order
+    pendingTrips.push(entry);
+}
+
+void DispatchEngine::rebuildPendingQueue()
+{
+    pendingTrips.clear();
+    for (int i = 0; i < tripCount; i++)
+    {
+        if (trips[i]->getState() == REQUESTED)
+        {
+            queuePending(trips[i]);
+        }
+    }
+}
+
+bool DispatchEngine::matchPending(int slot)
+{
+    if (replaying || pendingTrips.isEmpty() || fleet.getStatus(slot) != DRIVER_AVAILABLE)
+    {
+        return false;
+    }
+
+    if (versionedCity != nullptr)
+    {
+        SnapshotReader reader(*versionedCity);
+        return matchPendingOn(reader.get(), slot);
+    }
+    if (oracle != nullptr)
+    {
+        return matchPendingOn(*oracle, slot);
+    }
+    return matchPendingOn(*city, slot);
+}
+
+template <class Graph>
+bool DispatchEngine::matchPendingOn(const Graph &graph, int slot)
+{
+    int location = fleet.getLocation(slot);
+    int driverId = fleet.getId(slot);
+
+    // Trips the driver cannot reach are set aside and requeued unchanged
+    PendingTrip *skipped = nullptr;
+    int skippedCount = 0;
+    int skippedCapacity = 0;
+    bool matched = false;
+
+    PendingTrip entry;
+    while (!matched && pendingTrips.pop(entry))
+    {
+        Trip *trip = findTripById(entry.tripId);
+        if (trip == nullptr || trip->getState() != REQUESTED)
+        {
+            continue; // No longer waiting
+        }
+
+        int cost = -1;
+        if (graph.areConnected(location, entry.pickupLocation))
+        {
+            cost = travelCost(graph, location, entry.pickupLocation);
+        }
+
+        if (cost != -1)
+        {
+            trip->setPickupDistance(cost);
+            if (assignDriverToTrip(entry.tripId, driverId))
+            {
+                startTrip(entry.tripId);
+                cout << "Pending trip " << entry.tripId << " matched with driver " << driverId << endl;
+                matched = true;
+                continue;
+            }
+            trip->setPickupDistance(-1);
+        }
+
+        if (skippedCount == skippedCapacity)
+        {
+            skippedCapacity = skippedCapacity == 0 ? 4 : skippedCapacity * 2;
+            PendingTrip *grown = new PendingTrip[skippedCapacity];
+            for (int i = 0; i < skippedCount; i++)
+            {
+                grown[i] = skipped[i];
+            }
+            delete[] skipped;
+            skipped = grown;
+        }
+        skipped[skippedCount++] = entry;
+    }
+
+    for (int i = 0; i < skippedCount; i++)
+    {
+        pendingTrips.push(skipped[i]);
+    }
+    delete[] skipped;
+    return matched;
+}
+
 Trip *DispatchEngine::handleTripRequest(const Rider &rider, int distance)
 {
-    Trip *trip = new Trip(nextTripId++, rider.getId(),
-                          rider.getPickupLocation(),
-                          rider.getDropoffLocation(),
-                          distance);
+    Trip *trip = tripPool.create(nextTripId, rider.getId(),
+                                 rider.getPickupLocation(),
+                                 rider.getDropoffLocation(),
+                                 distance);
+    nextTripId += tripIdStep;
     createTrip(trip);
     return trip;
 }
 
+// ==================== Write-Ahead Log ====================
+
+void DispatchEngine::setWriteAheadLog(WriteAheadLog *log)
+{
+    wal = log;
+    if (wal != nullptr)
+    {
+        wal->continueAfter(restoredLsn);
+    }
+}
+
+WriteAheadLog *DispatchEngine::getWriteAheadLog() const
+{
+    return wal;
+}
+
+void DispatchEngine::logEvent(WalRecordType type, int f0, int f1, int f2, int f3, int f4)
+{
+    if (wal != nullptr && !replaying)
+    {
+        wal->append(type, f0, f1, f2, f3, f4);
+    }
+}
+
+bool DispatchEngine::applyLogRecord(const WalRecord &record)
+{
+    const int *f = record.fields;
+    switch (record.type)
+    {
+    case WAL_DRIVER_REGISTERED:
+    {
+        if (findDriverSlot(f[0]) == -1)
+            createDriver(f[0], f[1], f[2]);
+        int slot = findDriverSlot(f[0]);
+        moveDriverAt(slot, f[1], f[2]);
+        setStatusAt(slot, (DriverStatus)f[3]);
+        return true;
+    }
+    case WAL_DRIVER_REMOVED:
+        return removeDriver(f[0]);
+    case WAL_DRIVER_STATUS:
+        return setDriverStatus(f[0], (DriverStatus)f[1]);
+    case WAL_DRIVER_LOCATION:
+    {
+        int slot = findDriverSlot(f[0]);
+        if (slot == -1)
+            return false;
+        moveDriverAt(slot, f[1], f[2]);
+        return true;
+    }
+    case WAL_TRIP_CREATED:
+        if (findTripById(f[0]) != nullptr)
+            return false;
+        createTrip(tripPool.create(f[0], f[1], f[2], f[3], f[4]));
+        if (f[0] >= nextTripId)
+            nextTripId = f[0] + tripIdStep;
+        return true;
+    case WAL_TRIP_ASSIGNED:
+    {
+        Trip *trip = findTripById(f[0]);
+        if (trip != nullptr)
+        {
+            trip->setPickupDistance(f[2]);
+        }
+        return assignDriverToTrip(f[0], f[1]);
+    }
+    case WAL_TRIP_STARTED:
+        return startTrip(f[0]);
+    case WAL_TRIP_COMPLETED:
+        return completeTrip(f[0]);
+    case WAL_TRIP_CANCELLED:
+        return cancelTrip(f[0]);
+    case WAL_DRIVER_RATING:
+        return setDriverRating(f[0], f[1]);
+    case WAL_TRIP_PRIORITY:
+        return setTripPriority(f[0], f[1]);
+    case WAL_CLOCK:
+        setCurrentTime(f[0]);
+        return true;
+    case WAL_TRIP_ETA:
+    {
+        Trip *trip = findTripById(f[0]);
+        if (trip == nullptr)
+            return false;
+        trip->setEta(f[1]);
+        return true;
+    }
+    case WAL_TRIP_TOLL:
+    {
+        Trip *trip = findTripById(f[0]);
+        if (trip == nullptr)
+            return false;
+        trip->setToll(f[1]);
+        return true;
+    }
+    }
+    return false;
+}
+
+long long DispatchEngine::recoverFromLog(const char *path)
+{
+    WalReader reader(path);
+    if (!reader.isOpen())
+    {
+        cout << "Cannot recover: Log " << path << " not found!" << endl;
+        return -1;
+    }
+
+    // Replays through the normal lifecycle methods, so driver state follows trips
+    replaying = true;
+    long long applied = 0;
+    long long skipped = 0;
+    WalRecord record;
+    while (reader.next(record))
+    {
+        if (record.lsn <= restoredLsn)
+            continue; // Already reflected by the loaded snapshot
+        if (applyLogRecord(record))
+            applied++;
+        else
+            skipped++;
+    }
+    replaying = false;
+    rebuildPendingQueue();
+
+    cout << "Recovered " << applied << " log records from " << path;
+    if (skipped > 0)
+        cout << " (" << skipped << " could not be reapplied)";
+    if (reader.hasTornTail())
+        cout << ", stopped at a torn tail";
+    cout << ". Next trip ID: " << nextTripId << endl;
+    return applied;
+}
+
+// ==================== Snapshots ====================
+
+EngineImage *DispatchEngine::captureImage() const
+{
+    // Only durable records may be covered: after a crash the log reopens at
+    // its durable end and would reuse the numbers of anything past it
+    long long lsn = restoredLsn;
+    if (wal != nullptr)
+    {
+        lsn = wal->commit();
+        if (lsn < wal->getLastLsn())
+        {
+            cout << "Cannot snapshot: log records after LSN " << lsn << " are not durable!" << endl;
+            return nullptr;
+        }
+    }
+
+    EngineImage *image = new EngineImage(driverCount, riderCount, tripCount, history.getCount());
+    image->lsn = lsn;
+    image->nextTripId = nextTripId;
+    image->tripIdStep = tripIdStep;
+    image->currentTime = currentTime;
+
+    for (int i = 0; i < driverCount; i++)
+    {
+        image->driverColumns[COL_DRIVER_ID][i] = drivers[i]->getId();
+        image->driverColumns[COL_DRIVER_LOCATION][i] = drivers[i]->getCurrentLocation();
+        image->driverColumns[COL_DRIVER_ZONE][i] = drivers[i]->getZoneId();
+        image->driverColumns[COL_DRIVER_STATUS][i] = drivers[i]->getStatus();
+        image->driverColumns[COL_DRIVER_RATING][i] = drivers[i]->getRating();
+    }
+    for (int i = 0; i < riderCount; i++)
+    {
+        image->riderColumns[COL_RIDER_ID][i] = riders[i]->getId();
+        image->riderColumns[COL_RIDER_PICKUP][i] = riders[i]->getPickupLocation();
+        image->riderColumns[COL_RIDER_DROPOFF][i] = riders[i]->getDropoffLocation();
+        image->riderColumns[COL_RIDER_ACTIVE][i] = riders[i]->hasActiveTripStatus() ? 1 : 0;
+    }
+    for (int i = 0; i < tripCount; i++)
+    {
+        image->tripRows[i] = trips[i]->getRecord();
+    }
+
+    int finished = history.getCount();
+    const int *sources[HISTORY_COLUMN_COUNT] = {
+        history.getIds(), history.getRiders(), history.getDrivers(), history.getPickups(),
+        history.getDropoffs(), history.getDistances(), nullptr, nullptr, nullptr,
+        history.getPickupDistances(), history.getPickupZones(), history.getFinishTimes()};
+    for (int c = 0; c < HISTORY_COLUMN_COUNT; c++)
+    {
+        if (sources[c] != nullptr)
+            memcpy(image->historyColumns[c], sources[c], (size_t)finished * sizeof(int));
+    }
+    memcpy(image->historyColumns[COL_HISTORY_FARE], history.getFares(), (size_t)finished * sizeof(float));
+    for (int i = 0; i < finished; i++)
+    {
+        image->historyColumns[COL_HISTORY_STATE][i] = history.getStates()[i];
+        image->historyColumns[COL_HISTORY_PRIOR_STATE][i] = history.getPriorStates()[i];
+    }
+    return image;
+}
+
+bool DispatchEngine::saveSnapshot(const char *path) const
+{
+    EngineImage *image = captureImage();
+    if (image == nullptr)
+    {
+        return false;
+    }
+    bool saved = image->write(path);
+    delete image;
+    return saved;
+}
+
+future<bool> DispatchEngine::saveSnapshotAsync(const char *path) const
+{
+    // The copy is the consistent view; the writer thread never touches the engine
+    EngineImage *image = captureImage();
+    if (image == nullptr)
+    {
+        promise<bool> failed;
+        failed.set_value(false);
+        return failed.get_future();
+    }
+    string target = path;
+    return async(launch::async, [image, target]()
+                 {
+        bool saved = image->write(target.c_str());
+        delete image;
+        return saved; });
+}
+
+bool DispatchEngine::loadSnapshot(const char *path)
+{
+    // History rows carry no key to match against, so they would be duplicated
+    if (history.getCount() > 0)
+    {
+        cout << "Cannot load snapshot: Engine already has trip history!" << endl;
+        return false;
+    }
+
+    EngineImage *image = EngineImage::read(path);
+    if (image == nullptr)
+    {
+        return false;
+    }
+    if (tripCount > 0)
+    {
+        cout << "Warning: Loading a snapshot into an engine that already has trips!" << endl;
+    }
+
+    replaying = true;
+    for (int i = 0; i < image->driverCount; i++)
+    {
+        int id = image->driverColumns[COL_DRIVER_ID][i];
+        int location = image->driverColumns[COL_DRIVER_LOCATION][i];
+        int zone = image->driverColumns[COL_DRIVER_ZONE][i];
+        if (findDriverSlot(id) == -1)
+            createDriver(id, location, zone);
+        int slot = findDriverSlot(id);
+        moveDriverAt(slot, location, zone);
+        setStatusAt(slot, (DriverStatus)image->driverColumns[COL_DRIVER_STATUS][i]);
+        drivers[slot]->setRating(image->driverColumns[COL_DRIVER_RATING][i]);
+    }
+
+    for (int i = 0; i < image->riderCount; i++)
+    {
+        int id = image->riderColumns[COL_RIDER_ID][i];
+        Rider *rider = findRiderById(id);
+        if (rider == nullptr)
+            rider = createRider(id, image->riderColumns[COL_RIDER_PICKUP][i],
+                                image->riderColumns[COL_RIDER_DROPOFF][i]);
+        rider->setActiveTripStatus(image->riderColumns[COL_RIDER_ACTIVE][i] != 0);
+    }
+
+    for (int i = 0; i < image->tripCount; i++)
+    {
+        if (findTripById(image->tripRows[i].id) != nullptr)
+            continue;
+        createTrip(tripPool.create(image->tripRows[i]));
+    }
+
+    for (int i = 0; i < image->historyCount; i++)
+    {
+        float fare;
+        memcpy(&fare, &image->historyColumns[COL_HISTORY_FARE][i], sizeof(float));
+        history.appendRow(image->historyColumns[COL_HISTORY_ID][i],
+                          image->historyColumns[COL_HISTORY_RIDER][i],
+                          image->historyColumns[COL_HISTORY_DRIVER][i],
+                          image->historyColumns[COL_HISTORY_PICKUP][i],
+                          image->historyColumns[COL_HISTORY_DROPOFF][i],
+                          image->historyColumns[COL_HISTORY_DISTANCE][i], fare,
+                          (TripState)image->historyColumns[COL_HISTORY_STATE][i],
+                          (TripState)image->historyColumns[COL_HISTORY_PRIOR_STATE][i],
+                          image->historyColumns[COL_HISTORY_PICKUP_DISTANCE][i],
+                          image->historyColumns[COL_HISTORY_ZONE][i],
+                          image->historyColumns[COL_HISTORY_FINISH_TIME][i]);
+    }
+    replaying = false;
+    rebuildPendingQueue();
+
+    nextTripId = image->nextTripId;
+    tripIdStep = image->tripIdStep;
+    currentTime = image->currentTime;
+    restoredLsn = image->lsn;
+    if (wal != nullptr)
+    {
+        wal->continueAfter(restoredLsn);
+    }
+
+    cout << "Loaded snapshot " << path << ": " << image->driverCount << " drivers, "
+         << image->riderCount << " riders, " << image->tripCount << " active and "
+         << image->historyCount << " finished trips (log LSN "
+         << restoredLsn << ")" << endl;
+    delete image;
+    return true;
+}
+
+long long DispatchEngine::getRestoredLsn() const
+{
+    return restoredLsn;
+}
+
 // ==================== Queries ====================
 
 int DispatchEngine::getAvailableDriverCount() const
 {
-    int c = 0;
-    for (int i = 0; i < driverCount; i++)
-        if (drivers[i]->isAvailable())
-            c++;
-    return c;
+    return fleet.countAvailable();
 }
 
 int DispatchEngine::getTotalDriverCount() const { return driverCount; }
 int DispatchEngine::getActiveTripCount() const { return tripCount; }
-int DispatchEngine::getTotalTripCount() const { return tripCount; }
+int DispatchEngine::getTotalTripCount() const { return tripCount + history.getCount(); }
+int DispatchEngine::getPendingTripCount() const { return pendingTrips.getCount(); }
 
 // ==================== Printing ====================
 
@@ -311,6 +993,8 @@ void DispatchEngine::printStatus() const
     cout << "Total Drivers: " << driverCount << endl;
     cout << "Available Drivers: " << getAvailableDriverCount() << endl;
     cout << "Active Trips: " << tripCount << endl;
+    cout << "Pending Trips: " << pendingTrips.getCount() << endl;
+    cout << "Finished Trips: " << history.getCount() << endl;
     cout << "Next Trip ID: " << nextTripId << endl;
     cout << "================================\n"
          << endl;
@@ -354,71 +1038,307 @@ void DispatchEngine::printActiveTrips() const
          << endl;
 }
 
+void DispatchEngine::setTimeDependentScoring(bool enabled)
+{
+    if (enabled && city == nullptr)
+    {
+        cout << "Error: Time-dependent scoring needs a City; snapshots and oracles carry no profiles!" << endl;
+        return;
+    }
+    timeDependentScoring = enabled;
+}
+
+bool DispatchEngine::isTimeDependentScoring() const
+{
+    return timeDependentScoring;
+}
+
+void DispatchEngine::setCurrentTime(int minuteOfDay)
+{
+    // Logged because archived trips are stamped with the clock
+    if (minuteOfDay != currentTime)
+    {
+        logEvent(WAL_CLOCK, minuteOfDay);
+    }
+    currentTime = minuteOfDay;
+}
+
+int DispatchEngine::getCurrentTime() const
+{
+    return currentTime;
+}
+
+void DispatchEngine::setScoringPolicy(ScoringPolicyKind kind)
+{
+    if (kind < 0 || kind >= SCORING_POLICY_COUNT)
+    {
+        cout << "Error: Unknown scoring policy " << kind << "!" << endl;
+        return;
+    }
+    if (kind == SCORING_ETA_WEIGHTED && city == nullptr)
+    {
+        cout << "Warning: Only a City carries profiles; ETA scoring will use distances" << endl;
+    }
+    scoringPolicy = kind;
+}
+
+ScoringPolicyKind DispatchEngine::getScoringPolicy() const
+{
+    return scoringPolicy;
+}
+
+void DispatchEngine::setRoutePricing(MultiMetricGraph *graph, const MetricWeights &weights)
+{
+    routeMetrics = graph;
+    routeWeights = weights;
+}
+
+int DispatchEngine::travelCost(const City &graph, int from, int to) const
+{
+    if (timeDependentScoring)
+    {
+        return graph.getTravelTimeAt(from, to, currentTime);
+    }
+    return graph.getShortestDistance(from, to);
+}
+
+int DispatchEngine::travelCost(const CitySnapshot &graph, int from, int to) const
+{
+    return graph.getShortestDistance(from, to);
+}
+
+int DispatchEngine::travelTime(const City &graph, int from, int to) const
+{
+    return graph.getTravelTimeAt(from, to, currentTime);
+}
+
+int DispatchEngine::travelTime(const CitySnapshot &graph, int from, int to) const
+{
+    return graph.getShortestDistance(from, to);
+}
+
+int DispatchEngine::travelCost(const DistanceOracle &graph, int from, int to) const
+{
+    return graph.getShortestDistance(from, to);
+}
+
+int DispatchEngine::travelTime(const DistanceOracle &graph, int from, int to) const
+{
+    return graph.getShortestDistance(from, to);
+}
+
+template <class Policy, class Graph>
 int DispatchEngine::calculateDispatchScore(
-    Driver *driver,
+    const Graph &graph,
+    int slot,
     int riderLocation,
-    int sameZoneBonus,
-    int crossZonePenalty) const
+    int &cost) const
 {
-    int distance = city->getShortestDistance(
-        driver->getCurrentLocation(),
-        riderLocation);
+    int location = fleet.getLocation(slot);
+    cost = Policy::USES_TRAVEL_TIME ? travelTime(graph, location, riderLocation)
+                                    : travelCost(graph, location, riderLocation);
 
-    if (distance == -1)
+    if (cost == -1)
         return INT_MAX;
 
-    int driverZone = driver->getZoneId();
-    int riderZone = city->getZone(riderLocation);
+    bool sameZone = fleet.getZone(slot) == graph.getZone(riderLocation);
+    return Policy::score(cost, sameZone, drivers[slot]->getRating());
+}
 
-    if (driverZone == riderZone)
-        distance += sameZoneBonus;
-    else
-        distance += crossZonePenalty;
+Driver *DispatchEngine::findBestDriver(int riderPickupLocation)
+{
+    if (versionedCity != nullptr)
+    {
+        SnapshotReader reader(*versionedCity);
+        return findBestDriverOn(reader.get(), riderPickupLocation);
+    }
+    if (oracle != nullptr)
+    {
+        return findBestDriverOn(*oracle, riderPickupLocation);
+    }
+    return findBestDriverOn(*city, riderPickupLocation);
+}
+
+template <class Policy>
+Driver *DispatchEngine::findBestDriverWith(int riderPickupLocation)
+{
+    if (versionedCity != nullptr)
+    {
+        SnapshotReader reader(*versionedCity);
+        return scanDrivers<Policy>(reader.get(), riderPickupLocation, nullptr);
+    }
+    if (oracle != nullptr)
+    {
+        return scanDrivers<Policy>(*oracle, riderPickupLocation, nullptr);
+    }
+    return scanDrivers<Policy>(*city, riderPickupLocation, nullptr);
+}
+
+template Driver *DispatchEngine::findBestDriverWith<DistanceScoring>(int);
+template Driver *DispatchEngine::findBestDriverWith<ZoneWeightedScoring>(int);
+template Driver *DispatchEngine::findBestDriverWith<EtaWeightedScoring>(int);
+template Driver *DispatchEngine::findBestDriverWith<RatingWeightedScoring>(int);
 
-    return distance;
+template <class Graph>
+Driver *DispatchEngine::findBestDriverOn(const Graph &graph, int riderPickupLocation, int *pickupCost)
+{
+    // One branch per request; the scan itself is specialized per policy
+    switch (scoringPolicy)
+    {
+    case SCORING_DISTANCE:
+        return scanDrivers<DistanceScoring>(graph, riderPickupLocation, pickupCost);
+    case SCORING_ETA_WEIGHTED:
+        return scanDrivers<EtaWeightedScoring>(graph, riderPickupLocation, pickupCost);
+    case SCORING_RATING_WEIGHTED:
+        return scanDrivers<RatingWeightedScoring>(graph, riderPickupLocation, pickupCost);
+    case SCORING_ZONE_WEIGHTED:
+    default:
+        return scanDrivers<ZoneWeightedScoring>(graph, riderPickupLocation, pickupCost);
+    }
 }
 
-Driver *DispatchEngine::findBestDriver(int riderPickupLocation)
+template <class Policy, class Graph>
+Driver *DispatchEngine::scanDrivers(const Graph &graph, int riderPickupLocation, int *pickupCost)
 {
     Driver *bestDriver = nullptr;
     int bestScore = INT_MAX;
+    int bestCost = -1;
+    int riderZone = graph.getZone(riderPickupLocation);
 
-    for (int i = 0; i < driverCount; i++)
+    // Pass 0 scores drivers located in the rider's zone, which usually sets a
+    // tight best score; pass 1 scores the rest, skipping any whose zone lower
+    // bound, put through the policy, cannot beat it.
+    for (int pass = 0; pass < 2; pass++)
     {
-        if (!drivers[i]->isAvailable())
-            continue;
+        // Walk only the set bits of the availability bitset
+        for (int i = fleet.nextAvailable(0); i != -1; i = fleet.nextAvailable(i + 1))
+        {
+            int location = fleet.getLocation(i);
+            int locationZone = graph.getZone(location);
+            if ((locationZone == riderZone) != (pass == 0))
+                continue;
 
-        int score = calculateDispatchScore(
-            drivers[i],
-            riderPickupLocation,
-            DEFAULT_SAME_ZONE_BONUS,
-            DEFAULT_CROSS_ZONE_PENALTY);
+            // O(1) rejection of drivers that cannot reach the pickup at all
+            if (!graph.areConnected(location, riderPickupLocation))
+                continue;
 
-        if (score < bestScore)
-        {
-            bestScore = score;
-            bestDriver = drivers[i];
+            int lowerBound = graph.getZoneLowerBound(locationZone, riderZone);
+            if (lowerBound == INT_MAX)
+                continue;
+            if (timeDependentScoring || Policy::USES_TRAVEL_TIME)
+                lowerBound = 0; // Static bounds don't bound off-peak travel times
+
+            if (Policy::lowerBound(lowerBound, fleet.getZone(i) == riderZone) >= bestScore)
+                continue; // Search cannot produce a better score
+
+            int cost;
+            int score = calculateDispatchScore<Policy>(graph, i, riderPickupLocation, cost);
+
+            if (score < bestScore)
+            {
+                bestScore = score;
+                bestCost = cost;
+                bestDriver = drivers[i];
+            }
         }
     }
+
+    if (pickupCost != nullptr && bestDriver != nullptr)
+    {
+        *pickupCost = bestCost;
+    }
     return bestDriver;
 }
-Trip* DispatchEngine::requestTrip(const Rider& rider)
+Trip* DispatchEngine::requestTrip(const Rider& rider, int priority)
+{
+    if (versionedCity != nullptr)
+    {
+        // One snapshot for the whole request, however many versions get published meanwhile
+        SnapshotReader reader(*versionedCity);
+        return requestTripOn(reader.get(), rider, priority);
+    }
+    if (oracle != nullptr)
+    {
+        return requestTripOn(*oracle, rider, priority);
+    }
+    return requestTripOn(*city, rider, priority);
+}
+
+template <class Graph>
+Trip* DispatchEngine::requestTripOn(const Graph& graph, const Rider& rider, int priority)
 {
-    int distance = city->getShortestDistance(
-        rider.getPickupLocation(),
-        rider.getDropoffLocation()
-    );
+    // Reject impossible requests before paying for a search
+    if (!graph.areConnected(rider.getPickupLocation(), rider.getDropoffLocation()))
+    {
+        cout << "Trip request rejected: location " << rider.getDropoffLocation()
+             << " is unreachable from " << rider.getPickupLocation() << endl;
+        return nullptr;
+    }
+
+    // Charged by the route the pricing blend picks: its length plus its tolls
+    int distance;
+    int toll = 0;
+    if (routeMetrics != nullptr)
+    {
+        int totals[METRIC_COUNT];
+        distance = -1;
+        if (routeMetrics->getRouteMetrics(rider.getPickupLocation(), rider.getDropoffLocation(),
+                                          routeWeights, totals) != -1)
+        {
+            distance = totals[METRIC_DISTANCE];
+            toll = totals[METRIC_TOLL];
+        }
+    }
+    else
+    {
+        distance = graph.getShortestDistance(
+            rider.getPickupLocation(),
+            rider.getDropoffLocation()
+        );
+    }
 
     if (distance == -1)
         return nullptr;
 
     Trip* trip = handleTripRequest(rider, distance);
+    if (toll > 0)
+    {
+        trip->setToll(toll);
+        logEvent(WAL_TRIP_TOLL, trip->getId(), trip->getToll());
+    }
+    if (priority != 0)
+    {
+        setTripPriority(trip->getId(), priority);
+    }
 
-    Driver* bestDriver = findBestDriver(rider.getPickupLocation());
+    // Estimated ride time at the dispatch clock; without profiles it is the
+    // distance just measured, so static requests search the route only once
+    int eta = distance;
+    if (timeDependentScoring)
+    {
+        eta = travelTime(graph, rider.getPickupLocation(), rider.getDropoffLocation());
+    }
+    trip->setEta(eta);
+    logEvent(WAL_TRIP_ETA, trip->getId(), eta);
+
+    int pickupCost = -1;
+    Driver* bestDriver = findBestDriverOn(graph, rider.getPickupLocation(), &pickupCost);
     if (!bestDriver)
+    {
+        queuePending(trip);
+        cout << "No driver available for trip " << trip->getId() << "; queued with "
+             << pendingTrips.getCount() << " pending" << endl;
         return trip;
+    }
 
-    assignDriverToTrip(trip->getId(), bestDriver->getId());
+    // Recorded before assigning so the WAL assignment record carries it
+    trip->setPickupDistance(pickupCost);
+    if (!assignDriverToTrip(trip->getId(), bestDriver->getId()))
+    {
+        trip->setPickupDistance(-1);
+        queuePending(trip);
+        return trip;
+    }
     startTrip(trip->getId());
 
     return trip;
@@ -0,0 +1,166 @@
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+#include <cstdint>
+
+class City;
+
+/**
+ * @enum DistanceMatrixMethod
+ * @brief Algorithm a DistanceMatrix is built with
+ */
+enum DistanceMatrixMethod
+{
+    MATRIX_AUTO,           ///< Pick by graph density
+    MATRIX_FLOYD_WARSHALL, ///< Cache-blocked Floyd-Warshall, O(n^3) but vectorized
+    MATRIX_DIJKSTRA        ///< One heap Dijkstra per source, O(n m log n)
+};
+
+/**
+ * @class DistanceMatrix
+ * @brief All-pairs shortest distances of a City, one lookup per query
+ *
+ * For cities of up to a few thousand locations the whole matrix fits in
+ * memory. It is stored in 16-bit entries whenever every finite distance
+ * fits, and in 32-bit entries otherwise.
+ *
+ * Floyd-Warshall runs on BLOCK x BLOCK tiles: each round closes the
+ * diagonal tile, then its row and column, then relaxes every other tile
+ * through them. Tiles stay in cache, and the min-plus kernel works one tile
+ * row at a time with a fixed trip count and no aliasing, so the compiler
+ * vectorizes it. The independent tiles of a round, or the sources for the
+ * Dijkstra method, are split among threads.
+ *
+ * Updates follow ZoneDistanceMatrix: a new or shorter road is applied in
+ * O(n^2) by relaxing every pair through it; anything that can lengthen a
+ * distance, or a new location, marks the matrix stale and it is rebuilt on
+ * the next query.
+ *
+ * Rows and columns are the IDs 0 .. getNodeCount()-1. With sparse IDs (see
+ * City), roads into larger IDs are dropped when the matrix is built.
+ * Locations with larger IDs then read as unreachable, and distances that
+ * route through them come out too long.
+ */
+class DistanceMatrix
+{
+private:
+    const City *city;                ///< City the matrix describes
+    DistanceMatrixMethod method;     ///< Requested build algorithm
+    DistanceMatrixMethod usedMethod; ///< Algorithm of the last build
+    int threadCount;                 ///< Threads used to build (at least 1)
+    int nodeCount;                   ///< Number of locations covered
+    int stride;                      ///< Row length: nodeCount rounded up to BLOCK
+    uint16_t *narrow;                ///< stride x stride entries when distances fit 16 bits
+    int32_t *wide;                   ///< stride x stride entries otherwise
+    bool stale;                      ///< True if the matrix must be rebuilt before use
+    int buildCount;                  ///< Full builds so far
+    double lastBuildMillis;          ///< Duration of the last full build
+
+    DistanceMatrix(const DistanceMatrix &) = delete;
+    DistanceMatrix &operator=(const DistanceMatrix &) = delete;
+
+    /**
+     * @brief Frees the entries
+     */
+    void release();
+
+    /**
+     * @brief Rebuilds the matrix from scratch, 16-bit first
+     */
+    void rebuild();
+
+    /**
+     * @brief Fills entries with all-pairs distances
+     * @return false if a finite distance did not fit (entries then incomplete)
+     */
+    template <class T>
+    bool build(T *entries, const int *offsets, const int *targets, const int *weights);
+
+    /**
+     * @brief Blocked Floyd-Warshall over entries preloaded with road lengths
+     */
+    template <class T>
+    void runFloydWarshall(T *entries);
+
+    /**
+     * @brief One heap Dijkstra per source over the CSR graph
+     */
+    template <class T>
+    void runDijkstra(T *entries, const int *offsets, const int *targets, const int *weights);
+
+    /**
+     * @brief Checks that every location reaches its whole connected component
+     *
+     * A connected pair left unreachable means its distance overflowed T.
+     */
+    template <class T>
+    bool coversComponents(const T *entries) const;
+
+    /**
+     * @brief Relaxes every pair through a new road
+     * @return false if a new distance does not fit T
+     */
+    template <class T>
+    bool relaxThrough(T *entries, int from, int to, int distance);
+
+public:
+    static const int BLOCK = 64; ///< Tile side (multiple of the vector width)
+    static const uint16_t NARROW_UNREACHABLE = 0xFFFF;
+    static const int32_t WIDE_UNREACHABLE = 0x3FFFFFFF; ///< Sum of two never overflows
+
+    /**
+     * @brief Constructor (the matrix is built lazily on first query)
+     * @param cityPtr City to describe
+     * @param buildMethod Algorithm to build with
+     * @param threads Threads to build with (0 = one per hardware thread)
+     */
+    DistanceMatrix(const City *cityPtr, DistanceMatrixMethod buildMethod = MATRIX_AUTO, int threads = 1);
+
+    /**
+     * @brief Destructor
+     */
+    ~DistanceMatrix();
+
+    /**
+     * @brief Gets the shortest distance between two locations
+     * @return Distance, or -1 if unreachable or either location doesn't exist
+     */
+    int getDistance(int from, int to);
+
+    /**
+     * @brief Updates the matrix after a road was added or shortened
+     */
+    void onRoadAdded(int from, int to, int distance);
+
+    /**
+     * @brief Rebuilds the matrix now if it is stale
+     */
+    void refresh();
+
+    /**
+     * @brief Marks the matrix for a full rebuild
+     */
+    void invalidate();
+
+    /**
+     * @brief Checks whether entries are stored in 16 bits
+     */
+    bool isNarrow() const;
+
+    /**
+     * @brief Gets the algorithm the matrix was last built with
+     */
+    DistanceMatrixMethod getUsedMethod() const;
+
+    /**
+     * @brief Gets the number of bytes held by the entries
+     */
+    long long getMemoryBytes() const;
+
+    /**
+     * @brief Prints size, storage width and build statistics
+     */
+    void printStats() const;
+};
+
+#endif // DISTANCEMATRIX_H
@@ -0,0 +1,49 @@
+#ifndef DISTANCEORACLE_H
+#define DISTANCEORACLE_H
+
+/**
+ * @class DistanceOracle
+ * @brief Read-only road network that answers the queries dispatch needs
+ *
+ * The same questions DispatchEngine asks of a City or CitySnapshot, for
+ * graphs that precompute their answers (see StaticCity). Oracles are owned
+ * by the caller and must outlive any engine dispatching on them.
+ */
+class DistanceOracle
+{
+public:
+    /**
+     * @brief Gets the number of locations
+     */
+    virtual int getNodeCount() const = 0;
+
+    /**
+     * @brief Gets the shortest road distance between two locations
+     * @return Distance, or -1 if unreachable or either location doesn't exist
+     */
+    virtual int getShortestDistance(int from, int to) const = 0;
+
+    /**
+     * @brief Gets the zone of a location
+     * @return Zone ID, or -1 if the location doesn't exist or has no zone
+     */
+    virtual int getZone(int nodeId) const = 0;
+
+    /**
+     * @brief Checks whether two locations are connected by roads
+     */
+    virtual bool areConnected(int a, int b) const = 0;
+
+    /**
+     * @brief Gets a lower bound on the distance between any locations of two zones
+     * @return Lower bound (0 if unknown), INT_MAX if zoneB is unreachable from zoneA
+     */
+    virtual int getZoneLowerBound(int zoneA, int zoneB) const = 0;
+
+protected:
+    // Not deleted through the interface; keeping the destructor trivial lets
+    // implementations be constexpr literal types
+    ~DistanceOracle() = default;
+};
+
+#endif // DISTANCEORACLE_H
@@ -0,0 +1,128 @@
+#ifndef DISTANCETREECACHE_H
+#define DISTANCETREECACHE_H
+
+#include "Citydj.h"
+
+/**
+ * @class DistanceTreeCache
+ * @brief Keeps shortest-path trees of recently queried sources and repairs them on road changes
+ *
+ * A query from a cached source is an O(1) lookup. When roads change, each
+ * cached tree is repaired in the style of Ramalingam-Reps instead of being
+ * recomputed:
+ * - a longer or closed road only matters if it is a tree edge; the subtree
+ *   hanging below it is invalidated, each of its locations is re-seeded from
+ *   its best neighbor outside the subtree, and a Dijkstra pass restricted to
+ *   improving locations settles the subtree;
+ * - a shorter or new road relaxes its two endpoints and the same pass
+ *   propagates only the locations whose distance actually drops.
+ * The work is proportional to the part of the tree that changes. The least
+ * recently used tree is evicted when the cache is full; a new location drops
+ * every tree.
+ *
+ * A tree holds one entry per ID 0 .. getNodeCount()-1. With sparse IDs (see
+ * City), relaxing a road into a larger ID writes past the tree.
+ */
+class DistanceTreeCache
+{
+private:
+    const City *city; ///< City the trees describe
+    int maxTrees;     ///< Number of trees kept
+    int treeCount;    ///< Number of trees currently cached
+    int nodeCount;    ///< Locations covered by every tree
+
+    int *sources;       ///< Source of each tree
+    int **distances;    ///< Per tree: distance from the source (INT_MAX if unreachable)
+    int **parents;      ///< Per tree: predecessor on the shortest path (-1 for none)
+    long long *lastUsed; ///< Per tree: use stamp for LRU eviction
+    long long useClock;  ///< Advanced on every query
+
+    int *affected;   ///< Stamp per location marking the invalidated subtree
+    int affectStamp; ///< Current stamp value
+    int *childHead;  ///< First child of each location in the tree being repaired
+    int *childNext;  ///< Next sibling of each location
+    int *pending;    ///< Work list of invalidated locations
+
+    int *scratchNeighbors; ///< Scratch buffer for a location's neighbors
+    int *scratchDistances; ///< Scratch buffer for a location's road distances
+    int scratchCapacity;   ///< Capacity of the scratch buffers
+
+    long long hits;          ///< Queries answered from a cached tree
+    long long misses;        ///< Queries that built a tree
+    long long repairs;       ///< Tree repairs performed
+    long long repairedNodes; ///< Locations touched by repairs
+
+    DistanceTreeCache(const DistanceTreeCache &) = delete;
+    DistanceTreeCache &operator=(const DistanceTreeCache &) = delete;
+
+    /**
+     * @brief Decodes a location's roads into the scratch buffers
+     * @return Number of roads
+     */
+    int loadRoads(int nodeId);
+
+    /**
+     * @brief Reallocates the per-location arrays for the city's current size
+     */
+    void resizeToCity();
+
+    /**
+     * @brief Finds the cached tree of a source
+     * @return Tree index, or -1 if not cached
+     */
+    int findTree(int source) const;
+
+    /**
+     * @brief Computes the tree of a source into a free or evicted slot
+     * @return Tree index
+     */
+    int buildTree(int source);
+
+    /**
+     * @brief Repairs one tree after a batch of road changes
+     */
+    void repairTree(int tree, const City::RoadUpdate *updates, const int *oldDistances, int count);
+
+public:
+    /**
+     * @brief Constructor
+     * @param cityPtr City to describe
+     * @param treeLimit Number of source trees kept
+     */
+    DistanceTreeCache(const City *cityPtr, int treeLimit);
+
+    /**
+     * @brief Destructor
+     */
+    ~DistanceTreeCache();
+
+    /**
+     * @brief Gets the shortest distance between two locations
+     * @return Shortest distance, or -1 if no path exists
+     */
+    int getShortestDistance(int source, int destination);
+
+    /**
+     * @brief Repairs every cached tree after roads changed
+     * @param updates Applied updates (distance is the new value or City::ROAD_CLOSED)
+     * @param oldDistances Distance before each update (City::ROAD_CLOSED if the road was missing)
+     * @param count Number of updates
+     */
+    void onRoadsChanged(const City::RoadUpdate *updates, const int *oldDistances, int count);
+
+    /**
+     * @brief Drops every cached tree (e.g. after a new location)
+     */
+    void invalidate();
+
+    long long getHits() const;
+    long long getMisses() const;
+    long long getRepairedNodes() const;
+
+    /**
+     * @brief Prints hit/miss and repair statistics
+     */
+    void printStats() const;
+};
+
+#endif // DISTANCETREECACHE_H
@@ -28,8 +28,34 @@ private:
     int currentLocation; ///< Current node/location ID where driver is
     int zoneId;          ///< Zone ID where driver operates
     DriverStatus status; ///< Current availability status
+    int rating;          ///< Rider rating in tenths of a star (MIN_RATING to MAX_RATING)
+
+    // Location, zone and status are mirrored in the engine's FleetStore, so
+    // only the engine may change them (updateDriverLocation, setDriverStatus)
+    friend class DispatchEngine;
+
+    /**
+     * @brief Sets the driver's current location
+     * @param locationId New location node ID
+     */
+    void setCurrentLocation(int locationId);
+
+    /**
+     * @brief Sets the driver's zone
+     * @param zoneId New zone ID
+     */
+    void setZoneId(int zoneId);
+
+    /**
+     * @brief Sets the driver's status
+     * @param newStatus New status to set
+     */
+    void setStatus(DriverStatus newStatus);
 
 public:
+    static const int MIN_RATING = 10; ///< 1.0 stars
+    static const int MAX_RATING = 50; ///< 5.0 stars, the rating of a new driver
+
     /**
      * @brief Default constructor
      */
@@ -60,24 +86,12 @@ public:
      */
     int getCurrentLocation() const;
 
-    /**
-     * @brief Sets the driver's current location
-     * @param locationId New location node ID
-     */
-    void setCurrentLocation(int locationId);
-
     /**
      * @brief Gets the driver's zone
      * @return Zone ID
      */
     int getZoneId() const;
 
-    /**
-     * @brief Sets the driver's zone
-     * @param zoneId New zone ID
-     */
-    void setZoneId(int zoneId);
-
     /**
      * @brief Gets the driver's current status
      * @return Current DriverStatus
@@ -85,10 +99,16 @@ public:
     DriverStatus getStatus() const;
 
     /**
-     * @brief Sets the driver's status
-     * @param newStatus New status to set
+     * @brief Gets the driver's rating
+     * @return Rating in tenths of a star
      */
-    void setStatus(DriverStatus newStatus);
+    int getRating() const;
+
+    /**
+     * @brief Sets the driver's rating
+     * @param tenths Rating in tenths of a star (MIN_RATING to MAX_RATING)
+     */
+    void setRating(int tenths);
 
     /**
      * @brief Checks if the driver is available for a new trip
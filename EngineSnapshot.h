@@ -0,0 +1,118 @@
+#ifndef ENGINESNAPSHOT_H
+#define ENGINESNAPSHOT_H
+
+#include "TripRecord.h"
+
+/**
+ * @enum DriverColumn
+ * @brief Columns of the driver table in an EngineImage
+ */
+enum DriverColumn
+{
+    COL_DRIVER_ID,
+    COL_DRIVER_LOCATION,
+    COL_DRIVER_ZONE,
+    COL_DRIVER_STATUS,
+    COL_DRIVER_RATING,
+    DRIVER_COLUMN_COUNT
+};
+
+/**
+ * @enum RiderColumn
+ * @brief Columns of the rider table in an EngineImage
+ */
+enum RiderColumn
+{
+    COL_RIDER_ID,
+    COL_RIDER_PICKUP,
+    COL_RIDER_DROPOFF,
+    COL_RIDER_ACTIVE,
+    RIDER_COLUMN_COUNT
+};
+
+/**
+ * @enum HistoryColumn
+ * @brief Columns of the finished-trip table in an EngineImage
+ */
+enum HistoryColumn
+{
+    COL_HISTORY_ID,
+    COL_HISTORY_RIDER,
+    COL_HISTORY_DRIVER,
+    COL_HISTORY_PICKUP,
+    COL_HISTORY_DROPOFF,
+    COL_HISTORY_DISTANCE,
+    COL_HISTORY_FARE, ///< Bit pattern of the float fare
+    COL_HISTORY_STATE,
+    COL_HISTORY_PRIOR_STATE,
+    COL_HISTORY_PICKUP_DISTANCE,
+    COL_HISTORY_ZONE,
+    COL_HISTORY_FINISH_TIME,
+    HISTORY_COLUMN_COUNT
+};
+
+/**
+ * @class EngineImage
+ * @brief Plain columnar copy of a DispatchEngine's live objects
+ *
+ * Active trips are stored as TripRecord rows to rebuild Trip objects from;
+ * finished trips are copied column for column from the TripHistory.
+ *
+ * Captured on the dispatch thread in one pass over the engine, after which
+ * it shares nothing with the engine and can be written from any thread.
+ *
+ * On disk: a 64-byte header (magic, byte-order mark, counts, clock, trip ID
+ * generator and the WAL LSN the image reflects), then the driver and rider
+ * columns as raw 32-bit arrays, the trip records as one block, the history
+ * columns, and an FNV-1a checksum. Columns start 4-byte aligned so a
+ * mapped file can be read in place on a machine of the same byte order.
+ * Only live objects are rebuilt on load; finished trips are bulk column
+ * copies, and neither depends on the length of the event log.
+ */
+class EngineImage
+{
+private:
+    EngineImage(const EngineImage &) = delete;
+    EngineImage &operator=(const EngineImage &) = delete;
+
+public:
+    static const int HEADER_SIZE = 64; ///< Bytes before the first column
+
+    long long lsn;   ///< Last WAL record reflected in the image (0 if none)
+    int nextTripId;  ///< Trip ID generator state
+    int tripIdStep;  ///< Trip ID increment
+    int currentTime; ///< Dispatch clock
+
+    int driverCount;
+    int riderCount;
+    int tripCount;
+    int historyCount;
+    int *driverColumns[DRIVER_COLUMN_COUNT]; ///< driverCount entries each
+    int *riderColumns[RIDER_COLUMN_COUNT];   ///< riderCount entries each
+    TripRecord *tripRows;                    ///< tripCount records
+    int *historyColumns[HISTORY_COLUMN_COUNT]; ///< historyCount entries each
+
+    /**
+     * @brief Allocates columns for the given row counts
+     */
+    EngineImage(int drivers, int riders, int trips, int finished);
+
+    /**
+     * @brief Destructor
+     */
+    ~EngineImage();
+
+    /**
+     * @brief Writes the image to a temporary file, syncs it and renames it over path
+     * @return true on success
+     */
+    bool write(const char *path) const;
+
+    /**
+     * @brief Reads an image written by write()
+     * @return New image (caller deletes), or nullptr if missing or corrupt
+     */
+    static EngineImage *read(const char *path);
+};
+
+#endif // ENGINESNAPSHOT_H
@@ -0,0 +1,87 @@
+#ifndef FLEETSTORE_H
+#define FLEETSTORE_H
+
+#include "Driver.h"
+
+/**
+ * @class FleetStore
+ * @brief Struct-of-arrays copy of the dispatch-relevant fields of a fleet
+ *
+ * Slot i holds one driver's ID, status, zone and location in four parallel
+ * packed arrays, plus bit i of an availability bitset that is set exactly
+ * when the status is DRIVER_AVAILABLE. Scans that would otherwise follow a
+ * Driver pointer per driver read a few contiguous arrays instead: counting
+ * available drivers is a popcount per 64 drivers, and walking them skips a
+ * whole word of busy drivers at a time.
+ *
+ * Removal moves the last slot into the hole, matching the way the engine
+ * compacts its driver array, so slot i always describes the same driver as
+ * the engine's drivers[i].
+ */
+class FleetStore
+{
+private:
+    int count;
+    int capacity;
+    int *ids;
+    unsigned char *statuses;
+    int *zones;
+    int *locations;
+    unsigned long long *availableBits; ///< capacity / 64 words
+
+    FleetStore(const FleetStore &) = delete;
+    FleetStore &operator=(const FleetStore &) = delete;
+
+    void grow();
+    void setAvailableBit(int slot, bool available);
+
+public:
+    /**
+     * @brief Creates an empty store
+     */
+    FleetStore();
+
+    /**
+     * @brief Destructor
+     */
+    ~FleetStore();
+
+    /**
+     * @brief Appends a driver
+     * @return Slot index
+     */
+    int add(int driverId, int location, int zone, DriverStatus status);
+
+    /**
+     * @brief Removes a slot by moving the last slot into it
+     */
+    void removeAt(int slot);
+
+    /**
+     * @brief Finds the slot of a driver
+     * @return Slot index, or -1 if absent
+     */
+    int findSlot(int driverId) const;
+
+    void setStatus(int slot, DriverStatus status);
+    void setLocation(int slot, int location, int zone);
+
+    int getCount() const;
+    int getId(int slot) const;
+    DriverStatus getStatus(int slot) const;
+    int getZone(int slot) const;
+    int getLocation(int slot) const;
+
+    /**
+     * @brief Counts available drivers by popcount over the bitset
+     */
+    int countAvailable() const;
+
+    /**
+     * @brief Finds the first available slot at or after a slot
+     * @return Slot index, or -1 if there is none
+     */
+    int nextAvailable(int from) const;
+};
+
+#endif // FLEETSTORE_H
@@ -0,0 +1,99 @@
+#ifndef GRAPHPARTITIONER_H
+#define GRAPHPARTITIONER_H
+
+#include "Citydj.h"
+
+/**
+ * @class GraphPartitioner
+ * @brief Splits a City into balanced zones that cut as few roads as possible
+ *
+ * Multilevel scheme:
+ * 1. Coarsening: repeatedly contract a heavy-edge matching until the graph is small.
+ * 2. Initial partition: greedy graph growing on the coarsest graph.
+ * 3. Uncoarsening: project the partition back level by level, running
+ *    boundary refinement (gain-based vertex moves under the balance limit) at each level.
+ *
+ * The objective is the number of roads whose endpoints land in different
+ * zones; road distances do not matter.
+ *
+ * Vertices are the IDs 0 .. getNodeCount()-1, and road endpoints are used
+ * as vertex numbers directly. With sparse IDs (see City), a road into a
+ * larger ID points outside the coarsest graph's arrays.
+ */
+class GraphPartitioner
+{
+private:
+    const City &city;  ///< City to partition
+    int nodeCount;     ///< Number of locations
+    int partCount;     ///< Number of zones requested in the last run
+    int *parts;        ///< Zone assigned to each location
+    int *partSizes;    ///< Number of locations in each zone
+    int cutSize;       ///< Roads crossing zones in the result
+
+    GraphPartitioner(const GraphPartitioner &) = delete;
+    GraphPartitioner &operator=(const GraphPartitioner &) = delete;
+
+public:
+    /**
+     * @brief Constructor
+     * @param cityRef City to partition (read only)
+     */
+    GraphPartitioner(const City &cityRef);
+
+    /**
+     * @brief Destructor
+     */
+    ~GraphPartitioner();
+
+    /**
+     * @brief Computes a partition into zoneCount balanced zones
+     * @param zoneCount Number of zones to create (>= 1)
+     * @param imbalanceTolerance Allowed excess of the largest zone over the
+     *        average size (0.05 = 5%)
+     * @return true if a partition was computed
+     */
+    bool partition(int zoneCount, double imbalanceTolerance = 0.05);
+
+    /**
+     * @brief Gets the zone assigned to a location by the last run
+     * @return Zone ID, or -1 if no partition or unknown location
+     */
+    int getPart(int nodeId) const;
+
+    /**
+     * @brief Gets the number of roads crossing zones in the last run
+     */
+    int getCutSize() const;
+
+    /**
+     * @brief Gets the balance of the last run
+     * @return Largest zone size divided by the average zone size (1.0 is perfect)
+     */
+    double getImbalance() const;
+
+    /**
+     * @brief Gets the number of locations in a zone of the last run
+     */
+    int getPartSize(int zoneId) const;
+
+    /**
+     * @brief Writes the computed zones back to a city through City::setZones
+     * @param target City to update (normally the partitioned city)
+     * @return Number of locations whose zone changed
+     */
+    int applyToCity(City &target) const;
+
+    /**
+     * @brief Counts roads whose endpoints are in different zones of a city
+     *
+     * Useful to compare hand-set zones against a computed partition.
+     */
+    static int countCutRoads(const City &city);
+
+    /**
+     * @brief Prints cut size, balance and zone sizes of the last run
+     */
+    void printReport() const;
+};
+
+#endif // GRAPHPARTITIONER_H
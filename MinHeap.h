@@ -0,0 +1,87 @@
+#ifndef MINHEAP_H
+#define MINHEAP_H
+
+/**
+ * @class MinHeap
+ * @brief Binary min-heap of (key, value) integer pairs used as a Dijkstra priority queue
+ *
+ * Entries are never decreased in place; callers push a new entry and skip
+ * stale ones when they are popped (lazy deletion). Uses dynamic arrays
+ * instead of STL containers.
+ */
+class MinHeap
+{
+private:
+    int *keys;    ///< Priority of each entry (smallest is popped first)
+    int *values;  ///< Payload of each entry (usually a node ID)
+    int size;     ///< Current number of entries
+    int capacity; ///< Current capacity of the arrays
+
+    /**
+     * @brief Doubles the capacity of the heap arrays
+     */
+    void resize();
+
+    /**
+     * @brief Moves the entry at index up until the heap property holds
+     */
+    void siftUp(int index);
+
+    /**
+     * @brief Moves the entry at index down until the heap property holds
+     */
+    void siftDown(int index);
+
+    MinHeap(const MinHeap &) = delete;
+    MinHeap &operator=(const MinHeap &) = delete;
+
+public:
+    /**
+     * @brief Constructor
+     * @param initialCapacity Number of entries to reserve up front
+     */
+    MinHeap(int initialCapacity = 16);
+
+    /**
+     * @brief Destructor
+     */
+    ~MinHeap();
+
+    /**
+     * @brief Inserts an entry
+     * @param key Priority of the entry
+     * @param value Payload of the entry
+     */
+    void push(int key, int value);
+
+    /**
+     * @brief Removes the entry with the smallest key
+     * @param key Receives the key of the removed entry
+     * @param value Receives the payload of the removed entry
+     * @return true if an entry was removed, false if the heap is empty
+     */
+    bool pop(int &key, int &value);
+
+    /**
+     * @brief Gets the smallest key without removing it
+     * @return Smallest key, or INT_MAX if the heap is empty
+     */
+    int peekKey() const;
+
+    /**
+     * @brief Checks if the heap has no entries
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Gets the number of entries
+     */
+    int getSize() const;
+
+    /**
+     * @brief Removes all entries while keeping the allocated capacity
+     */
+    void clear();
+};
+
+#endif // MINHEAP_H
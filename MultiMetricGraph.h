@@ -0,0 +1,199 @@
+#ifndef MULTIMETRICGRAPH_H
+#define MULTIMETRICGRAPH_H
+
+#include "Citydj.h"
+
+/**
+ * @enum Metric
+ * @brief Per-road cost metrics kept side by side
+ */
+enum Metric
+{
+    METRIC_DISTANCE, ///< Road length in km
+    METRIC_TIME,     ///< Expected travel time in minutes
+    METRIC_TOLL,     ///< Toll charged for the road
+    METRIC_COUNT     ///< Number of metrics
+};
+
+/**
+ * @struct MetricWeights
+ * @brief Blend of metrics: cost = distance * w0 + time * w1 + toll * w2
+ */
+struct MetricWeights
+{
+    int weights[METRIC_COUNT]; ///< Weight of each metric (non-negative, not all zero)
+
+    MetricWeights();                             ///< Pure distance
+    MetricWeights(int distance, int time, int toll); ///< Explicit blend
+
+    /**
+     * @brief Weights that select a single metric
+     */
+    static MetricWeights only(Metric metric);
+
+    bool operator==(const MetricWeights &other) const;
+};
+
+/**
+ * @class MultiMetricGraph
+ * @brief Road graph with several metric arrays and a customizable zone overlay
+ *
+ * Topology is stored once in CSR form and every metric is a parallel array
+ * over the same arcs, so changing a metric never touches topology.
+ *
+ * Queries use a one-level overlay in the spirit of customizable route
+ * planning, with the city's zones as cells:
+ * - Preprocessing (constructor, metric independent) finds each cell's
+ *   boundary locations, i.e. those with a road into another cell.
+ * - Customization (customize) blends the metrics into one arc cost and, per
+ *   cell, computes the cost between every pair of its boundary locations
+ *   using only roads inside the cell. Only cells whose roads changed since
+ *   the last customization are redone, unless the blend itself changed.
+ * - A query searches the full roads of the source and target cells and
+ *   crosses every other cell through its boundary clique in one step.
+ *
+ * Roads are copied for IDs 0 .. getNodeCount()-1, and their far ends are
+ * kept as array indices. With sparse IDs (see City), a road into a larger
+ * ID reads past the per-location arrays during cell and query searches.
+ */
+class MultiMetricGraph
+{
+private:
+    // ===== Topology (CSR) =====
+    int nodeCount;   ///< Number of locations
+    int arcCount;    ///< Number of directed arcs
+    int *firstArc;   ///< First arc of each location (nodeCount + 1 entries)
+    int *arcHead;    ///< Target location of each arc
+    int *metrics[METRIC_COUNT]; ///< Per metric: value of each arc
+    int *arcCost;    ///< Blended cost of each arc (valid after customization)
+
+    // ===== Overlay =====
+    int cellCount;          ///< Number of cells (zones, plus one for unassigned locations)
+    int *cellOf;            ///< Cell of each location
+    int *boundaryStart;     ///< First boundary entry of each cell (cellCount + 1 entries)
+    int *boundaryNodes;     ///< Boundary locations grouped by cell
+    int *boundaryIndex;     ///< Position of a location within its cell's boundary list, or -1
+    int *cliqueStart;       ///< First clique entry of each cell (cellCount + 1 entries)
+    int *cliqueCost;        ///< Per cell, b x b blended cost between boundary locations
+    int *cliqueTotals[METRIC_COUNT]; ///< Per metric: total along each clique path
+    bool *cellDirty;        ///< Cell must be recustomized
+    MetricWeights customWeights; ///< Blend of the current customization
+    bool customized;        ///< True once customize has run
+
+    // ===== Scratch for searches =====
+    int *scratchCost;    ///< Cost per location
+    int *scratchTotals[METRIC_COUNT]; ///< Per metric total per location
+    int *touched;        ///< Locations whose scratch entries must be reset
+    int touchedCount;    ///< Entries in touched
+
+    long long customizedCells; ///< Cells customized so far
+
+    MultiMetricGraph(const MultiMetricGraph &) = delete;
+    MultiMetricGraph &operator=(const MultiMetricGraph &) = delete;
+
+    /**
+     * @brief Finds the arc from one location to another
+     * @return Arc index, or -1 if no road
+     */
+    int findArc(int from, int to) const;
+
+    /**
+     * @brief Recomputes one cell's boundary clique with the current arc costs
+     */
+    void customizeCell(int cell);
+
+    /**
+     * @brief Sets a location's scratch cost and totals, remembering it for reset
+     */
+    void setScratch(int node, int cost, const int *totals);
+
+    /**
+     * @brief Resets the scratch entries of every touched location
+     */
+    void resetScratch();
+
+    /**
+     * @brief Overlay search shared by the public queries
+     * @param totals Receives the per-metric totals of the best route (may be nullptr)
+     * @return Blended cost, or -1 if no path exists
+     */
+    int overlaySearch(int source, int target, int *totals);
+
+public:
+    /**
+     * @brief Builds topology and overlay cells from a city
+     *
+     * Distance and time start as the road distance, toll at 0.
+     * @param city Source city (later changes are not reflected)
+     */
+    MultiMetricGraph(const City &city);
+
+    /**
+     * @brief Destructor
+     */
+    ~MultiMetricGraph();
+
+    int getNodeCount() const;
+    int getCellCount() const;
+
+    /**
+     * @brief Gets the number of boundary locations over all cells
+     */
+    int getBoundaryCount() const;
+
+    /**
+     * @brief Sets one metric of a road (both directions)
+     * @return true if set, false if the road doesn't exist or the value is negative
+     */
+    bool setRoadMetric(int from, int to, Metric metric, int value);
+
+    /**
+     * @brief Gets one metric of a road
+     * @return Metric value, or -1 if no road
+     */
+    int getRoadMetric(int from, int to, Metric metric) const;
+
+    /**
+     * @brief Runs the customization phase for a metric blend
+     *
+     * Redoes every cell if the blend changed, otherwise only cells with
+     * changed roads.
+     * @return Number of cells customized
+     */
+    int customize(const MetricWeights &weights);
+
+    /**
+     * @brief Gets the cheapest blended cost between two locations
+     *
+     * Customizes first if needed for this blend.
+     * @return Blended cost, or -1 if no path exists
+     */
+    int getShortestCost(int source, int target, const MetricWeights &weights);
+
+    /**
+     * @brief Gets the per-metric totals along the cheapest route for a blend
+     *
+     * For example, route on time but charge on distance and toll.
+     * @param totals Receives METRIC_COUNT totals
+     * @return Blended cost, or -1 if no path exists
+     */
+    int getRouteMetrics(int source, int target, const MetricWeights &weights, int *totals);
+
+    /**
+     * @brief Reference Dijkstra over all roads, without the overlay
+     * @return Blended cost, or -1 if no path exists
+     */
+    int getShortestCostDirect(int source, int target, const MetricWeights &weights) const;
+
+    /**
+     * @brief Gets the number of cells customized since construction
+     */
+    long long getCustomizedCellCount() const;
+
+    /**
+     * @brief Prints topology and overlay sizes
+     */
+    void printReport() const;
+};
+
+#endif // MULTIMETRICGRAPH_H
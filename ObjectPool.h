@@ -0,0 +1,263 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <new>
+#include <utility>
+#include <functional>
+#include <cstddef>
+
+/**
+ * @struct PoolHandle
+ * @brief Stable reference to a pooled object that detects reuse of its slot
+ */
+struct PoolHandle
+{
+    int index;      ///< Slot index in the pool (-1 = null handle)
+    int generation; ///< Slot generation when the handle was issued
+
+    PoolHandle() : index(-1), generation(0) {}
+    PoolHandle(int slotIndex, int slotGeneration) : index(slotIndex), generation(slotGeneration) {}
+
+    bool isNull() const { return index < 0; }
+};
+
+/**
+ * @class ObjectPool
+ * @brief Slab allocator owning objects of one type, with a free list and generation-checked handles
+ *
+ * Objects are constructed in place in slabs of SLAB_SIZE slots. Slabs are
+ * never moved or freed before the pool, so object pointers stay valid until
+ * the object is destroyed, and neighbours share cache lines. Destroyed slots
+ * go on a free list and are reused first; their generation is bumped so old
+ * handles resolve to nullptr instead of the new occupant. The pool destroys
+ * every live object when it is destroyed. owns() accepts any pointer and
+ * finds its slab by binary search over the slabs sorted by address.
+ *
+ * @tparam T Pooled type
+ * @tparam SLAB_SIZE Slots per slab
+ */
+template <class T, int SLAB_SIZE = 64>
+class ObjectPool
+{
+private:
+    /**
+     * @struct Slot
+     * @brief Storage for one object plus its bookkeeping
+     */
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)]; ///< Object bytes (first, so T* converts to Slot*)
+        int index;      ///< Slot index in the pool
+        int generation; ///< Bumped on every destroy
+        int nextFree;   ///< Next free slot index, or -1
+        bool live;      ///< Slot holds a constructed object
+    };
+
+    Slot **slabs;     ///< Slab pointers (each SLAB_SIZE slots)
+    Slot **sortedSlabs; ///< The same slabs in address order, for owns()
+    int slabCount;    ///< Slabs allocated
+    int slabCapacity; ///< Capacity of the slab pointer array
+    int freeHead;     ///< First free slot index, or -1
+    int liveCount;    ///< Constructed objects
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    Slot &slotAt(int index) const
+    {
+        return slabs[index / SLAB_SIZE][index % SLAB_SIZE];
+    }
+
+    /**
+     * @brief Adds a slab and threads its slots onto the free list
+     */
+    void addSlab()
+    {
+        if (slabCount == slabCapacity)
+        {
+            int newCapacity = slabCapacity * 2;
+            Slot **newSlabs = new Slot *[newCapacity];
+            Slot **newSorted = new Slot *[newCapacity];
+            for (int i = 0; i < slabCount; i++)
+            {
+                newSlabs[i] = slabs[i];
+                newSorted[i] = sortedSlabs[i];
+            }
+            delete[] slabs;
+            delete[] sortedSlabs;
+            slabs = newSlabs;
+            sortedSlabs = newSorted;
+            slabCapacity = newCapacity;
+        }
+
+        Slot *slab = new Slot[SLAB_SIZE];
+        int base = slabCount * SLAB_SIZE;
+        for (int i = SLAB_SIZE - 1; i >= 0; i--)
+        {
+            slab[i].index = base + i;
+            slab[i].generation = 0;
+            slab[i].live = false;
+            slab[i].nextFree = freeHead;
+            freeHead = base + i;
+        }
+
+        // Insertion into the address order; slabs are added rarely
+        int position = slabCount;
+        while (position > 0 && std::less<const Slot *>()(slab, sortedSlabs[position - 1]))
+        {
+            sortedSlabs[position] = sortedSlabs[position - 1];
+            position--;
+        }
+        sortedSlabs[position] = slab;
+        slabs[slabCount++] = slab;
+    }
+
+    static Slot *slotOf(const T *object)
+    {
+        return reinterpret_cast<Slot *>(const_cast<T *>(object));
+    }
+
+public:
+    /**
+     * @brief Creates an empty pool (no slab is allocated until the first create)
+     */
+    ObjectPool() : slabCount(0), slabCapacity(4), freeHead(-1), liveCount(0)
+    {
+        slabs = new Slot *[slabCapacity];
+        sortedSlabs = new Slot *[slabCapacity];
+    }
+
+    /**
+     * @brief Destroys every live object and frees the slabs
+     */
+    ~ObjectPool()
+    {
+        for (int s = 0; s < slabCount; s++)
+        {
+            for (int i = 0; i < SLAB_SIZE; i++)
+            {
+                if (slabs[s][i].live)
+                {
+                    reinterpret_cast<T *>(slabs[s][i].storage)->~T();
+                }
+            }
+            delete[] slabs[s];
+        }
+        delete[] slabs;
+        delete[] sortedSlabs;
+    }
+
+    /**
+     * @brief Constructs an object in a free slot
+     * @return Pointer to the object, valid until destroy()
+     */
+    template <class... Args>
+    T *create(Args &&...args)
+    {
+        if (freeHead == -1)
+        {
+            addSlab();
+        }
+        Slot &slot = slotAt(freeHead);
+        T *object = new (slot.storage) T(std::forward<Args>(args)...);
+        freeHead = slot.nextFree;
+        slot.live = true;
+        liveCount++;
+        return object;
+    }
+
+    /**
+     * @brief Destroys a pooled object and recycles its slot
+     * @return true if the object was live in this pool
+     */
+    bool destroy(T *object)
+    {
+        if (!owns(object))
+        {
+            return false;
+        }
+        Slot *slot = slotOf(object);
+        object->~T();
+        slot->live = false;
+        slot->generation++;
+        slot->nextFree = freeHead;
+        freeHead = slot->index;
+        liveCount--;
+        return true;
+    }
+
+    /**
+     * @brief Checks if a pointer is a live object of this pool
+     */
+    bool owns(const T *object) const
+    {
+        if (object == nullptr)
+        {
+            return false;
+        }
+        // Last slab starting at or before the object
+        const Slot *slot = reinterpret_cast<const Slot *>(object);
+        std::less<const Slot *> before;
+        int low = 0;
+        int high = slabCount - 1;
+        int found = -1;
+        while (low <= high)
+        {
+            int middle = (low + high) / 2;
+            if (before(slot, sortedSlabs[middle]))
+            {
+                high = middle - 1;
+            }
+            else
+            {
+                found = middle;
+                low = middle + 1;
+            }
+        }
+        if (found == -1 || !before(slot, sortedSlabs[found] + SLAB_SIZE))
+        {
+            return false;
+        }
+
+        // Must be the start of a slot, not a pointer into one
+        size_t offset = reinterpret_cast<const unsigned char *>(slot) -
+                        reinterpret_cast<const unsigned char *>(sortedSlabs[found]);
+        return offset % sizeof(Slot) == 0 && slot->live;
+    }
+
+    /**
+     * @brief Gets a handle to a live pooled object
+     */
+    PoolHandle handleOf(const T *object) const
+    {
+        if (!owns(object))
+        {
+            return PoolHandle();
+        }
+        Slot *slot = slotOf(object);
+        return PoolHandle(slot->index, slot->generation);
+    }
+
+    /**
+     * @brief Resolves a handle
+     * @return The object, or nullptr if it was destroyed since the handle was issued
+     */
+    T *get(PoolHandle handle) const
+    {
+        if (handle.index < 0 || handle.index >= slabCount * SLAB_SIZE)
+        {
+            return nullptr;
+        }
+        Slot &slot = slotAt(handle.index);
+        if (!slot.live || slot.generation != handle.generation)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<T *>(slot.storage);
+    }
+
+    int getLiveCount() const { return liveCount; }
+    int getCapacity() const { return slabCount * SLAB_SIZE; }
+};
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,186 @@
+#ifndef PAGEDCITY_H
+#define PAGEDCITY_H
+
+#include "Citydj.h"
+#include <fstream>
+
+/**
+ * @class PagedCity
+ * @brief Out-of-core City backend that keeps adjacency in fixed-size pages on disk
+ *
+ * Locations are written partition by partition (grouped by zone) so that a
+ * search inside one zone touches few pages. Each location's roads form one
+ * record: a road count followed by (neighbor, distance) pairs. A record that
+ * fits in a page never straddles a page boundary.
+ *
+ * The file starts with a header (node count, page size, page count and the
+ * per-location record offsets and zones), so it can be reopened later without
+ * the City that produced it. Only the header stays in memory; pages are
+ * loaded on demand into an LRU cache bounded by a memory budget. When a page
+ * faults, the following pages of the same partition are prefetched.
+ *
+ * The query API mirrors City::dijkstra and City::getShortestDistance.
+ */
+class PagedCity
+{
+private:
+    int nodeCount;             ///< Number of locations
+    int pageSize;              ///< Page size in bytes
+    int pageCount;             ///< Number of pages in the file
+    long long *recordOffsets;  ///< File offset of each location's record
+    int *zones;                ///< Zone ID per location
+    int *pagePartitions;       ///< Zone of the first record on each page
+    int maxDegree;             ///< Largest road count of any location
+    int prefetchDepth;         ///< Pages to prefetch after a fault
+    long long dataStart;       ///< File offset of page 0 (the header comes first)
+
+    mutable std::ifstream file; ///< Page file opened for reading
+
+    // ===== LRU Page Cache =====
+    int frameCount;               ///< Number of page frames allowed by the budget
+    mutable unsigned char *frames; ///< Frame storage (frameCount * pageSize bytes)
+    mutable int *framePages;      ///< Page held by each frame (-1 if free)
+    mutable int *pageFrames;      ///< Frame holding each page (-1 if not resident)
+    mutable int *lruPrev;         ///< Previous frame in LRU order
+    mutable int *lruNext;         ///< Next frame in LRU order
+    mutable int lruHead;          ///< Most recently used frame
+    mutable int lruTail;          ///< Least recently used frame
+    mutable int usedFrames;       ///< Frames filled so far (free frames come first)
+    mutable int *recordBuffer;    ///< Scratch space for one decoded record
+
+    // ===== Counters =====
+    mutable long long pageFaults; ///< Demand loads from disk
+    mutable long long cacheHits;  ///< Page requests served from memory
+    mutable long long prefetches; ///< Pages loaded ahead of demand
+
+    PagedCity(const PagedCity &) = delete;
+    PagedCity &operator=(const PagedCity &) = delete;
+
+    /**
+     * @brief Writes the page file for a city
+     */
+    bool writePages(const City &city, const char *path);
+
+    /**
+     * @brief Reads and validates the header of the open page file
+     * @return false if the file is not a page file of this format
+     */
+    bool readHeader();
+
+    /**
+     * @brief Allocates the page cache for the open file
+     */
+    void openCache(long long cacheBudgetBytes);
+
+    /**
+     * @brief Moves a frame to the front of the LRU list
+     */
+    void touchFrame(int frame) const;
+
+    /**
+     * @brief Reads a page from disk into a frame, evicting the LRU page if needed
+     * @return Frame index now holding the page, or -1 if the read came up short
+     */
+    int loadPage(int page) const;
+
+    /**
+     * @brief Returns the bytes of a page, loading it on a miss
+     * @return Page bytes, or nullptr if the page could not be read
+     */
+    const unsigned char *fetchPage(int page) const;
+
+    /**
+     * @brief Loads the following pages of the same partition if not resident
+     */
+    void prefetchAfter(int page) const;
+
+    /**
+     * @brief Copies bytes starting at a page offset through the page cache
+     * @return false if a page could not be read
+     */
+    bool readBytes(long long offset, unsigned char *destination, int length) const;
+
+    /**
+     * @brief Reads the road record of a location
+     * @return Number of roads, or -1 if location doesn't exist or its record is unreadable
+     */
+    int readRoads(int nodeId, int *neighborArray, int *distanceArray) const;
+
+public:
+    /**
+     * @brief Writes a city's adjacency to a page file and opens it for queries
+     * @param city Source city (later changes are not reflected)
+     * @param path Page file to create (overwritten if it exists)
+     * @param cacheBudgetBytes Memory budget for cached pages
+     * @param pageSizeBytes Size of each page in bytes
+     */
+    PagedCity(const City &city, const char *path,
+              long long cacheBudgetBytes, int pageSizeBytes = 4096);
+
+    /**
+     * @brief Opens an existing page file for queries
+     * @param path Page file written earlier by the other constructor
+     * @param cacheBudgetBytes Memory budget for cached pages
+     */
+    PagedCity(const char *path, long long cacheBudgetBytes);
+
+    /**
+     * @brief Destructor
+     */
+    ~PagedCity();
+
+    /**
+     * @brief Checks if the page file was written or read and opened successfully
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Sets how many pages of the same partition are prefetched after a fault
+     * @param depth Number of pages (0 disables prefetching)
+     */
+    void setPrefetchDepth(int depth);
+
+    /**
+     * @brief Gets the total number of locations
+     */
+    int getNodeCount() const;
+
+    /**
+     * @brief Checks if a location exists
+     */
+    bool locationExists(int id) const;
+
+    /**
+     * @brief Gets the zone ID for a location
+     * @return Zone ID, or -1 if location doesn't exist
+     */
+    int getZone(int nodeId) const;
+
+    /**
+     * @brief Dijkstra's shortest path algorithm over paged adjacency
+     * @param source Source node ID
+     * @return ShortestPathResult with distances and predecessors from source
+     */
+    City::ShortestPathResult dijkstra(int source) const;
+
+    /**
+     * @brief Gets the shortest distance between two specific nodes
+     * @return Shortest distance, or -1 if no path exists
+     */
+    int getShortestDistance(int source, int destination) const;
+
+    // ===== Cache Counters =====
+    long long getPageFaults() const;
+    long long getCacheHits() const;
+    long long getPrefetches() const;
+    int getPageCount() const;
+    int getCachedPageLimit() const;
+    void resetCounters();
+
+    /**
+     * @brief Prints page cache counters and hit ratio
+     */
+    void printCacheStats() const;
+};
+
+#endif // PAGEDCITY_H
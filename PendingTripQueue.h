@@ -0,0 +1,118 @@
+#ifndef PENDINGTRIPQUEUE_H
+#define PENDINGTRIPQUEUE_H
+
+/**
+ * @struct PendingTrip
+ * @brief One trip waiting for a driver
+ */
+struct PendingTrip
+{
+    int tripId;         ///< Waiting trip
+    int pickupLocation; ///< Where the driver has to go
+    int priority;       ///< Higher is matched first
+    int sequence;       ///< Arrival order; lower has waited longer
+};
+
+/**
+ * @class PendingTripQueue
+ * @brief Binary heap of trips that found no driver, most urgent first
+ *
+ * Orders by priority, then by sequence, so among equal priorities the trip
+ * that has waited longest comes out first. remove() and setPriority() find
+ * the entry by a linear scan; both are rare next to push and pop. Uses a
+ * dynamic array instead of STL containers.
+ */
+class PendingTripQueue
+{
+private:
+    PendingTrip *entries; ///< Heap-ordered entries
+    int count;            ///< Current number of entries
+    int capacity;         ///< Current capacity of entries
+
+    /**
+     * @brief Checks whether a must be matched before b
+     */
+    static bool before(const PendingTrip &a, const PendingTrip &b);
+
+    /**
+     * @brief Doubles the capacity of the entry array
+     */
+    void resize();
+
+    /**
+     * @brief Moves the entry at index up until the heap property holds
+     */
+    void siftUp(int index);
+
+    /**
+     * @brief Moves the entry at index down until the heap property holds
+     */
+    void siftDown(int index);
+
+    /**
+     * @brief Gets the index of a trip's entry, or -1 if it is not queued
+     */
+    int indexOf(int tripId) const;
+
+    PendingTripQueue(const PendingTripQueue &) = delete;
+    PendingTripQueue &operator=(const PendingTripQueue &) = delete;
+
+public:
+    /**
+     * @brief Constructor
+     * @param initialCapacity Number of entries to reserve up front
+     */
+    PendingTripQueue(int initialCapacity = 16);
+
+    /**
+     * @brief Destructor
+     */
+    ~PendingTripQueue();
+
+    /**
+     * @brief Queues a trip
+     * @param entry Trip, pickup, priority and arrival order
+     */
+    void push(const PendingTrip &entry);
+
+    /**
+     * @brief Removes the most urgent trip
+     * @param entry Receives the removed entry
+     * @return true if an entry was removed, false if the queue is empty
+     */
+    bool pop(PendingTrip &entry);
+
+    /**
+     * @brief Removes a trip wherever it is in the queue
+     * @return true if the trip was queued
+     */
+    bool remove(int tripId);
+
+    /**
+     * @brief Changes the priority of a queued trip, keeping its arrival order
+     * @return true if the trip was queued
+     */
+    bool setPriority(int tripId, int priority);
+
+    /**
+     * @brief Checks if a trip is queued
+     */
+    bool contains(int tripId) const;
+
+    /**
+     * @brief Checks if the queue has no entries
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Gets the number of queued trips
+     */
+    int getCount() const;
+
+    /**
+     * @brief Removes all entries while keeping the allocated capacity
+     */
+    void clear();
+};
+
+#endif // PENDINGTRIPQUEUE_H
@@ -0,0 +1,64 @@
+#ifndef REQUESTQUEUE_H
+#define REQUESTQUEUE_H
+
+#include <atomic>
+
+/**
+ * @struct QueueNode
+ * @brief Intrusive link for items stored in a RequestQueue
+ *
+ * Anything submitted to the queue derives from QueueNode, so enqueueing
+ * never allocates.
+ */
+struct QueueNode
+{
+    std::atomic<QueueNode *> next; ///< Next node in FIFO order
+
+    QueueNode() : next(nullptr) {}
+    virtual ~QueueNode() {}
+};
+
+/**
+ * @class RequestQueue
+ * @brief Lock-free multi-producer / single-consumer FIFO queue
+ *
+ * Any number of threads may push concurrently; exactly one thread may pop.
+ * A push is one atomic exchange plus one store and never blocks or retries.
+ * Based on the intrusive MPSC queue by Dmitry Vyukov: producers swap
+ * themselves into head, the consumer walks from tail.
+ */
+class RequestQueue
+{
+private:
+    std::atomic<QueueNode *> head; ///< Most recently pushed node (producers)
+    QueueNode *tail;               ///< Oldest node not yet popped (consumer only)
+    QueueNode stub;                ///< Sentinel that keeps the list non-empty
+
+    RequestQueue(const RequestQueue &) = delete;
+    RequestQueue &operator=(const RequestQueue &) = delete;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    RequestQueue();
+
+    /**
+     * @brief Enqueues a node (safe from any thread)
+     * @param node Node to append; the queue does not take ownership
+     */
+    void push(QueueNode *node);
+
+    /**
+     * @brief Dequeues the oldest node (consumer thread only)
+     * @return The node, or nullptr if the queue is empty or a push is mid-flight
+     */
+    QueueNode *pop();
+
+    /**
+     * @brief Checks if the queue looks empty (consumer thread only)
+     */
+    bool isEmpty() const;
+};
+
+#endif // REQUESTQUEUE_H
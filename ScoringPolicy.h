@@ -0,0 +1,140 @@
+#ifndef SCORINGPOLICY_H
+#define SCORINGPOLICY_H
+
+#include "Driver.h"
+#include <climits>
+
+/**
+ * @enum ScoringPolicyKind
+ * @brief Runtime name of one of the scoring policies below
+ */
+enum ScoringPolicyKind
+{
+    SCORING_DISTANCE,        ///< DistanceScoring
+    SCORING_ZONE_WEIGHTED,   ///< ZoneWeightedScoring (the default)
+    SCORING_ETA_WEIGHTED,    ///< EtaWeightedScoring
+    SCORING_RATING_WEIGHTED, ///< RatingWeightedScoring
+    SCORING_POLICY_COUNT
+};
+
+/*
+ * A scoring policy is a struct of static members, passed as a template
+ * argument so the dispatch loop is compiled once per policy with the score
+ * inlined into it:
+ *
+ *   USES_TRAVEL_TIME       cost is the travel time at the dispatch clock
+ *                          rather than the shortest distance
+ *   score(cost, sameZone, rating)
+ *                          lower is better; must not decrease as cost grows
+ *                          or increase as rating grows
+ *   lowerBound(cost, sameZone)
+ *                          score of the best-rated driver at that cost, so
+ *                          candidates whose bound cannot win are skipped
+ *                          without a shortest-path query
+ */
+
+/**
+ * @struct DistanceScoring
+ * @brief Nearest driver wins
+ */
+struct DistanceScoring
+{
+    static const bool USES_TRAVEL_TIME = false;
+
+    static int score(int cost, bool, int) { return cost; }
+    static int lowerBound(int cost, bool) { return cost; }
+};
+
+/**
+ * @struct ZoneWeightedScoring
+ * @brief Distance plus a bonus for staying in the rider's zone or a penalty for leaving it
+ */
+struct ZoneWeightedScoring
+{
+    static const bool USES_TRAVEL_TIME = false;
+    static const int SAME_ZONE_BONUS = -10;
+    static const int CROSS_ZONE_PENALTY = 20;
+
+    static int adjustment(bool sameZone) { return sameZone ? SAME_ZONE_BONUS : CROSS_ZONE_PENALTY; }
+    static int score(int cost, bool sameZone, int) { return cost + adjustment(sameZone); }
+    static int lowerBound(int cost, bool sameZone) { return cost + adjustment(sameZone); }
+};
+
+/**
+ * @struct EtaWeightedScoring
+ * @brief Zone-weighted, but on travel time at the dispatch clock instead of distance
+ */
+struct EtaWeightedScoring
+{
+    static const bool USES_TRAVEL_TIME = true;
+
+    static int score(int cost, bool sameZone, int) { return cost + ZoneWeightedScoring::adjustment(sameZone); }
+    static int lowerBound(int cost, bool sameZone) { return cost + ZoneWeightedScoring::adjustment(sameZone); }
+};
+
+/**
+ * @struct RatingWeightedScoring
+ * @brief Zone-weighted distance plus a penalty per tenth of a star below the top rating
+ */
+struct RatingWeightedScoring
+{
+    static const bool USES_TRAVEL_TIME = false;
+    static const int PENALTY_PER_TENTH = 2;
+
+    static int score(int cost, bool sameZone, int rating)
+    {
+        return cost + ZoneWeightedScoring::adjustment(sameZone) +
+               (Driver::MAX_RATING - rating) * PENALTY_PER_TENTH;
+    }
+    static int lowerBound(int cost, bool sameZone) { return cost + ZoneWeightedScoring::adjustment(sameZone); }
+};
+
+/**
+ * @brief Picks the lowest-scoring candidate under a compile-time policy
+ * @param costs Travel cost per candidate (negative = unreachable, skipped)
+ * @param sameZone Non-zero if the candidate is in the rider's zone
+ * @param ratings Rating per candidate in tenths of a star
+ * @return Index of the best candidate, or -1 if none is reachable
+ */
+template <class Policy>
+int selectBestCandidate(const int *costs, const unsigned char *sameZone, const int *ratings, int count)
+{
+    int best = -1;
+    int bestScore = INT_MAX;
+    for (int i = 0; i < count; i++)
+    {
+        if (costs[i] < 0)
+            continue;
+        int score = Policy::score(costs[i], sameZone[i] != 0, ratings[i]);
+        if (score < bestScore)
+        {
+            bestScore = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief selectBestCandidate with the policy chosen at runtime (one switch per call)
+ */
+int selectBestCandidate(ScoringPolicyKind kind, const int *costs, const unsigned char *sameZone,
+                        const int *ratings, int count);
+
+/**
+ * @brief Scores one candidate with the policy chosen at runtime (one switch per candidate)
+ */
+int scoreCandidate(ScoringPolicyKind kind, int cost, bool sameZone, int rating);
+
+/**
+ * @brief Converts a policy to its configuration name
+ */
+const char *scoringPolicyName(ScoringPolicyKind kind);
+
+/**
+ * @brief Looks up a policy by configuration name ("distance", "zone", "eta", "rating")
+ * @return true if the name is known
+ */
+bool parseScoringPolicy(const char *name, ScoringPolicyKind &kind);
+
+#endif // SCORINGPOLICY_H
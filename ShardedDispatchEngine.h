@@ -0,0 +1,134 @@
+#ifndef SHARDEDDISPATCHENGINE_H
+#define SHARDEDDISPATCHENGINE_H
+
+#include "DispatchWorker.h"
+#include <atomic>
+#include <future>
+#include <memory>
+
+/**
+ * @class ShardedDispatchEngine
+ * @brief Runs one DispatchEngine per group of zones, each on its own dispatcher thread
+ *
+ * Requests are routed to the shard owning the pickup location's zone
+ * (zone % shardCount; unassigned locations go to shard 0). Each shard has
+ * its own driver pool. When a shard has no suitable driver for a request,
+ * it asks its ring neighbors (+1, -1, +2, -2, ...) one at a time, up to
+ * maxStealHops shards, to give up their best driver for the pickup. All
+ * messages between shards are tasks posted to the other shard's queue, so
+ * no shard ever blocks on another and no engine is touched by two threads.
+ *
+ * Trip IDs are interleaved across shards (shard s issues 1000 + s,
+ * 1000 + s + shardCount, ...), so the owning shard of a trip is implied by its ID.
+ */
+class ShardedDispatchEngine
+{
+private:
+    City *city;                 ///< Shared city (read only while running)
+    int shardCount;             ///< Number of shards
+    int maxStealHops;           ///< Neighbor shards asked before giving up
+    DispatchEngine **engines;   ///< One engine per shard
+    DispatchWorker **workers;   ///< One dispatcher thread per shard
+    bool started;               ///< True between start() and stop()
+
+    std::atomic<int> inFlight;            ///< Requests not yet answered
+    std::atomic<long long> stealAttempts; ///< Steal messages sent to neighbors
+    std::atomic<long long> stealSuccesses; ///< Drivers transferred between shards
+
+    ShardedDispatchEngine(const ShardedDispatchEngine &) = delete;
+    ShardedDispatchEngine &operator=(const ShardedDispatchEngine &) = delete;
+
+    /**
+     * @brief Gets the neighbor shard asked at a given hop of the steal protocol
+     * @return Victim shard, or -1 if the hop budget is exhausted
+     */
+    int victimShard(int originShard, int hop) const;
+
+    /**
+     * @brief Asks the next neighbor shard for a driver (runs on any shard thread)
+     */
+    void requestSteal(int originShard, int tripId, int pickup, int hop,
+                      std::shared_ptr<std::promise<TripRequestResult>> result);
+
+    /**
+     * @brief Answers a request with the trip's current state (runs on the origin shard)
+     */
+    void finishRequest(DispatchEngine &origin, int tripId,
+                       std::shared_ptr<std::promise<TripRequestResult>> result);
+
+public:
+    static const int FIRST_TRIP_ID;
+
+    /**
+     * @brief Constructor
+     * @param cityPtr Shared city; must not be modified while the engine runs
+     * @param shards Number of shards (>= 1)
+     * @param stealHops Maximum neighbor shards asked for a driver per request
+     */
+    ShardedDispatchEngine(City *cityPtr, int shards, int stealHops = 2);
+
+    /**
+     * @brief Destructor (stops all shards)
+     */
+    ~ShardedDispatchEngine();
+
+    /**
+     * @brief Registers a driver with the shard owning its current location (before start)
+     * @return true if registered
+     */
+    bool registerDriver(Driver *driver);
+
+    /**
+     * @brief Creates a driver owned by the shard for its location (before start)
+     *
+     * The driver stays valid while the sharded engine exists, even if another
+     * shard steals it.
+     * @return The driver, or nullptr on failure
+     */
+    Driver *createDriver(int driverId, int locationId, int zone);
+
+    /**
+     * @brief Starts every shard's dispatcher thread
+     *
+     * Refused if the city has a distance cache: every query updates the
+     * cache, and the shards would query it from several threads at once.
+     * @return true if the shards are running
+     */
+    bool start();
+
+    /**
+     * @brief Waits for in-flight requests, then stops every shard
+     */
+    void stop();
+
+    /**
+     * @brief Gets the shard that owns a location
+     */
+    int getShardForLocation(int nodeId) const;
+
+    /**
+     * @brief Gets the shard that owns a trip
+     */
+    int getShardOfTrip(int tripId) const;
+
+    int getShardCount() const;
+
+    /**
+     * @brief Submits a trip request to the pickup location's shard (any thread)
+     * @return Future receiving the dispatch result
+     */
+    std::future<TripRequestResult> submitTripRequest(const Rider &rider);
+
+    std::future<bool> submitCompleteTrip(int tripId);
+    std::future<bool> submitCancelTrip(int tripId);
+
+    long long getStealAttempts() const;
+    long long getSuccessfulSteals() const;
+
+    /**
+     * @brief Prints per-shard status (call while stopped)
+     */
+    void printStatus() const;
+};
+
+#endif // SHARDEDDISPATCHENGINE_H
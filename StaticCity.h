@@ -0,0 +1,189 @@
+#ifndef STATICCITY_H
+#define STATICCITY_H
+
+#include "DistanceOracle.h"
+#include <climits>
+
+/**
+ * @struct StaticRoad
+ * @brief One two-way road of a StaticCity edge list
+ */
+struct StaticRoad
+{
+    int from;   ///< Location ID (0 .. N-1)
+    int to;     ///< Location ID (0 .. N-1)
+    int weight; ///< Road length (positive)
+};
+
+/**
+ * @class StaticCity
+ * @brief Fixed-size city whose all-pairs distances are computed at compile time
+ *
+ * Built from a constexpr edge list and zone list for locations 0 .. N-1.
+ * The constructor runs Floyd-Warshall, so a constexpr StaticCity carries its
+ * whole distance table, connectivity and zone lower bounds in read-only data
+ * and every query is a table lookup. Roads that name a missing location or
+ * have a non-positive weight are ignored.
+ *
+ * Implements DistanceOracle, so a DispatchEngine can dispatch on it directly.
+ * Meant for unit-sized graphs: the table holds N * N distances.
+ *
+ * @tparam N Number of locations
+ * @tparam E Number of roads
+ */
+template <int N, int E>
+class StaticCity : public DistanceOracle
+{
+    static_assert(N > 0, "StaticCity needs at least one location");
+
+private:
+    static constexpr int UNREACHABLE = INT_MAX / 2; ///< Sum of two never overflows
+
+    int distances[N][N] = {};          ///< Shortest distance, -1 if unreachable
+    int zones[N] = {};                 ///< Zone of each location, -1 if none
+    int zoneBounds[N + 1][N + 1] = {}; ///< Lower bound per pair of zone IDs 0 .. N
+
+public:
+    /**
+     * @brief Builds the distance table and zone bounds
+     * @param roads Two-way roads
+     * @param zoneIds Zone of each location (-1 = none)
+     */
+    constexpr StaticCity(const StaticRoad (&roads)[E], const int (&zoneIds)[N])
+    {
+        for (int i = 0; i < N; i++)
+        {
+            zones[i] = zoneIds[i];
+            for (int j = 0; j < N; j++)
+            {
+                distances[i][j] = i == j ? 0 : UNREACHABLE;
+            }
+        }
+
+        for (int e = 0; e < E; e++)
+        {
+            const StaticRoad &road = roads[e];
+            if (road.from < 0 || road.from >= N || road.to < 0 || road.to >= N || road.weight <= 0)
+                continue;
+            if (road.weight < distances[road.from][road.to])
+            {
+                distances[road.from][road.to] = road.weight;
+                distances[road.to][road.from] = road.weight;
+            }
+        }
+
+        // Floyd-Warshall
+        for (int k = 0; k < N; k++)
+        {
+            for (int i = 0; i < N; i++)
+            {
+                for (int j = 0; j < N; j++)
+                {
+                    int through = distances[i][k] + distances[k][j];
+                    if (through < distances[i][j])
+                        distances[i][j] = through;
+                }
+            }
+        }
+
+        for (int i = 0; i < N; i++)
+        {
+            for (int j = 0; j < N; j++)
+            {
+                if (distances[i][j] >= UNREACHABLE)
+                    distances[i][j] = -1;
+            }
+        }
+
+        buildZoneBounds();
+    }
+
+    // ===== Compile-Time Queries =====
+
+    /**
+     * @brief Shortest distance, usable in constant expressions
+     * @return Distance, or -1 if unreachable or either location doesn't exist
+     */
+    constexpr int distanceAt(int from, int to) const
+    {
+        if (!contains(from) || !contains(to))
+            return -1;
+        return distances[from][to];
+    }
+
+    /**
+     * @brief Zone of a location, usable in constant expressions
+     */
+    constexpr int zoneAt(int nodeId) const
+    {
+        return contains(nodeId) ? zones[nodeId] : -1;
+    }
+
+    /**
+     * @brief Zone lower bound, usable in constant expressions
+     * @return Minimum distance between the zones (0 if untracked), INT_MAX if unreachable
+     */
+    constexpr int zoneLowerBoundAt(int zoneA, int zoneB) const
+    {
+        if (zoneA < 0 || zoneA > N || zoneB < 0 || zoneB > N)
+            return 0; // Unassigned or not tracked
+        return zoneBounds[zoneA][zoneB];
+    }
+
+    /**
+     * @brief Checks whether a location ID exists
+     */
+    constexpr bool contains(int nodeId) const
+    {
+        return nodeId >= 0 && nodeId < N;
+    }
+
+    // ===== DistanceOracle =====
+
+    int getNodeCount() const override { return N; }
+    int getShortestDistance(int from, int to) const override { return distanceAt(from, to); }
+    int getZone(int nodeId) const override { return zoneAt(nodeId); }
+    bool areConnected(int a, int b) const override { return distanceAt(a, b) != -1; }
+    int getZoneLowerBound(int zoneA, int zoneB) const override { return zoneLowerBoundAt(zoneA, zoneB); }
+
+private:
+    /**
+     * @brief Fills zoneBounds with the minimum distance between any locations of two zones
+     *
+     * Only zone IDs 0 .. N are tracked; a pair involving an empty zone gets 0.
+     */
+    constexpr void buildZoneBounds()
+    {
+        bool used[N + 1] = {};
+        for (int i = 0; i < N; i++)
+        {
+            if (zones[i] >= 0 && zones[i] <= N)
+                used[zones[i]] = true;
+        }
+
+        for (int a = 0; a <= N; a++)
+        {
+            for (int b = 0; b <= N; b++)
+            {
+                zoneBounds[a][b] = (a == b || !used[a] || !used[b]) ? 0 : INT_MAX;
+            }
+        }
+
+        for (int i = 0; i < N; i++)
+        {
+            int zoneA = zones[i];
+            if (zoneA < 0 || zoneA > N)
+                continue;
+            for (int j = 0; j < N; j++)
+            {
+                int zoneB = zones[j];
+                if (zoneB < 0 || zoneB > N || distances[i][j] == -1)
+                    continue;
+                if (distances[i][j] < zoneBounds[zoneA][zoneB])
+                    zoneBounds[zoneA][zoneB] = distances[i][j];
+            }
+        }
+    }
+};
+
+#endif // STATICCITY_H
@@ -0,0 +1,112 @@
+#ifndef TRAVELTIMEPROFILES_H
+#define TRAVELTIMEPROFILES_H
+
+/**
+ * @class TravelTimeProfiles
+ * @brief Shared store of piecewise-linear, daily-periodic travel-time profiles
+ *
+ * A profile maps the time of day (minutes, 0 .. PERIOD - 1) to a travel-time
+ * factor in per-mille of a road's free-flow time (1000 = free flow, 2500 =
+ * two and a half times slower). Between breakpoints the factor is linearly
+ * interpolated, and it wraps from the last breakpoint to the first one of the
+ * next day. Because factors are relative, one profile serves every road with
+ * the same traffic pattern; roads only store a profile ID.
+ *
+ * All breakpoints live in two flat 16-bit arrays indexed through a per-profile
+ * offset table. Adding a profile identical to an existing one returns the
+ * existing ID.
+ */
+class TravelTimeProfiles
+{
+private:
+    int profileCount;    ///< Number of distinct profiles
+    int profileCapacity; ///< Capacity of the per-profile arrays
+    int *pointOffsets;   ///< First breakpoint of each profile (profileCount + 1 entries)
+    unsigned int *hashes; ///< Content hash of each profile, for deduplication
+    int *steepestDrops;  ///< Per profile: largest factor decrease per minute (per-mille, rounded up)
+
+    unsigned short *pointTimes;   ///< Breakpoint minute of day
+    unsigned short *pointFactors; ///< Breakpoint factor in per-mille
+    int pointCount;               ///< Breakpoints stored
+    int pointCapacity;            ///< Capacity of the breakpoint arrays
+
+    TravelTimeProfiles(const TravelTimeProfiles &) = delete;
+    TravelTimeProfiles &operator=(const TravelTimeProfiles &) = delete;
+
+    /**
+     * @brief Hashes a breakpoint list
+     */
+    static unsigned int hashPoints(const int *times, const int *factors, int count);
+
+    /**
+     * @brief Checks if a stored profile equals a breakpoint list
+     */
+    bool samePoints(int profileId, const int *times, const int *factors, int count) const;
+
+public:
+    static const int PERIOD = 1440;         ///< Minutes per day
+    static const int FREE_FLOW_FACTOR = 1000; ///< Factor of an unaffected road
+
+    /**
+     * @brief Creates an empty store
+     */
+    TravelTimeProfiles();
+
+    /**
+     * @brief Destructor
+     */
+    ~TravelTimeProfiles();
+
+    /**
+     * @brief Adds a profile, or finds an identical existing one
+     * @param times Breakpoint minutes of day, strictly increasing, in [0, PERIOD)
+     * @param factors Per-mille factor at each breakpoint (1 .. 65535)
+     * @param count Number of breakpoints (>= 1)
+     * @return Profile ID, or -1 if the breakpoints are invalid
+     */
+    int addProfile(const int *times, const int *factors, int count);
+
+    /**
+     * @brief Gets the number of distinct profiles
+     */
+    int getProfileCount() const;
+
+    /**
+     * @brief Gets the interpolated factor of a profile
+     * @param profileId Profile ID
+     * @param timeOfDay Any time in minutes (taken modulo PERIOD)
+     * @return Factor in per-mille, or FREE_FLOW_FACTOR for an unknown profile
+     */
+    int getFactor(int profileId, int timeOfDay) const;
+
+    /**
+     * @brief Gets the travel time of a road when entered at a given time
+     * @param profileId Profile ID (-1 for static roads)
+     * @param freeFlowTime Travel time without traffic
+     * @param departureTime Time the road is entered, in minutes
+     * @return Travel time (at least 1)
+     */
+    int getTravelTime(int profileId, int freeFlowTime, int departureTime) const;
+
+    /**
+     * @brief Checks the FIFO property for a road of a given length
+     *
+     * Time-dependent Dijkstra is exact only if entering a road later never
+     * means leaving it earlier, i.e. travel time never falls faster than one
+     * minute per minute.
+     * @return true if the profile is FIFO for this free-flow time
+     */
+    bool isFifo(int profileId, int freeFlowTime) const;
+
+    /**
+     * @brief Gets the number of bytes used by the store
+     */
+    long long getMemoryBytes() const;
+
+    /**
+     * @brief Prints every profile's breakpoints
+     */
+    void print() const;
+};
+
+#endif // TRAVELTIMEPROFILES_H
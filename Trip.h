@@ -1,6 +1,8 @@
 #ifndef TRIP_H
 #define TRIP_H
 
+#include "TripRecord.h"
+
 /**
  * @enum TripState
  * @brief Represents the various states in a trip's lifecycle
@@ -13,34 +15,68 @@ enum TripState {
     CANCELLED      ///< Trip was cancelled
 };
 
+const int TRIP_STATE_COUNT = 5; ///< Number of TripState values
+
 /**
  * @class Trip
  * @brief Represents a trip in the ride-sharing system with state machine
  * 
  * Manages the complete lifecycle of a trip from request to completion/cancellation.
  * Enforces valid state transitions.
+ *
+ * All fields live in one packed TripRecord. The state and driver ID in it
+ * are read and written with atomic operations and every transition is a
+ * single compare-and-swap checked against TRANSITIONS, so concurrent start,
+ * complete and cancel calls on the same trip never need a lock: exactly one
+ * of the conflicting calls succeeds and the others fail cleanly.
  */
 class Trip {
 private:
-    int id;                 ///< Unique trip ID
-    int riderId;            ///< ID of the rider requesting the trip
-    int driverId;           ///< ID of the driver assigned to the trip
-    int pickupLocation;     ///< Node ID for pickup
-    int dropoffLocation;    ///< Node ID for dropoff
-    int distance;           ///< Total distance of the trip
-    TripState state;        ///< Current state of the trip
-    float fare;             ///< Calculated fare for the trip
+    TripRecord record; ///< Every field of the trip
     
+    /**
+     * @brief Valid transitions, indexed [from][to]
+     */
+    static constexpr bool TRANSITIONS[TRIP_STATE_COUNT][TRIP_STATE_COUNT] = {
+        //            REQ    ASSIGN ONGOING COMPL  CANCEL
+        /* REQ     */ {false, true,  false,  false, true},
+        /* ASSIGN  */ {false, false, true,   false, true},
+        /* ONGOING */ {false, false, false,  true,  true},
+        /* COMPL   */ {false, false, false,  false, false},
+        /* CANCEL  */ {false, false, false,  false, false}};
+
+    Trip(const Trip &) = delete;
+    Trip &operator=(const Trip &) = delete;
+
     /**
      * @brief Validates a state transition
-     * @param newState The desired new state
+     * @param from Current state
+     * @param to The desired new state
      * @return true if transition is valid, false otherwise
      */
-    bool isValidTransition(TripState newState) const;
+    static constexpr bool isValidTransition(TripState from, TripState to)
+    {
+        return from >= 0 && from < TRIP_STATE_COUNT && to >= 0 && to < TRIP_STATE_COUNT &&
+               TRANSITIONS[from][to];
+    }
+
+    /**
+     * @brief Atomically moves from one specific state to another
+     * @param expected State the trip must currently be in
+     * @param newState The desired new state
+     * @param observed Receives the state seen if the swap fails
+     * @return true if this call performed the transition
+     */
+    bool transitionFrom(TripState expected, TripState newState, TripState &observed);
+
+    /**
+     * @brief Logs a successful transition and its side notes
+     */
+    void reportTransition(TripState oldState, TripState newState) const;
     
     /**
      * @brief Calculates the fare based on distance
-     * Uses a simple formula: base fare + (distance * rate per km)
+     * Uses a simple formula: base fare + (distance * rate per km) + tolls
      */
     void calculateFare();
     
@@ -63,6 +99,12 @@ public:
      * @param dist Total distance of the trip
      */
     Trip(int tripId, int rider, int pickup, int dropoff, int dist);
+
+    /**
+     * @brief Rebuilds a trip from a saved record, without validation or logging
+     * @param saved Record from getRecord(), possibly read back from disk
+     */
+    explicit Trip(const TripRecord &saved);
     
     /**
      * @brief Destructor
@@ -123,18 +165,79 @@ public:
      */
     TripState getState() const;
     
+    /**
+     * @brief Gets the estimated pickup-to-dropoff travel time
+     * @return ETA in minutes, or -1 if not estimated
+     */
+    int getEta() const;
+
+    /**
+     * @brief Sets the estimated pickup-to-dropoff travel time
+     * @param minutes ETA in minutes (-1 if unknown)
+     */
+    void setEta(int minutes);
+
+    /**
+     * @brief Gets the driver-to-pickup travel cost measured at assignment
+     * @return Cost, or -1 if unknown
+     */
+    int getPickupDistance() const;
+
+    /**
+     * @brief Sets the driver-to-pickup travel cost
+     */
+    void setPickupDistance(int cost);
+
+    /**
+     * @brief Gets the tolls along the chosen route
+     */
+    int getToll() const;
+
+    /**
+     * @brief Sets the tolls along the chosen route and recalculates fare
+     * @param amount Toll total (0 to TripRecord::MAX_TOLL)
+     */
+    void setToll(int amount);
+
+    /**
+     * @brief Gets the dispatch priority used while the trip waits for a driver
+     */
+    int getPriority() const;
+
+    /**
+     * @brief Sets the dispatch priority
+     * @param level Priority (0 to TripRecord::MAX_PRIORITY, higher is matched first)
+     */
+    void setPriority(int level);
+
     /**
      * @brief Gets the calculated fare
      * @return Fare amount
      */
     float getFare() const;
+
+    /**
+     * @brief Copies the trip's record, reading state and driver atomically
+     */
+    TripRecord getRecord() const;
     
     /**
-     * @brief Attempts to transition to a new state
+     * @brief Attempts to transition to a new state from whatever state the trip is in
+     *
+     * Retries the compare-and-swap while other threads move the trip through
+     * states from which newState is still valid.
      * @param newState The desired new state
      * @return true if transition successful, false if invalid
      */
     bool transitionTo(TripState newState);
+
+    /**
+     * @brief Restores state and driver from a saved engine image
+     *
+     * Bypasses transition checks; only for rebuilding a trip that already
+     * went through its transitions before being saved.
+     */
+    void restore(TripState savedState, int savedDriverId);
     
     /**
      * @brief Assigns a driver to the trip
@@ -0,0 +1,117 @@
+#ifndef TRIPANALYTICS_H
+#define TRIPANALYTICS_H
+
+#include "TripHistory.h"
+
+/**
+ * @struct TripFilter
+ * @brief Row predicate for analytics queries (every condition must hold)
+ */
+struct TripFilter
+{
+    int zone;     ///< Pickup zone, or -1 for any
+    int state;    ///< Final TripState, or -1 for any
+    int fromTime; ///< First finish time included (minutes)
+    int toTime;   ///< First finish time excluded (minutes)
+
+    /**
+     * @brief Creates a filter that matches every row
+     */
+    TripFilter();
+};
+
+/**
+ * @class TripAnalytics
+ * @brief Filter, group-by-zone and aggregate queries over a TripHistory
+ *
+ * Every query is one sequential pass over the few columns it needs. The
+ * filter is evaluated as a 0/1 mask and folded into the aggregate with
+ * arithmetic instead of a branch, so the compiler can vectorize the inner
+ * loops. With more than one thread the rows are split into contiguous
+ * chunks, each thread aggregates its chunk into a private table and the
+ * tables are merged at the end; no locks or atomics are touched per row.
+ *
+ * The history must not be appended to while a query runs.
+ */
+class TripAnalytics
+{
+private:
+    const TripHistory &history;
+    int threadCount; ///< Worker threads per query (at least 1)
+
+    TripAnalytics(const TripAnalytics &) = delete;
+    TripAnalytics &operator=(const TripAnalytics &) = delete;
+
+    /**
+     * @brief Runs work(chunk, begin, end) over getChunkCount() row ranges in parallel
+     */
+    template <class Work>
+    void forEachChunk(Work work) const;
+
+    /**
+     * @brief Number of row ranges a query is split into
+     */
+    int getChunkCount() const;
+
+public:
+    static const int HOURS_PER_DAY = 24;
+
+    /**
+     * @brief Creates a query interface over a history
+     * @param threadCount Worker threads per query (0 for one per hardware thread)
+     */
+    TripAnalytics(const TripHistory &history, int threadCount = 1);
+
+    void setThreadCount(int count);
+    int getThreadCount() const;
+
+    /**
+     * @brief Counts the rows matching a filter
+     */
+    long long count(const TripFilter &filter) const;
+
+    /**
+     * @brief Sums the fares of completed rows matching a filter
+     */
+    double totalRevenue(const TripFilter &filter) const;
+
+    /**
+     * @brief Sums completed fares by pickup zone and hour of day
+     * @param out zoneCount * HOURS_PER_DAY entries, indexed zone * HOURS_PER_DAY + hour
+     *
+     * The hour is taken from the finish time. Rows with a zone outside
+     * [0, zoneCount) are left out.
+     */
+    void revenueByZoneHour(const TripFilter &filter, double *out, int zoneCount) const;
+
+    /**
+     * @brief Counts matching rows by pickup zone
+     * @param out zoneCount entries
+     */
+    void countByZone(const TripFilter &filter, long long *out, int zoneCount) const;
+
+    /**
+     * @brief Nearest-rank percentiles of the driver-to-pickup distance
+     * @param fractions Percentiles wanted, each in [0, 1] (0.5 for p50)
+     * @param out Receives one distance per fraction
+     * @return Number of rows the percentiles were taken over (rows never
+     *         assigned a driver are skipped); out is untouched when 0
+     */
+    long long pickupDistancePercentiles(const TripFilter &filter, const double *fractions,
+                                        int fractionCount, int *out) const;
+
+    /**
+     * @brief Cancellation rate split by the state a trip was cancelled from
+     * @param rates TRIP_STATE_COUNT entries; rates[s] is the share of matching
+     *              rows that were cancelled while in state s
+     * @return Number of matching rows
+     */
+    long long cancellationRateByState(const TripFilter &filter, double *rates) const;
+
+    /**
+     * @brief Prints revenue, pickup distance and cancellation figures
+     */
+    void printReport(const TripFilter &filter) const;
+};
+
+#endif // TRIPANALYTICS_H
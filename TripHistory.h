@@ -0,0 +1,103 @@
+#ifndef TRIPHISTORY_H
+#define TRIPHISTORY_H
+
+#include "Trip.h"
+
+/**
+ * @class TripHistory
+ * @brief Append-only columnar store of completed and cancelled trips
+ *
+ * Each attribute is its own contiguous array indexed by row, so a report
+ * that needs two columns reads only those two, sequentially. Rows are never
+ * changed or removed once appended. Columns grow by doubling.
+ */
+class TripHistory
+{
+private:
+    int count;    ///< Rows stored
+    int capacity; ///< Capacity of every column
+
+    int *ids;          ///< Trip ID
+    int *riders;       ///< Rider ID
+    int *drivers;      ///< Driver ID (-1 if never assigned)
+    int *pickups;      ///< Pickup location
+    int *dropoffs;     ///< Dropoff location
+    int *distances;    ///< Trip distance
+    float *fares;      ///< Fare charged (completed) or quoted (cancelled)
+    unsigned char *states; ///< Final state (COMPLETED or CANCELLED)
+    unsigned char *priorStates; ///< State the trip left for its final state
+    int *pickupDistances; ///< Driver-to-pickup travel cost (-1 if never assigned)
+    int *pickupZones;  ///< Zone of the pickup location (-1 if unassigned)
+    int *finishTimes;  ///< Dispatch clock (minutes) when the trip finished
+
+    TripHistory(const TripHistory &) = delete;
+    TripHistory &operator=(const TripHistory &) = delete;
+
+    /**
+     * @brief Doubles the capacity of every column
+     */
+    void grow();
+
+public:
+    /**
+     * @brief Creates an empty history
+     */
+    TripHistory();
+
+    /**
+     * @brief Destructor
+     */
+    ~TripHistory();
+
+    /**
+     * @brief Appends a finished trip
+     * @param trip Trip in a final state
+     * @param priorState State the trip was in before its final transition
+     * @param pickupZone Zone of the pickup location
+     * @param finishTime Dispatch clock when the trip finished
+     * @return Row index
+     */
+    int append(const Trip &trip, TripState priorState, int pickupZone, int finishTime);
+
+    /**
+     * @brief Appends a row from raw values (used when restoring a snapshot)
+     * @return Row index
+     */
+    int appendRow(int id, int rider, int driver, int pickup, int dropoff, int distance,
+                  float fare, TripState state, TripState priorState, int pickupDistance,
+                  int pickupZone, int finishTime);
+
+    int getCount() const;
+
+    /**
+     * @brief Finds the row of a trip
+     * @return Row index, or -1 if not in the history
+     */
+    int findRow(int tripId) const;
+
+    // ===== Column access (getCount() entries each) =====
+    const int *getIds() const;
+    const int *getRiders() const;
+    const int *getDrivers() const;
+    const int *getPickups() const;
+    const int *getDropoffs() const;
+    const int *getDistances() const;
+    const float *getFares() const;
+    const unsigned char *getStates() const;
+    const unsigned char *getPriorStates() const;
+    const int *getPickupDistances() const;
+    const int *getPickupZones() const;
+    const int *getFinishTimes() const;
+
+    /**
+     * @brief Gets the number of bytes held by the columns
+     */
+    long long getMemoryBytes() const;
+
+    /**
+     * @brief Prints totals by final state
+     */
+    void printSummary() const;
+};
+
+#endif // TRIPHISTORY_H
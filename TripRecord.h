@@ -0,0 +1,57 @@
+#ifndef TRIPRECORD_H
+#define TRIPRECORD_H
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @struct TripRecord
+ * @brief Packed, trivially copyable storage of one trip
+ *
+ * The fields Trip is made of, with the state in one byte and the fare as
+ * fixed-point hundredths, laid out without padding. A table of records can
+ * be copied, written or read back with a single memcpy/fwrite/fread.
+ * Trip wraps one record and adds the state machine and logging.
+ */
+struct TripRecord
+{
+    int32_t id;              ///< Unique trip ID
+    int32_t riderId;         ///< Requesting rider
+    int32_t driverId;        ///< Assigned driver (-1 if none)
+    int32_t pickupLocation;  ///< Pickup node
+    int32_t dropoffLocation; ///< Dropoff node
+    int32_t distance;        ///< Trip distance
+    int32_t fareCents;       ///< Fare in hundredths of a currency unit
+    int32_t eta;             ///< Pickup-to-dropoff travel time (-1 if unknown)
+    int32_t pickupDistance;  ///< Driver-to-pickup travel cost (-1 if unknown)
+    uint16_t toll;           ///< Tolls along the route, in whole currency units
+    uint8_t state;           ///< TripState
+    uint8_t priority;        ///< Dispatch priority of a pending trip (higher is matched first)
+
+    static const int FARE_SCALE = 100; ///< fareCents per currency unit
+    static const int MAX_TOLL = 65535;
+    static const int MAX_PRIORITY = 255;
+
+    /**
+     * @brief Converts a currency amount to fixed-point hundredths (rounded)
+     */
+    static int32_t toFixedFare(float amount)
+    {
+        float scaled = amount * FARE_SCALE;
+        return (int32_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+    }
+
+    /**
+     * @brief Fare as a currency amount
+     */
+    float getFare() const
+    {
+        return (float)fareCents / FARE_SCALE;
+    }
+};
+
+static_assert(std::is_trivially_copyable<TripRecord>::value,
+              "TripRecord must stay memcpy-able");
+static_assert(sizeof(TripRecord) == 40, "TripRecord must stay packed");
+
+#endif // TRIPRECORD_H
@@ -0,0 +1,199 @@
+#ifndef VERSIONEDCITY_H
+#define VERSIONEDCITY_H
+
+#include "CompactGraph.h"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @class CitySnapshot
+ * @brief Immutable view of a City at one version, safe to read from any thread
+ *
+ * Holds everything dispatch reads: the compact road graph, zones, connected
+ * component labels and zone-to-zone lower bounds. Offers the same query
+ * methods as City, so dispatch code can run against either.
+ */
+class CitySnapshot
+{
+private:
+    long long version;    ///< Version number assigned at publish
+    CompactGraph graph;   ///< Roads and zones
+    int *componentLabels; ///< Connected component label per location
+    int zoneCount;        ///< Zone IDs covered by zoneBounds (0 .. zoneCount - 1)
+    int *zoneBounds;      ///< zoneCount x zoneCount lower bounds
+
+    CitySnapshot(const CitySnapshot &) = delete;
+    CitySnapshot &operator=(const CitySnapshot &) = delete;
+
+public:
+    /**
+     * @brief Captures the current state of a city
+     * @param city Source city (zone bounds must be up to date)
+     * @param snapshotVersion Version number of this snapshot
+     */
+    CitySnapshot(const City &city, long long snapshotVersion);
+
+    /**
+     * @brief Destructor
+     */
+    ~CitySnapshot();
+
+    long long getVersion() const;
+    int getNodeCount() const;
+    const CompactGraph &getGraph() const;
+
+    /**
+     * @brief Gets the zone of a location
+     * @return Zone ID, or -1 if the location doesn't exist or is unassigned
+     */
+    int getZone(int nodeId) const;
+
+    /**
+     * @brief Checks in O(1) whether two locations are connected by roads
+     */
+    bool areConnected(int a, int b) const;
+
+    /**
+     * @brief Gets the shortest distance between two locations
+     * @return Shortest distance, or -1 if no path exists
+     */
+    int getShortestDistance(int source, int destination) const;
+
+    /**
+     * @brief Gets a lower bound on the distance between any locations of two zones
+     * @return Lower bound (0 if zones match or are unknown), INT_MAX if unreachable
+     */
+    int getZoneLowerBound(int zoneA, int zoneB) const;
+};
+
+/**
+ * @class VersionedCity
+ * @brief City whose readers see immutable snapshots published through an atomic pointer
+ *
+ * Updater threads edit a private master City; nothing they do is visible to
+ * readers until publish() builds a new CitySnapshot and swaps it in with one
+ * atomic exchange. Readers take a SnapshotReader, which costs one slot claim
+ * and one pointer load and never blocks on writers.
+ *
+ * Old snapshots are reclaimed with epochs: a reader records the global epoch
+ * in its slot before loading the pointer, and publish() tags the replaced
+ * snapshot with the epoch current at the swap before advancing it. A retired
+ * snapshot is freed once no active reader slot holds an epoch at or below
+ * its tag, because only such readers can still hold it.
+ */
+class VersionedCity
+{
+private:
+    friend class SnapshotReader;
+
+    static const int MAX_READERS = 64; ///< Concurrent reader slots
+    static const long long IDLE_SLOT;  ///< Slot value when no reader holds it
+
+    City master;                             ///< Writer-side city (guarded by writerMutex)
+    std::mutex writerMutex;                  ///< Serializes updaters and publish
+    std::atomic<const CitySnapshot *> current; ///< Latest published snapshot
+    std::atomic<long long> globalEpoch;      ///< Advanced on every publish
+    std::atomic<long long> readerEpochs[MAX_READERS]; ///< Epoch per reader slot
+    long long nextVersion;                   ///< Version given to the next snapshot
+    bool dirty;                              ///< Master changed since the last publish
+
+    const CitySnapshot **retired;  ///< Replaced snapshots awaiting reclamation
+    long long *retiredEpochs;      ///< Epoch at which each was replaced
+    int retiredCount;              ///< Number of retired snapshots
+    int retiredCapacity;           ///< Capacity of the retired arrays
+
+    VersionedCity(const VersionedCity &) = delete;
+    VersionedCity &operator=(const VersionedCity &) = delete;
+
+    /**
+     * @brief Frees retired snapshots no reader can still see (writerMutex held)
+     * @return Number of snapshots freed
+     */
+    int reclaimLocked();
+
+public:
+    /**
+     * @brief Creates an empty city and publishes version 0
+     */
+    VersionedCity();
+
+    /**
+     * @brief Destructor (no reader may be active)
+     */
+    ~VersionedCity();
+
+    // ===== Updates (any thread; visible after publish) =====
+    bool addLocation(int id);
+    bool addRoad(int from, int to, int distance);
+    bool setZone(int nodeId, int zoneId);
+    bool setRoadWeight(int from, int to, int distance);
+    bool removeRoad(int from, int to);
+
+    /**
+     * @brief Applies a batch of traffic updates (see City::applyRoadUpdates)
+     * @return Number of updates applied
+     */
+    int applyRoadUpdates(const City::RoadUpdate *updates, int count);
+
+    /**
+     * @brief Publishes the current master state as a new snapshot
+     *
+     * Builds the snapshot on the calling thread; readers only see the final
+     * pointer swap. Does nothing if no edit was made since the last publish.
+     * @return Version now current
+     */
+    long long publish();
+
+    /**
+     * @brief Frees retired snapshots no reader can still see
+     * @return Number of snapshots freed
+     */
+    int reclaim();
+
+    /**
+     * @brief Gets the version of the current snapshot
+     */
+    long long getVersion() const;
+
+    /**
+     * @brief Gets the number of retired snapshots not yet freed
+     */
+    int getRetiredCount();
+
+    void printStatus();
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Scoped read access to the current snapshot of a VersionedCity
+ *
+ * The snapshot stays valid until the reader is destroyed, even if newer
+ * versions are published meanwhile. Keep readers short-lived so old
+ * snapshots can be reclaimed.
+ */
+class SnapshotReader
+{
+private:
+    VersionedCity &owner;         ///< City being read
+    int slot;                     ///< Reader slot claimed
+    const CitySnapshot *snapshot; ///< Snapshot pinned by this reader
+
+    SnapshotReader(const SnapshotReader &) = delete;
+    SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+public:
+    /**
+     * @brief Pins the current snapshot
+     */
+    SnapshotReader(VersionedCity &city);
+
+    /**
+     * @brief Releases the snapshot
+     */
+    ~SnapshotReader();
+
+    const CitySnapshot &get() const;
+    const CitySnapshot *operator->() const;
+};
+
+#endif // VERSIONEDCITY_H
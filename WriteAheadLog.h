@@ -0,0 +1,222 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+/**
+ * @enum WalRecordType
+ * @brief Lifecycle events recorded in the write-ahead log
+ */
+enum WalRecordType
+{
+    WAL_DRIVER_REGISTERED = 1, ///< driverId, location, zone, status
+    WAL_DRIVER_REMOVED,        ///< driverId
+    WAL_DRIVER_STATUS,         ///< driverId, status
+    WAL_DRIVER_LOCATION,       ///< driverId, location, zone
+    WAL_TRIP_CREATED,          ///< tripId, riderId, pickup, dropoff, distance
+    WAL_TRIP_ASSIGNED,         ///< tripId, driverId, pickupDistance
+    WAL_TRIP_STARTED,          ///< tripId
+    WAL_TRIP_COMPLETED,        ///< tripId
+    WAL_TRIP_CANCELLED,        ///< tripId
+    WAL_DRIVER_RATING,         ///< driverId, rating
+    WAL_TRIP_PRIORITY,         ///< tripId, priority
+    WAL_CLOCK,                 ///< minuteOfDay
+    WAL_TRIP_ETA,              ///< tripId, eta
+    WAL_TRIP_TOLL              ///< tripId, toll
+};
+
+/**
+ * @enum WalSyncPolicy
+ * @brief When committed log bytes are forced to stable storage
+ */
+enum WalSyncPolicy
+{
+    WAL_SYNC_ALWAYS, ///< Commit and fsync on every record
+    WAL_SYNC_GROUP,  ///< Commit a group of records with one fsync
+    WAL_SYNC_NONE    ///< Commit groups to the OS without fsync (survives process crashes only)
+};
+
+/**
+ * @struct WalRecord
+ * @brief One decoded log record
+ */
+struct WalRecord
+{
+    static const int FIELD_COUNT = 5;
+
+    WalRecordType type;       ///< Event type
+    long long lsn;            ///< Log sequence number (1, 2, 3, ...)
+    int fields[FIELD_COUNT];  ///< Event arguments, see WalRecordType
+};
+
+/**
+ * @class WriteAheadLog
+ * @brief Append-only binary log of dispatch events with group commit
+ *
+ * Every record is RECORD_SIZE bytes: type, LSN, five 32-bit fields and an
+ * FNV-1a checksum, all little-endian. append() only encodes into an
+ * in-memory buffer; commit() writes the whole buffer with one write and,
+ * depending on the policy, one fsync, so concurrent appenders share the cost.
+ * A group is committed when it reaches groupSize records, when a background
+ * flusher wakes after flushIntervalMs, or when a caller waits for durability.
+ *
+ * Opening an existing log continues after its last valid record and cuts off
+ * a torn tail left by a crash. A group that fails to write or sync is cut
+ * off the file the same way and stays pending, so the next commit retries it
+ * and no later record lands behind a torn one.
+ */
+class WriteAheadLog
+{
+private:
+    FILE *file;              ///< Log file opened for appending
+    WalSyncPolicy policy;    ///< fsync policy
+    int groupSize;           ///< Records per group before an inline commit
+
+    std::mutex bufferMutex;  ///< Guards the append buffer and counters
+    std::mutex commitMutex;  ///< Serializes commits so file order matches LSN order
+    std::condition_variable flusherWake; ///< Wakes the background flusher early
+    unsigned char *buffer;   ///< Encoded records not yet committed
+    int bufferBytes;         ///< Bytes used in buffer
+    int bufferCapacity;      ///< Capacity of buffer
+    unsigned char *commitBuffer; ///< Buffer being written by the current commit
+    int commitCapacity;      ///< Capacity of commitBuffer
+    int pendingRecords;      ///< Records in buffer
+    long long lastLsn;       ///< LSN of the last appended record
+    long long durableLsn;    ///< LSN of the last committed record
+    long long fileBytes;     ///< Size of the file's committed prefix
+    long long commitCount;   ///< Group commits performed
+    long long syncCount;     ///< fsync calls performed
+
+    std::thread flusher;     ///< Commits pending records every flushIntervalMs
+    int flushIntervalMs;     ///< Flusher period (0 = no flusher)
+    bool stopping;           ///< Tells the flusher to exit
+
+    WriteAheadLog(const WriteAheadLog &) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+    /**
+     * @brief Body of the background flusher thread
+     */
+    void flusherLoop();
+
+    /**
+     * @brief Puts a group that failed to commit back in front of the pending records
+     * @param bytes Size of the group at the start of commitBuffer
+     */
+    void requeueGroup(int bytes);
+
+public:
+    static const int RECORD_SIZE = 36; ///< Encoded bytes per record
+
+    /**
+     * @brief Opens or creates a log
+     * @param path Log file path
+     * @param syncPolicy When to fsync
+     * @param recordsPerGroup Records buffered before an inline commit (WAL_SYNC_ALWAYS uses 1)
+     * @param flushInterval Background flusher period in ms (0 disables it)
+     */
+    WriteAheadLog(const char *path, WalSyncPolicy syncPolicy = WAL_SYNC_GROUP,
+                  int recordsPerGroup = 64, int flushInterval = 5);
+
+    /**
+     * @brief Commits pending records and closes the log
+     */
+    ~WriteAheadLog();
+
+    bool isOpen() const;
+
+    /**
+     * @brief Appends a record
+     * @return LSN of the record, or -1 if the log is not open
+     */
+    long long append(WalRecordType type, int f0 = 0, int f1 = 0, int f2 = 0, int f3 = 0, int f4 = 0);
+
+    /**
+     * @brief Writes every pending record and syncs according to the policy
+     *
+     * On a failed write or sync the file is truncated back to its committed
+     * prefix and the records stay pending.
+     * @return LSN up to which records are committed
+     */
+    long long commit();
+
+    /**
+     * @brief Blocks until a record is committed, committing now if needed
+     * @return false if the commit failed and the record is not durable
+     */
+    bool waitDurable(long long lsn);
+
+    /**
+     * @brief Numbers later records after lsn if the log is behind it
+     *
+     * A snapshot covers every record up to its LSN, so a log reopened behind
+     * it (its tail never reached disk) must not reuse those numbers, or
+     * recovery would skip the new records as already applied.
+     */
+    void continueAfter(long long lsn);
+
+    long long getLastLsn();
+    long long getDurableLsn();
+    long long getCommitCount();
+    long long getSyncCount();
+
+    /**
+     * @brief Encodes a record into RECORD_SIZE bytes
+     */
+    static void encode(const WalRecord &record, unsigned char *out);
+
+    /**
+     * @brief Decodes RECORD_SIZE bytes
+     * @return true if the checksum and type are valid
+     */
+    static bool decode(const unsigned char *in, WalRecord &record);
+};
+
+/**
+ * @class WalReader
+ * @brief Sequential reader over a log file, stopping at the first invalid record
+ */
+class WalReader
+{
+private:
+    FILE *file;          ///< Log file opened for reading
+    long long validBytes; ///< Bytes of valid records read so far
+    bool tornTail;       ///< A partial or corrupt record follows the valid prefix
+
+    WalReader(const WalReader &) = delete;
+    WalReader &operator=(const WalReader &) = delete;
+
+public:
+    /**
+     * @brief Opens a log for reading
+     */
+    WalReader(const char *path);
+
+    /**
+     * @brief Closes the file
+     */
+    ~WalReader();
+
+    bool isOpen() const;
+
+    /**
+     * @brief Reads the next record
+     * @return true if a valid record was read, false at the end or a torn tail
+     */
+    bool next(WalRecord &record);
+
+    /**
+     * @brief Gets the size of the valid prefix read so far
+     */
+    long long getValidBytes() const;
+
+    /**
+     * @brief Checks if reading stopped at a partial or corrupt record
+     */
+    bool hasTornTail() const;
+};
+
+#endif // WRITEAHEADLOG_H
@@ -0,0 +1,115 @@
+#ifndef ZONEDISTANCEMATRIX_H
+#define ZONEDISTANCEMATRIX_H
+
+class City;
+
+/**
+ * @class ZoneDistanceMatrix
+ * @brief Zone x zone matrix of minimum distances between any two locations of two zones
+ *
+ * Entry (a, b) is the shortest distance from any location in zone a to any
+ * location in zone b, so it is a lower bound on the distance between any
+ * pair of locations in those zones. Each row is computed with one
+ * multi-source Dijkstra from all locations of the zone, and the per-location
+ * distances of every row are kept so that updates can be applied incrementally:
+ * - a new road only shortens distances, so each row is repaired by a search
+ *   seeded at the road's endpoints that only visits improved locations;
+ * - a zone change recomputes the two affected rows and mirrors them into the
+ *   columns (roads are undirected, so the matrix is symmetric);
+ * - a new location or zone ID marks the matrix stale; it is rebuilt on the next query.
+ *
+ * Zones are read for IDs 0 .. getNodeCount()-1 only. With sparse IDs (see
+ * City), a location with a larger ID is missing from its zone, and a row
+ * search that follows a road into it reads past the per-location rows.
+ */
+class ZoneDistanceMatrix
+{
+private:
+    const City *city;  ///< City the matrix describes
+    int zoneCount;     ///< Number of zone IDs covered (0 .. zoneCount - 1)
+    int nodeCount;     ///< Number of locations covered
+    int *bounds;       ///< zoneCount x zoneCount lower bounds (INT_MAX if unreachable)
+    int **rowDistances; ///< Per zone: distance from the zone to every location
+    int *zones;        ///< Zone of every location when last synchronized
+    bool stale;        ///< True if the matrix must be rebuilt before use
+
+    int *scratchNeighbors; ///< Scratch buffer for a location's neighbors
+    int *scratchDistances; ///< Scratch buffer for a location's road distances
+    int scratchCapacity;   ///< Capacity of the scratch buffers
+
+    ZoneDistanceMatrix(const ZoneDistanceMatrix &) = delete;
+    ZoneDistanceMatrix &operator=(const ZoneDistanceMatrix &) = delete;
+
+    /**
+     * @brief Frees all arrays
+     */
+    void release();
+
+    /**
+     * @brief Decodes a location's roads into the scratch buffers
+     * @return Number of roads
+     */
+    int loadRoads(int nodeId);
+
+    /**
+     * @brief Rebuilds every row from scratch
+     */
+    void rebuild();
+
+    /**
+     * @brief Recomputes one row with a multi-source Dijkstra and mirrors it into its column
+     */
+    void recomputeRow(int zone);
+
+    /**
+     * @brief Propagates a distance decrease from a seed location within one row
+     */
+    void repairRow(int zone, int seed);
+
+public:
+    /**
+     * @brief Constructor (the matrix is built lazily on first query)
+     * @param cityPtr City to describe
+     */
+    ZoneDistanceMatrix(const City *cityPtr);
+
+    /**
+     * @brief Destructor
+     */
+    ~ZoneDistanceMatrix();
+
+    /**
+     * @brief Gets the lower bound on the distance between two zones
+     * @param zoneA First zone ID
+     * @param zoneB Second zone ID
+     * @return 0 for the same or an unassigned zone, INT_MAX if unreachable
+     */
+    int getLowerBound(int zoneA, int zoneB);
+
+    /**
+     * @brief Updates the matrix after a road was added
+     */
+    void onRoadAdded(int from, int to, int distance);
+
+    /**
+     * @brief Updates the matrix after a location changed zone
+     */
+    void onZoneChanged(int nodeId, int oldZone, int newZone);
+
+    /**
+     * @brief Rebuilds the matrix now if it is stale
+     */
+    void refresh();
+
+    /**
+     * @brief Marks the matrix for a full rebuild (e.g. after a new location)
+     */
+    void invalidate();
+
+    /**
+     * @brief Prints the matrix
+     */
+    void print();
+};
+
+#endif // ZONEDISTANCEMATRIX_H
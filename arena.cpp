@@ -0,0 +1,124 @@
+#include "Arena.h"
+
+using namespace std;
+
+const int INITIAL_BLOCK_CAPACITY = 4;
+const int INITIAL_FINALIZER_CAPACITY = 16;
+
+// ==================== Arena Implementation ====================
+
+Arena::Arena(size_t blockSize)
+    : blockCount(0), blockCapacity(INITIAL_BLOCK_CAPACITY), currentBlock(-1), used(0),
+      defaultBlockSize(blockSize > 0 ? blockSize : 1), bytesAllocated(0),
+      finalizerCount(0), finalizerCapacity(INITIAL_FINALIZER_CAPACITY)
+{
+    blocks = new unsigned char *[blockCapacity];
+    blockSizes = new size_t[blockCapacity];
+    finalizers = new Finalizer[finalizerCapacity];
+}
+
+Arena::~Arena()
+{
+    reset();
+    for (int i = 0; i < blockCount; i++)
+    {
+        delete[] blocks[i];
+    }
+    delete[] blocks;
+    delete[] blockSizes;
+    delete[] finalizers;
+}
+
+void *Arena::allocate(size_t bytes, size_t alignment)
+{
+    // Try the current block, then the blocks kept from earlier batches
+    while (currentBlock >= 0 && currentBlock < blockCount)
+    {
+        size_t address = (size_t)(blocks[currentBlock] + used);
+        size_t padding = (alignment - address % alignment) % alignment;
+        if (used + padding + bytes <= blockSizes[currentBlock])
+        {
+            void *memory = blocks[currentBlock] + used + padding;
+            used += padding + bytes;
+            bytesAllocated += bytes;
+            return memory;
+        }
+        if (currentBlock + 1 >= blockCount)
+        {
+            break;
+        }
+        currentBlock++;
+        used = 0;
+    }
+
+    if (blockCount == blockCapacity)
+    {
+        int newCapacity = blockCapacity * 2;
+        unsigned char **newBlocks = new unsigned char *[newCapacity];
+        size_t *newSizes = new size_t[newCapacity];
+        for (int i = 0; i < blockCount; i++)
+        {
+            newBlocks[i] = blocks[i];
+            newSizes[i] = blockSizes[i];
+        }
+        delete[] blocks;
+        delete[] blockSizes;
+        blocks = newBlocks;
+        blockSizes = newSizes;
+        blockCapacity = newCapacity;
+    }
+
+    size_t size = bytes + alignment > defaultBlockSize ? bytes + alignment : defaultBlockSize;
+    blocks[blockCount] = new unsigned char[size];
+    blockSizes[blockCount] = size;
+    currentBlock = blockCount++;
+    used = 0;
+    return allocate(bytes, alignment);
+}
+
+void Arena::addFinalizer(void (*destroy)(void *), void *object)
+{
+    if (finalizerCount == finalizerCapacity)
+    {
+        int newCapacity = finalizerCapacity * 2;
+        Finalizer *newFinalizers = new Finalizer[newCapacity];
+        for (int i = 0; i < finalizerCount; i++)
+        {
+            newFinalizers[i] = finalizers[i];
+        }
+        delete[] finalizers;
+        finalizers = newFinalizers;
+        finalizerCapacity = newCapacity;
+    }
+    finalizers[finalizerCount].destroy = destroy;
+    finalizers[finalizerCount].object = object;
+    finalizerCount++;
+}
+
+void Arena::reset()
+{
+    // Newest first, so objects may still use older ones in their destructors
+    for (int i = finalizerCount - 1; i >= 0; i--)
+    {
+        finalizers[i].destroy(finalizers[i].object);
+    }
+    finalizerCount = 0;
+    currentBlock = blockCount > 0 ? 0 : -1;
+    used = 0;
+    bytesAllocated = 0;
+}
+
+size_t Arena::getBytesUsed() const
+{
+    return bytesAllocated;
+}
+
+size_t Arena::getBytesReserved() const
+{
+    size_t total = 0;
+    for (int i = 0; i < blockCount; i++)
+    {
+        total += blockSizes[i];
+    }
+    return total;
+}
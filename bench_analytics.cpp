@@ -0,0 +1,116 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+#include "TripHistory.h"
+#include "TripAnalytics.h"
+using namespace std;
+
+// Times the TripAnalytics queries over a synthetic trip history on one
+// thread and on every hardware thread, and checks both give the same answers.
+// Usage: bench_analytics [rows] [zones] [threads]   (e.g. 100000000 for 100M rows)
+
+void fillHistory(TripHistory &history, int rows, int zones)
+{
+    unsigned int seed = 42;
+    for (int i = 0; i < rows; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int zone = (seed >> 8) % zones;
+        seed = seed * 1103515245u + 12345u;
+        int finishTime = (seed >> 8) % (7 * 24 * 60); // One week of minutes
+        seed = seed * 1103515245u + 12345u;
+        int distance = 1 + (seed >> 8) % 40;
+        seed = seed * 1103515245u + 12345u;
+        int roll = (seed >> 8) % 100;
+
+        TripState state = COMPLETED;
+        TripState prior = ONGOING;
+        int pickupDistance = ((seed >> 20) % 16) * ((seed >> 24) % 4 + 1); // Skewed toward short
+        if (roll < 12)
+        {
+            state = CANCELLED;
+            prior = (TripState)(roll % 3); // REQUESTED, ASSIGNED or ONGOING
+            if (prior == REQUESTED)
+                pickupDistance = -1; // Never assigned
+        }
+        float fare = 50.0f + distance * 10.0f;
+        history.appendRow(i, 1000 + i % 50000, prior == REQUESTED ? -1 : i % 5000,
+                          0, 0, distance, fare, state, prior, pickupDistance, zone, finishTime);
+    }
+}
+
+struct QueryResults
+{
+    double revenue;
+    double zoneHourTotal;
+    int p50;
+    int p95;
+    double rates[TRIP_STATE_COUNT];
+};
+
+double runQueries(const TripAnalytics &analytics, int zones, QueryResults &results)
+{
+    TripFilter all;
+    double *byZoneHour = new double[zones * TripAnalytics::HOURS_PER_DAY];
+    const double fractions[2] = {0.5, 0.95};
+    int percentiles[2];
+
+    auto begin = chrono::steady_clock::now();
+    results.revenue = analytics.totalRevenue(all);
+    analytics.revenueByZoneHour(all, byZoneHour, zones);
+    analytics.pickupDistancePercentiles(all, fractions, 2, percentiles);
+    analytics.cancellationRateByState(all, results.rates);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    results.zoneHourTotal = 0.0;
+    for (int i = 0; i < zones * TripAnalytics::HOURS_PER_DAY; i++)
+        results.zoneHourTotal += byZoneHour[i];
+    results.p50 = percentiles[0];
+    results.p95 = percentiles[1];
+    delete[] byZoneHour;
+    return seconds;
+}
+
+int main(int argc, char *argv[])
+{
+    int rows = argc > 1 ? atoi(argv[1]) : 10000000;
+    int zones = argc > 2 ? atoi(argv[2]) : 16;
+    int threads = argc > 3 ? atoi(argv[3]) : (int)thread::hardware_concurrency();
+    if (threads < 1)
+        threads = 1;
+
+    TripHistory history;
+    auto begin = chrono::steady_clock::now();
+    fillHistory(history, rows, zones);
+    double fillSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    cerr << "rows=" << rows << "  zones=" << zones << "  fill=" << fillSeconds << "s"
+         << "  columns=" << history.getMemoryBytes() / (1024 * 1024) << "MB" << endl;
+
+    TripAnalytics analytics(history, 1);
+    QueryResults serial;
+    double serialSeconds = runQueries(analytics, zones, serial);
+    cerr << "threads=1   queries=" << serialSeconds << "s  rows/s="
+         << (long long)(4.0 * rows / serialSeconds) << endl;
+
+    analytics.setThreadCount(threads);
+    QueryResults parallel;
+    double parallelSeconds = runQueries(analytics, zones, parallel);
+    cerr << "threads=" << threads << "   queries=" << parallelSeconds << "s  rows/s="
+         << (long long)(4.0 * rows / parallelSeconds) << "  speedup="
+         << serialSeconds / parallelSeconds << endl;
+
+    bool same = serial.p50 == parallel.p50 && serial.p95 == parallel.p95 &&
+                fabs(serial.revenue - parallel.revenue) <= 1e-9 * serial.revenue &&
+                fabs(serial.zoneHourTotal - serial.revenue) <= 1e-9 * serial.revenue;
+    for (int s = 0; s < TRIP_STATE_COUNT; s++)
+        same = same && serial.rates[s] == parallel.rates[s];
+
+    cerr << "revenue=" << (long long)serial.revenue << "  p50=" << serial.p50
+         << "  p95=" << serial.p95 << "  cancelled from REQUESTED/ASSIGNED/ONGOING="
+         << serial.rates[REQUESTED] * 100 << "%/" << serial.rates[ASSIGNED] * 100 << "%/"
+         << serial.rates[ONGOING] * 100 << "%" << endl;
+    cerr << "results " << (same ? "match" : "DIFFER") << endl;
+    return same ? 0 : 1;
+}
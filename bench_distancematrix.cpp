@@ -0,0 +1,86 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "BenchCity.h"
+#include "DistanceMatrix.h"
+#include "DispatchEngine.h"
+using namespace std;
+
+// Builds the all-pairs distance matrix of a grid city with both algorithms,
+// checks they agree with each other and with City::getShortestDistance, and
+// measures findBestDriver with and without the matrix enabled.
+// Usage: bench_distancematrix [gridSide] [threads] [extraRoadsPerNode] [drivers] [requests]
+
+double timeBuild(DistanceMatrix &matrix)
+{
+    auto begin = chrono::steady_clock::now();
+    matrix.refresh();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+}
+
+int main(int argc, char **argv)
+{
+    int side = argc > 1 ? atoi(argv[1]) : 40;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    int extraRoads = argc > 3 ? atoi(argv[3]) : 0;
+    int driverCount = argc > 4 ? atoi(argv[4]) : 50;
+    int requestCount = argc > 5 ? atoi(argv[5]) : 20;
+
+    silenceLibraryLogging();
+
+    City city;
+    buildGridCity(city, side, 99, 11);
+    addShortcutRoads(city, extraRoads);
+    int nodes = city.getNodeCount();
+    cerr << "City: " << nodes << " locations, " << city.getTotalRoadCount() << " roads" << endl;
+
+    DistanceMatrix floyd(&city, MATRIX_FLOYD_WARSHALL, threads);
+    DistanceMatrix dijkstra(&city, MATRIX_DIJKSTRA, threads);
+    double floydMs = timeBuild(floyd);
+    double dijkstraMs = timeBuild(dijkstra);
+    cerr << "  blocked Floyd-Warshall " << floydMs << " ms, per-source Dijkstra " << dijkstraMs
+         << " ms (" << (floyd.isNarrow() ? 16 : 32) << "-bit, "
+         << floyd.getMemoryBytes() / 1024 << " KB)" << endl;
+
+    long long mismatches = 0;
+    for (int a = 0; a < nodes; a++)
+        for (int b = 0; b < nodes; b++)
+            mismatches += floyd.getDistance(a, b) != dijkstra.getDistance(a, b);
+
+    // City's own search is O(n^2) per source, so only spot-check a few rows
+    for (int a = 0; a < nodes; a += nodes / 8 + 1)
+    {
+        City::ShortestPathResult reference = city.dijkstra(a);
+        for (int b = 0; b < nodes; b++)
+            mismatches += floyd.getDistance(a, b) != reference.getDistanceTo(b);
+    }
+    cerr << "  mismatches: " << mismatches << endl;
+
+    long long checksum[2] = {0, 0};
+    for (int withMatrix = 0; withMatrix < 2; withMatrix++)
+    {
+        if (withMatrix)
+        {
+            city.enableDistanceMatrix(threads);
+            city.prepareForConcurrentReads(); // Build outside the timed loop
+        }
+
+        DispatchEngine engine(&city);
+        for (int i = 0; i < driverCount; i++)
+            engine.createDriver(100 + i, (int)((long long)i * nodes / driverCount), 0);
+
+        unsigned int seed = 1000;
+        auto begin = chrono::steady_clock::now();
+        for (int i = 0; i < requestCount; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            Driver *best = engine.findBestDriver((seed >> 8) % nodes);
+            checksum[withMatrix] += best != nullptr ? best->getId() : 0;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        cerr << "  findBestDriver " << (withMatrix ? "with" : "without") << " matrix: requests/s="
+             << (int)(requestCount / seconds) << "  checksum=" << checksum[withMatrix] << endl;
+    }
+
+    return mismatches == 0 && checksum[0] == checksum[1] ? 0 : 1;
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "BenchCity.h"
+using namespace std;
+
+// Fills a sources x targets distance table on a grid city three ways: one
+// getShortestDistance per pair, City::distanceTable with its multi-target
+// searches, and City::distanceTable over the all-pairs distance matrix.
+// Usage: bench_distancetable [gridSide] [sources] [targets]
+
+int main(int argc, char **argv)
+{
+    int side = argc > 1 ? atoi(argv[1]) : 40;
+    int sourceCount = argc > 2 ? atoi(argv[2]) : 20;
+    int targetCount = argc > 3 ? atoi(argv[3]) : 20;
+
+    silenceLibraryLogging();
+
+    City city;
+    buildGridCity(city, side, 20, 5);
+    int nodes = city.getNodeCount();
+
+    int *sources = new int[sourceCount];
+    int *targets = new int[targetCount];
+    unsigned int seed = 77;
+    for (int i = 0; i < sourceCount; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        sources[i] = (seed >> 8) % nodes;
+    }
+    for (int j = 0; j < targetCount; j++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        targets[j] = (seed >> 8) % nodes;
+    }
+
+    int *pairwise = new int[sourceCount * targetCount];
+    int *table = new int[sourceCount * targetCount];
+    cerr << "Grid " << side << "x" << side << ", " << sourceCount << " x " << targetCount << " table" << endl;
+
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < sourceCount; i++)
+        for (int j = 0; j < targetCount; j++)
+            pairwise[i * targetCount + j] = city.getShortestDistance(sources[i], targets[j]);
+    double pairwiseMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    begin = chrono::steady_clock::now();
+    city.distanceTable(sources, sourceCount, targets, targetCount, table);
+    double searchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    long long mismatches = 0;
+    for (int k = 0; k < sourceCount * targetCount; k++)
+        mismatches += table[k] != pairwise[k];
+
+    city.enableDistanceMatrix();
+    city.prepareForConcurrentReads(); // Build outside the timed section
+    begin = chrono::steady_clock::now();
+    city.distanceTable(sources, sourceCount, targets, targetCount, table);
+    double matrixMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+
+    for (int k = 0; k < sourceCount * targetCount; k++)
+        mismatches += table[k] != pairwise[k];
+
+    cerr << "  pairwise getShortestDistance " << pairwiseMs << " ms" << endl;
+    cerr << "  distanceTable (multi-target) " << searchMs << " ms" << endl;
+    cerr << "  distanceTable (matrix)       " << matrixMs << " ms" << endl;
+    cerr << "  mismatches: " << mismatches << endl;
+
+    delete[] sources;
+    delete[] targets;
+    delete[] pairwise;
+    delete[] table;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include "BenchCity.h"
+#include "DispatchEngine.h"
+#include "ScoringPolicy.h"
+using namespace std;
+
+// Compares the candidate scoring loop specialized per policy at compile time
+// against the same loop choosing the policy at runtime for every candidate,
+// then runs findBestDriver end to end under each policy.
+// Usage: bench_scoring [candidates] [rounds] [gridSide] [drivers] [requests]
+
+const int ZONE_COUNT = 8;
+
+// The unspecialized loop: the policy is looked up for every candidate
+int selectBestDynamic(ScoringPolicyKind kind, const int *costs, const unsigned char *sameZone,
+                      const int *ratings, int count)
+{
+    int best = -1;
+    int bestScore = INT_MAX;
+    for (int i = 0; i < count; i++)
+    {
+        if (costs[i] < 0)
+            continue;
+        int score = scoreCandidate(kind, costs[i], sameZone[i] != 0, ratings[i]);
+        if (score < bestScore)
+        {
+            bestScore = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    int candidates = argc > 1 ? atoi(argv[1]) : 1000000;
+    int rounds = argc > 2 ? atoi(argv[2]) : 50;
+    int side = argc > 3 ? atoi(argv[3]) : 16;
+    int driverCount = argc > 4 ? atoi(argv[4]) : 50;
+    int requestCount = argc > 5 ? atoi(argv[5]) : 200;
+
+    silenceLibraryLogging();
+
+    int *costs = new int[candidates];
+    unsigned char *sameZone = new unsigned char[candidates];
+    int *ratings = new int[candidates];
+    unsigned int seed = 99;
+    for (int i = 0; i < candidates; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        costs[i] = (seed >> 8) % 64 == 0 ? -1 : 5 + (int)((seed >> 8) % 5000);
+        sameZone[i] = (seed >> 20) % 4 == 0;
+        ratings[i] = Driver::MIN_RATING + (int)((seed >> 24) % (Driver::MAX_RATING - Driver::MIN_RATING + 1));
+    }
+
+    cerr << "Scoring loop: " << candidates << " candidates x " << rounds << " rounds" << endl;
+    bool allMatch = true;
+    for (int k = 0; k < SCORING_POLICY_COUNT; k++)
+    {
+        ScoringPolicyKind kind = (ScoringPolicyKind)k;
+        int dynamicBest = -1;
+        int specializedBest = -1;
+
+        auto begin = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++)
+            dynamicBest = selectBestDynamic(kind, costs + r % 2, sameZone, ratings, candidates - 1);
+        double dynamicSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+        begin = chrono::steady_clock::now();
+        for (int r = 0; r < rounds; r++)
+            specializedBest = selectBestCandidate(kind, costs + r % 2, sameZone, ratings, candidates - 1);
+        double specializedSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+        bool match = dynamicBest == specializedBest;
+        allMatch = allMatch && match;
+        cerr << "  " << scoringPolicyName(kind) << "\tper-candidate dispatch " << dynamicSeconds * 1000.0
+             << " ms, specialized " << specializedSeconds * 1000.0 << " ms, speedup "
+             << dynamicSeconds / specializedSeconds << "x" << (match ? "" : "  (MISMATCH)") << endl;
+    }
+    delete[] costs;
+    delete[] sameZone;
+    delete[] ratings;
+
+    City city;
+    buildGridCity(city, side);
+    assignGridZones(city, ZONE_COUNT);
+    city.enableZoneBounds();
+    int nodes = city.getNodeCount();
+    cerr << "findBestDriver: grid " << side << "x" << side << ", " << driverCount << " drivers, "
+         << requestCount << " requests" << endl;
+
+    DispatchEngine engine(&city);
+    for (int i = 0; i < driverCount; i++)
+    {
+        int location = (int)((long long)i * nodes / driverCount);
+        engine.createDriver(100 + i, location, city.getZone(location));
+        engine.setDriverRating(100 + i, Driver::MIN_RATING + i % (Driver::MAX_RATING - Driver::MIN_RATING + 1));
+    }
+
+    for (int k = 0; k < SCORING_POLICY_COUNT; k++)
+    {
+        engine.setScoringPolicy((ScoringPolicyKind)k);
+        long long checksum = 0;
+        seed = 1000;
+        auto begin = chrono::steady_clock::now();
+        for (int i = 0; i < requestCount; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            Driver *best = engine.findBestDriver((seed >> 8) % nodes);
+            checksum += best != nullptr ? best->getId() : 0;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        cerr << "  " << scoringPolicyName((ScoringPolicyKind)k) << "\trequests/s="
+             << (int)(requestCount / seconds) << "  checksum=" << checksum << endl;
+    }
+
+    return allMatch ? 0 : 1;
+}
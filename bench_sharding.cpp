@@ -0,0 +1,87 @@
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include "BenchCity.h"
+#include "ShardedDispatchEngine.h"
+using namespace std;
+
+// Measures request throughput of ShardedDispatchEngine as the shard count grows.
+// Usage: bench_sharding [gridSide] [drivers] [requests]
+
+const int ZONE_COUNT = 8;
+const int PRODUCER_THREADS = 4;
+
+double runBenchmark(City &city, int shards, int driverCount, int requestCount)
+{
+    int nodes = city.getNodeCount();
+    ShardedDispatchEngine engine(&city, shards);
+
+    for (int i = 0; i < driverCount; i++)
+    {
+        int location = (int)((long long)i * nodes / driverCount);
+        engine.createDriver(100 + i, location, city.getZone(location));
+    }
+    engine.start();
+
+    auto begin = chrono::steady_clock::now();
+
+    thread producers[PRODUCER_THREADS];
+    for (int t = 0; t < PRODUCER_THREADS; t++)
+    {
+        producers[t] = thread([&engine, t, nodes, requestCount]()
+                               {
+            unsigned int seed = 1000 + t;
+            for (int i = t; i < requestCount; i += PRODUCER_THREADS)
+            {
+                seed = seed * 1103515245u + 12345u;
+                int pickup = (seed >> 8) % nodes;
+                seed = seed * 1103515245u + 12345u;
+                int dropoff = (seed >> 8) % nodes;
+                if (pickup == dropoff)
+                    dropoff = (dropoff + 1) % nodes;
+
+                Rider rider(5000 + i, pickup, dropoff);
+                TripRequestResult result = engine.submitTripRequest(rider).get();
+                if (result.driverId != -1)
+                    engine.submitCompleteTrip(result.tripId).get();
+            } });
+    }
+    for (auto &producer : producers)
+        producer.join();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    long long steals = engine.getSuccessfulSteals();
+    engine.stop();
+
+    cerr << "shards=" << shards << "  requests/s=" << (int)(requestCount / seconds)
+         << "  steals=" << steals << endl;
+    return requestCount / seconds;
+}
+
+int main(int argc, char **argv)
+{
+    int side = argc > 1 ? atoi(argv[1]) : 16;
+    int driverCount = argc > 2 ? atoi(argv[2]) : 32;
+    int requestCount = argc > 3 ? atoi(argv[3]) : 2000;
+
+    silenceLibraryLogging();
+
+    City city;
+    buildGridCity(city, side);
+    assignGridZones(city, ZONE_COUNT);
+    city.enableZoneBounds();
+
+    cerr << "Grid " << side << "x" << side << ", " << driverCount << " drivers, "
+         << requestCount << " requests, " << PRODUCER_THREADS << " producers" << endl;
+
+    double baseline = 0.0;
+    for (int shards = 1; shards <= ZONE_COUNT; shards *= 2)
+    {
+        double throughput = runBenchmark(city, shards, driverCount, requestCount);
+        if (shards == 1)
+            baseline = throughput;
+        cerr << "  speedup vs 1 shard: " << throughput / baseline << "x" << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "BenchCity.h"
+#include "DispatchEngine.h"
+#include "WriteAheadLog.h"
+#include "Arena.h"
+using namespace std;
+
+// Measures dispatch throughput with the write-ahead log off and under each
+// fsync policy, then checks that replaying the log rebuilds the engine.
+// Usage: bench_wal [gridSide] [drivers] [requests] [groupSize]
+
+const char *LOG_PATH = "bench_wal.log";
+
+// Returns requests per second; leaves the log on disk for recovery
+double runBenchmark(City &city, const char *label, WriteAheadLog *log,
+                    int driverCount, int requestCount, int &tripsOut)
+{
+    int nodes = city.getNodeCount();
+    DispatchEngine engine(&city);
+    engine.setWriteAheadLog(log);
+
+    for (int i = 0; i < driverCount; i++)
+    {
+        int location = (int)((long long)i * nodes / driverCount);
+        engine.createDriver(100 + i, location, city.getZone(location));
+    }
+
+    // Riders only live for this run; they are freed together with the arena
+    Arena run;
+
+    auto begin = chrono::steady_clock::now();
+
+    unsigned int seed = 1000;
+    for (int i = 0; i < requestCount; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int pickup = (seed >> 8) % nodes;
+        seed = seed * 1103515245u + 12345u;
+        int dropoff = (seed >> 8) % nodes;
+        if (pickup == dropoff)
+            dropoff = (dropoff + 1) % nodes;
+
+        Rider *rider = run.create<Rider>(5000 + i, pickup, dropoff);
+        Trip *trip = engine.requestTrip(*rider);
+        if (trip != nullptr && trip->getDriverId() != -1)
+            engine.completeTrip(trip->getId());
+    }
+    if (log != nullptr)
+        log->commit();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    tripsOut = engine.getTotalTripCount();
+
+    cerr << label << "  requests/s=" << (int)(requestCount / seconds);
+    if (log != nullptr)
+        cerr << "  records=" << log->getLastLsn() << "  commits=" << log->getCommitCount()
+             << "  fsyncs=" << log->getSyncCount();
+    cerr << endl;
+    return requestCount / seconds;
+}
+
+int main(int argc, char **argv)
+{
+    int side = argc > 1 ? atoi(argv[1]) : 16;
+    int driverCount = argc > 2 ? atoi(argv[2]) : 32;
+    int requestCount = argc > 3 ? atoi(argv[3]) : 2000;
+    int groupSize = argc > 4 ? atoi(argv[4]) : 64;
+
+    silenceLibraryLogging();
+
+    City city;
+    buildGridCity(city, side);
+
+    cerr << "Grid " << side << "x" << side << ", " << driverCount << " drivers, "
+         << requestCount << " requests, group size " << groupSize << endl;
+
+    int trips = 0;
+    double baseline = runBenchmark(city, "no WAL     ", nullptr, driverCount, requestCount, trips);
+
+    const char *labels[3] = {"WAL no sync", "WAL group  ", "WAL always "};
+    WalSyncPolicy policies[3] = {WAL_SYNC_NONE, WAL_SYNC_GROUP, WAL_SYNC_ALWAYS};
+    for (int p = 0; p < 3; p++)
+    {
+        remove(LOG_PATH);
+        double throughput;
+        {
+            WriteAheadLog log(LOG_PATH, policies[p], groupSize);
+            throughput = runBenchmark(city, labels[p], &log, driverCount, requestCount, trips);
+        }
+        cerr << "  relative to no WAL: " << throughput / baseline << "x" << endl;
+
+        // Replay into a fresh engine and compare
+        DispatchEngine recovered(&city);
+        auto begin = chrono::steady_clock::now();
+        long long applied = recovered.recoverFromLog(LOG_PATH);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        cerr << "  recovery: " << applied << " records in " << seconds * 1000.0 << " ms, trips "
+             << recovered.getTotalTripCount() << "/" << trips
+             << (recovered.getTotalTripCount() == trips ? " (match)" : " (MISMATCH)") << endl;
+    }
+
+    remove(LOG_PATH);
+    return 0;
+}
@@ -1,4 +1,9 @@
 #include "Citydj.h"
+#include "ZoneDistanceMatrix.h"
+#include "DistanceTreeCache.h"
+#include "DistanceMatrix.h"
+#include "TravelTimeProfiles.h"
+#include "MinHeap.h"
 #include <iostream>
 #include <climits>
 
@@ -9,11 +14,19 @@ const int INITIAL_CAPACITY = 10;
 const int INITIAL_ROAD_CAPACITY = 5;
 const int INFINITY_DISTANCE = INT_MAX; // Represents infinite distance
 
+const int City::ROAD_CLOSED = -1;
+
 // ==================== Road Implementation ====================
 
-City::Road::Road() : toNodeId(-1), distance(0) {}
+City::Road::Road() : toNodeId(-1), distance(0), profileId(-1) {}
+
+City::Road::Road(int to, int dist) : toNodeId(to), distance(dist), profileId(-1) {}
+
+// ==================== RoadUpdate Implementation ====================
 
-City::Road::Road(int to, int dist) : toNodeId(to), distance(dist) {}
+City::RoadUpdate::RoadUpdate() : from(-1), to(-1), distance(ROAD_CLOSED) {}
+
+City::RoadUpdate::RoadUpdate(int a, int b, int dist) : from(a), to(b), distance(dist) {}
 
 // ==================== Node Implementation ====================
 
@@ -81,6 +94,20 @@ int City::Node::getRoadIndex(int nodeId) const
     return -1;
 }
 
+bool City::Node::removeRoad(int to)
+{
+    int index = getRoadIndex(to);
+    if (index == -1)
+    {
+        return false;
+    }
+
+    // Order of roads doesn't matter; move the last one into the gap
+    roads[index] = roads[roadCount - 1];
+    roadCount--;
+    return true;
+}
+
 // ==================== ShortestPathResult Implementation ====================
 
 City::ShortestPathResult::ShortestPathResult()
@@ -99,6 +126,14 @@ City::ShortestPathResult::ShortestPathResult(int count) : nodeCount(count)
     }
 }
 
+City::ShortestPathResult::ShortestPathResult(ShortestPathResult &&other)
+    : distances(other.distances), predecessors(other.predecessors), nodeCount(other.nodeCount)
+{
+    other.distances = nullptr;
+    other.predecessors = nullptr;
+    other.nodeCount = 0;
+}
+
 City::ShortestPathResult::~ShortestPathResult()
 {
     if (distances != nullptr)
@@ -180,10 +215,15 @@ void City::ShortestPathResult::printDistances() const
 
 // ==================== City Implementation ====================
 
-City::City() : nodeCount(0)
+City::City() : nodeCount(0), componentCount(0), zoneBounds(nullptr), distanceCache(nullptr),
+               distanceMatrix(nullptr), profiles(nullptr)
 {
     capacity = INITIAL_CAPACITY;
     nodes = new Node *[capacity];
+    componentLabel = new int[capacity];
+    componentNext = new int[capacity];
+    componentTail = new int[capacity];
+    componentSize = new int[capacity];
 
     // Initialize all pointers to nullptr
     for (int i = 0; i < capacity; i++)
@@ -203,10 +243,24 @@ City::~City()
         }
     }
     delete[] nodes;
+    delete[] componentLabel;
+    delete[] componentNext;
+    delete[] componentTail;
+    delete[] componentSize;
+    delete zoneBounds;
+    delete distanceCache;
+    delete distanceMatrix;
+    delete profiles;
 }
 
 int City::findNode(int id) const
 {
+    // Fast path: IDs are normally dense and equal to their index
+    if (id >= 0 && id < nodeCount && nodes[id]->id == id)
+    {
+        return id;
+    }
+
     for (int i = 0; i < nodeCount; i++)
     {
         if (nodes[i] != nullptr && nodes[i]->id == id)
@@ -246,6 +300,76 @@ void City::resizeNodes()
 
     delete[] nodes;
     nodes = newNodes;
+
+    // Grow component arrays to match
+    int *newLabel = new int[capacity];
+    int *newNext = new int[capacity];
+    int *newTail = new int[capacity];
+    int *newSize = new int[capacity];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        newLabel[i] = componentLabel[i];
+        newNext[i] = componentNext[i];
+        newTail[i] = componentTail[i];
+        newSize[i] = componentSize[i];
+    }
+    delete[] componentLabel;
+    delete[] componentNext;
+    delete[] componentTail;
+    delete[] componentSize;
+    componentLabel = newLabel;
+    componentNext = newNext;
+    componentTail = newTail;
+    componentSize = newSize;
+}
+
+void City::mergeComponents(int indexA, int indexB)
+{
+    int big = componentLabel[indexA];
+    int small = componentLabel[indexB];
+
+    if (big == small)
+    {
+        return; // Already connected
+    }
+
+    if (componentSize[big] < componentSize[small])
+    {
+        int temp = big;
+        big = small;
+        small = temp;
+    }
+
+    // Relabel the smaller component and splice its list onto the larger one
+    for (int i = small; i != -1; i = componentNext[i])
+    {
+        componentLabel[i] = big;
+    }
+    componentNext[componentTail[big]] = small;
+    componentTail[big] = componentTail[small];
+    componentSize[big] += componentSize[small];
+    componentCount--;
+}
+
+void City::recomputeComponents()
+{
+    for (int i = 0; i < nodeCount; i++)
+    {
+        componentLabel[i] = i;
+        componentNext[i] = -1;
+        componentTail[i] = i;
+        componentSize[i] = 1;
+    }
+    componentCount = nodeCount;
+
+    for (int i = 0; i < nodeCount; i++)
+    {
+        Node *node = nodes[i];
+        for (int j = 0; j < node->roadCount; j++)
+        {
+            mergeComponents(i, findNode(node->roads[j].toNodeId));
+        }
+    }
 }
 
 bool City::addLocation(int id)
@@ -263,10 +387,28 @@ bool City::addLocation(int id)
         resizeNodes();
     }
 
-    // Create new node
+    // Create new node in its own component
     nodes[nodeCount] = new Node(id);
+    componentLabel[nodeCount] = nodeCount;
+    componentNext[nodeCount] = -1;
+    componentTail[nodeCount] = nodeCount;
+    componentSize[nodeCount] = 1;
+    componentCount++;
     nodeCount++;
 
+    if (zoneBounds != nullptr)
+    {
+        zoneBounds->invalidate();
+    }
+    if (distanceCache != nullptr)
+    {
+        distanceCache->invalidate();
+    }
+    if (distanceMatrix != nullptr)
+    {
+        distanceMatrix->invalidate();
+    }
+
     cout << "Location " << id << " added successfully!" << endl;
     return true;
 }
@@ -313,12 +455,170 @@ bool City::addRoad(int from, int to, int distance)
     // Add road (undirected graph - add both directions)
     nodes[fromIndex]->addRoad(to, distance);
     nodes[toIndex]->addRoad(from, distance);
+    mergeComponents(fromIndex, toIndex);
+
+    if (zoneBounds != nullptr)
+    {
+        zoneBounds->onRoadAdded(from, to, distance);
+    }
+    if (distanceCache != nullptr)
+    {
+        RoadUpdate added(from, to, distance);
+        int unset = ROAD_CLOSED;
+        distanceCache->onRoadsChanged(&added, &unset, 1);
+    }
+    if (distanceMatrix != nullptr)
+    {
+        distanceMatrix->onRoadAdded(from, to, distance);
+    }
 
     cout << "Road from " << from << " to " << to << " with distance "
          << distance << " added successfully!" << endl;
     return true;
 }
 
+bool City::setRoadWeight(int from, int to, int distance)
+{
+    if (distance <= 0)
+    {
+        cout << "Cannot update road: Distance must be positive!" << endl;
+        return false;
+    }
+    if (getDistance(from, to) == -1)
+    {
+        cout << "Cannot update road: No road from " << from << " to " << to << "!" << endl;
+        return false;
+    }
+
+    RoadUpdate update(from, to, distance);
+    return applyRoadUpdates(&update, 1) == 1;
+}
+
+bool City::removeRoad(int from, int to)
+{
+    RoadUpdate update(from, to, ROAD_CLOSED);
+    return applyRoadUpdates(&update, 1) == 1;
+}
+
+int City::applyRoadUpdates(const RoadUpdate *updates, int count)
+{
+    if (updates == nullptr || count <= 0)
+    {
+        return 0;
+    }
+
+    // Applied updates and the distances they replaced, for the repair passes
+    RoadUpdate *applied = new RoadUpdate[count];
+    int *oldDistances = new int[count];
+    int appliedCount = 0;
+    bool removedAny = false;
+    bool increasedAny = false;
+
+    for (int i = 0; i < count; i++)
+    {
+        int from = updates[i].from;
+        int to = updates[i].to;
+        int distance = updates[i].distance;
+        int fromIndex = findNode(from);
+        int toIndex = findNode(to);
+
+        if (fromIndex == -1 || toIndex == -1 || from == to)
+        {
+            cout << "Cannot update road: Invalid locations " << from << " and " << to << "!" << endl;
+            continue;
+        }
+        if (distance != ROAD_CLOSED && distance <= 0)
+        {
+            cout << "Cannot update road: Distance must be positive!" << endl;
+            continue;
+        }
+
+        Node *fromNode = nodes[fromIndex];
+        Node *toNode = nodes[toIndex];
+        int roadIndex = fromNode->getRoadIndex(to);
+        int oldDistance = roadIndex == -1 ? ROAD_CLOSED : fromNode->roads[roadIndex].distance;
+
+        if (distance == ROAD_CLOSED)
+        {
+            if (roadIndex == -1)
+            {
+                cout << "Cannot remove road: No road from " << from << " to " << to << "!" << endl;
+                continue;
+            }
+            fromNode->removeRoad(to);
+            toNode->removeRoad(from);
+            removedAny = true;
+            cout << "Road from " << from << " to " << to << " closed." << endl;
+        }
+        else if (roadIndex == -1)
+        {
+            fromNode->addRoad(to, distance);
+            toNode->addRoad(from, distance);
+            mergeComponents(fromIndex, toIndex);
+            cout << "Road from " << from << " to " << to << " with distance "
+                 << distance << " opened." << endl;
+        }
+        else
+        {
+            fromNode->roads[roadIndex].distance = distance;
+            toNode->roads[toNode->getRoadIndex(from)].distance = distance;
+            cout << "Road from " << from << " to " << to << " distance changed from "
+                 << oldDistance << " to " << distance << endl;
+        }
+
+        if (distance == ROAD_CLOSED || (oldDistance != ROAD_CLOSED && distance > oldDistance))
+        {
+            increasedAny = true;
+        }
+        applied[appliedCount] = updates[i];
+        oldDistances[appliedCount] = oldDistance;
+        appliedCount++;
+    }
+
+    if (removedAny)
+    {
+        // Union-find cannot split components
+        recomputeComponents();
+    }
+
+    if (zoneBounds != nullptr)
+    {
+        if (increasedAny)
+        {
+            zoneBounds->invalidate(); // Lower bounds may have grown
+        }
+        else
+        {
+            for (int i = 0; i < appliedCount; i++)
+            {
+                zoneBounds->onRoadAdded(applied[i].from, applied[i].to, applied[i].distance);
+            }
+        }
+    }
+    if (distanceCache != nullptr && appliedCount > 0)
+    {
+        distanceCache->onRoadsChanged(applied, oldDistances, appliedCount);
+    }
+    if (distanceMatrix != nullptr)
+    {
+        if (increasedAny)
+        {
+            distanceMatrix->invalidate(); // Distances may have grown
+        }
+        else
+        {
+            for (int i = 0; i < appliedCount; i++)
+            {
+                distanceMatrix->onRoadAdded(applied[i].from, applied[i].to, applied[i].distance);
+            }
+        }
+    }
+
+    delete[] applied;
+    delete[] oldDistances;
+    return appliedCount;
+}
+
 bool City::setZone(int nodeId, int zoneId)
 {
     int nodeIndex = findNode(nodeId);
@@ -336,11 +636,54 @@ bool City::setZone(int nodeId, int zoneId)
         return false;
     }
 
+    int oldZone = nodes[nodeIndex]->zoneId;
     nodes[nodeIndex]->zoneId = zoneId;
+
+    if (zoneBounds != nullptr && oldZone != zoneId)
+    {
+        zoneBounds->onZoneChanged(nodeId, oldZone, zoneId);
+    }
     cout << "Zone " << zoneId << " assigned to location " << nodeId << " successfully!" << endl;
     return true;
 }
 
+int City::setZones(const int *nodeIds, const int *zoneIds, int count)
+{
+    if (nodeIds == nullptr || zoneIds == nullptr || count <= 0)
+    {
+        return 0;
+    }
+
+    int changed = 0;
+    for (int i = 0; i < count; i++)
+    {
+        int nodeIndex = findNode(nodeIds[i]);
+        if (nodeIndex == -1)
+        {
+            cout << "Cannot set zone: Location " << nodeIds[i] << " does not exist!" << endl;
+            continue;
+        }
+        if (zoneIds[i] < 0)
+        {
+            cout << "Cannot set zone: Zone ID must be non-negative!" << endl;
+            continue;
+        }
+        if (nodes[nodeIndex]->zoneId != zoneIds[i])
+        {
+            nodes[nodeIndex]->zoneId = zoneIds[i];
+            changed++;
+        }
+    }
+
+    // One rebuild for the whole batch instead of two row searches per location
+    if (zoneBounds != nullptr && changed > 0)
+    {
+        zoneBounds->invalidate();
+    }
+    cout << "Zones assigned to " << changed << " locations successfully!" << endl;
+    return changed;
+}
+
 int City::getZone(int nodeId) const
 {
     int nodeIndex = findNode(nodeId);
@@ -379,6 +722,62 @@ bool City::locationExists(int id) const
     return findNode(id) != -1;
 }
 
+bool City::areConnected(int a, int b) const
+{
+    int indexA = findNode(a);
+    int indexB = findNode(b);
+
+    if (indexA == -1 || indexB == -1)
+    {
+        return false;
+    }
+    return componentLabel[indexA] == componentLabel[indexB];
+}
+
+int City::getComponentId(int nodeId) const
+{
+    int index = findNode(nodeId);
+    if (index == -1)
+    {
+        return -1;
+    }
+    return componentLabel[index];
+}
+
+int City::getComponentCount() const
+{
+    return componentCount;
+}
+
+void City::enableZoneBounds()
+{
+    if (zoneBounds == nullptr)
+    {
+        zoneBounds = new ZoneDistanceMatrix(this);
+    }
+}
+
+int City::getZoneLowerBound(int zoneA, int zoneB) const
+{
+    if (zoneBounds == nullptr)
+    {
+        return 0;
+    }
+    return zoneBounds->getLowerBound(zoneA, zoneB);
+}
+
+void City::prepareForConcurrentReads()
+{
+    if (zoneBounds != nullptr)
+    {
+        zoneBounds->refresh();
+    }
+    if (distanceMatrix != nullptr)
+    {
+        distanceMatrix->refresh();
+    }
+}
+
 int City::getDistance(int from, int to) const
 {
     int fromIndex = findNode(from);
@@ -399,6 +798,54 @@ int City::getDistance(int from, int to) const
     return fromNode->roads[roadIndex].distance;
 }
 
+int City::getRoadCount(int nodeId) const
+{
+    Node *node = getNode(nodeId);
+    if (node == nullptr)
+    {
+        return -1; // Node doesn't exist
+    }
+    return node->roadCount;
+}
+
+int City::getRoads(int nodeId, int *neighborArray, int *distanceArray) const
+{
+    Node *node = getNode(nodeId);
+    if (node == nullptr)
+    {
+        return -1; // Node doesn't exist
+    }
+
+    for (int i = 0; i < node->roadCount; i++)
+    {
+        neighborArray[i] = node->roads[i].toNodeId;
+        distanceArray[i] = node->roads[i].distance;
+    }
+    return node->roadCount;
+}
+
+long long City::getAdjacencyBytes() const
+{
+    long long bytes = (long long)capacity * sizeof(Node *);
+
+    for (int i = 0; i < nodeCount; i++)
+    {
+        bytes += sizeof(Node);
+        bytes += (long long)nodes[i]->capacity * sizeof(Road);
+    }
+    return bytes;
+}
+
+int City::getTotalRoadCount() const
+{
+    int directedRoads = 0;
+    for (int i = 0; i < nodeCount; i++)
+    {
+        directedRoads += nodes[i]->roadCount;
+    }
+    return directedRoads / 2; // Every road is stored in both directions
+}
+
 City::ShortestPathResult City::dijkstra(int source) const
 {
     // Initialize result
@@ -477,8 +924,58 @@ City::ShortestPathResult City::dijkstra(int source) const
     return result;
 }
 
+void City::enableDistanceCache(int maxTrees)
+{
+    if (distanceCache == nullptr)
+    {
+        distanceCache = new DistanceTreeCache(this, maxTrees);
+    }
+}
+
+bool City::hasDistanceCache() const
+{
+    return distanceCache != nullptr;
+}
+
+void City::printDistanceCacheStats() const
+{
+    if (distanceCache == nullptr)
+    {
+        cout << "Distance cache is not enabled." << endl;
+        return;
+    }
+    distanceCache->printStats();
+}
+
+void City::enableDistanceMatrix(int threadCount)
+{
+    if (distanceMatrix == nullptr)
+    {
+        distanceMatrix = new DistanceMatrix(this, MATRIX_AUTO, threadCount);
+    }
+}
+
+void City::printDistanceMatrixStats() const
+{
+    if (distanceMatrix == nullptr)
+    {
+        cout << "Distance matrix is not enabled." << endl;
+        return;
+    }
+    distanceMatrix->printStats();
+}
+
 int City::getShortestDistance(int source, int destination) const
 {
+    if (distanceMatrix != nullptr)
+    {
+        return distanceMatrix->getDistance(source, destination);
+    }
+    if (distanceCache != nullptr)
+    {
+        return distanceCache->getShortestDistance(source, destination);
+    }
+
     ShortestPathResult result = dijkstra(source);
     return result.getDistanceTo(destination);
 }
@@ -489,6 +986,278 @@ int City::getShortestPath(int source, int destination, int *pathArray) const
     return result.getPathTo(destination, pathArray);
 }
 
+bool City::distanceTable(const int *sources, int sourceCount,
+                         const int *targets, int targetCount, int *table) const
+{
+    if (sourceCount < 0 || targetCount < 0 ||
+        (sourceCount > 0 && sources == nullptr) || (targetCount > 0 && targets == nullptr) ||
+        (sourceCount > 0 && targetCount > 0 && table == nullptr))
+    {
+        cout << "Error: Invalid distance table request!" << endl;
+        return false;
+    }
+
+    if (distanceMatrix != nullptr)
+    {
+        for (int i = 0; i < sourceCount; i++)
+        {
+            for (int j = 0; j < targetCount; j++)
+            {
+                table[i * targetCount + j] = distanceMatrix->getDistance(sources[i], targets[j]);
+            }
+        }
+        return true;
+    }
+
+    // Search from the shorter side; distances are symmetric
+    bool fromTargets = targetCount < sourceCount;
+    const int *origins = fromTargets ? targets : sources;
+    const int *goals = fromTargets ? sources : targets;
+    int originCount = fromTargets ? targetCount : sourceCount;
+    int goalCount = fromTargets ? sourceCount : targetCount;
+
+    // Goals grouped by node: goalHead[node] is the first, goalNext chains the rest
+    int *goalHead = new int[nodeCount > 0 ? nodeCount : 1];
+    int *goalNext = new int[goalCount > 0 ? goalCount : 1];
+    int *goalIndex = new int[goalCount > 0 ? goalCount : 1];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        goalHead[i] = -1;
+    }
+    for (int g = 0; g < goalCount; g++)
+    {
+        goalIndex[g] = findNode(goals[g]);
+        if (goalIndex[g] != -1)
+        {
+            goalNext[g] = goalHead[goalIndex[g]];
+            goalHead[goalIndex[g]] = g;
+        }
+    }
+
+    // Distances are valid only where reachedBy matches the current search,
+    // so nothing is reset between searches
+    int *distance = new int[nodeCount > 0 ? nodeCount : 1];
+    int *reachedBy = new int[nodeCount > 0 ? nodeCount : 1];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        reachedBy[i] = -1;
+    }
+    MinHeap heap(64);
+
+    for (int o = 0; o < originCount; o++)
+    {
+        for (int g = 0; g < goalCount; g++)
+        {
+            table[fromTargets ? g * targetCount + o : o * targetCount + g] = -1;
+        }
+
+        int start = findNode(origins[o]);
+        if (start == -1)
+        {
+            continue;
+        }
+
+        // Goals outside the origin's component are never settled; don't wait for them
+        int remaining = 0;
+        for (int g = 0; g < goalCount; g++)
+        {
+            if (goalIndex[g] != -1 && componentLabel[goalIndex[g]] == componentLabel[start])
+            {
+                remaining++;
+            }
+        }
+
+        heap.clear();
+        distance[start] = 0;
+        reachedBy[start] = o;
+        heap.push(0, start);
+
+        int d, u;
+        while (remaining > 0 && heap.pop(d, u))
+        {
+            if (d > distance[u])
+            {
+                continue;
+            }
+
+            for (int g = goalHead[u]; g != -1; g = goalNext[g])
+            {
+                table[fromTargets ? g * targetCount + o : o * targetCount + g] = d;
+                remaining--;
+            }
+
+            Node *node = nodes[u];
+            for (int r = 0; r < node->roadCount; r++)
+            {
+                int v = findNode(node->roads[r].toNodeId);
+                int candidate = d + node->roads[r].distance;
+                if (reachedBy[v] != o || candidate < distance[v])
+                {
+                    reachedBy[v] = o;
+                    distance[v] = candidate;
+                    heap.push(candidate, v);
+                }
+            }
+        }
+    }
+
+    delete[] goalHead;
+    delete[] goalNext;
+    delete[] goalIndex;
+    delete[] distance;
+    delete[] reachedBy;
+    return true;
+}
+
+// ==================== Time-Dependent Travel Times ====================
+
+int City::addTravelTimeProfile(const int *times, const int *factors, int count)
+{
+    if (profiles == nullptr)
+    {
+        profiles = new TravelTimeProfiles();
+    }
+    return profiles->addProfile(times, factors, count);
+}
+
+bool City::setRoadProfile(int from, int to, int profileId)
+{
+    int fromIndex = findNode(from);
+    int toIndex = findNode(to);
+    int roadIndex = fromIndex == -1 ? -1 : nodes[fromIndex]->getRoadIndex(to);
+    if (roadIndex == -1 || toIndex == -1)
+    {
+        cout << "Cannot set profile: No road from " << from << " to " << to << "!" << endl;
+        return false;
+    }
+    if (profileId != -1 && (profiles == nullptr || profileId < 0 ||
+                            profileId >= profiles->getProfileCount()))
+    {
+        cout << "Cannot set profile: Profile " << profileId << " does not exist!" << endl;
+        return false;
+    }
+
+    Road &forward = nodes[fromIndex]->roads[roadIndex];
+    Road &backward = nodes[toIndex]->roads[nodes[toIndex]->getRoadIndex(from)];
+    forward.profileId = profileId;
+    backward.profileId = profileId;
+
+    if (profileId != -1 && !profiles->isFifo(profileId, forward.distance))
+    {
+        cout << "Warning: Profile " << profileId << " drops too fast for road " << from
+             << "-" << to << "; time-dependent routes over it may not be optimal." << endl;
+    }
+    return true;
+}
+
+int City::getRoadProfile(int from, int to) const
+{
+    Node *fromNode = getNode(from);
+    int roadIndex = fromNode == nullptr ? -1 : fromNode->getRoadIndex(to);
+    return roadIndex == -1 ? -1 : fromNode->roads[roadIndex].profileId;
+}
+
+int City::getTravelTime(int from, int to, int departureTime) const
+{
+    Node *fromNode = getNode(from);
+    int roadIndex = fromNode == nullptr ? -1 : fromNode->getRoadIndex(to);
+    if (roadIndex == -1)
+    {
+        return -1;
+    }
+
+    const Road &road = fromNode->roads[roadIndex];
+    if (road.profileId == -1)
+    {
+        return road.distance;
+    }
+    return profiles->getTravelTime(road.profileId, road.distance, departureTime);
+}
+
+void City::runTimeDependentSearch(int sourceIndex, int departureTime, int target,
+                                  int *distances, int *predecessors) const
+{
+    distances[sourceIndex] = 0;
+    MinHeap heap(nodeCount > 0 ? nodeCount : 1);
+    heap.push(0, sourceIndex);
+
+    int d, u;
+    while (heap.pop(d, u))
+    {
+        if (d > distances[u])
+        {
+            continue; // Stale entry
+        }
+        if (u == target)
+        {
+            return;
+        }
+
+        // Each road is priced at the moment it is entered
+        int now = departureTime + d;
+        Node *node = nodes[u];
+        for (int j = 0; j < node->roadCount; j++)
+        {
+            const Road &road = node->roads[j];
+            int cost = road.profileId == -1
+                           ? road.distance
+                           : profiles->getTravelTime(road.profileId, road.distance, now);
+            int v = road.toNodeId;
+            if (d + cost < distances[v])
+            {
+                distances[v] = d + cost;
+                predecessors[v] = u;
+                heap.push(d + cost, v);
+            }
+        }
+    }
+}
+
+City::ShortestPathResult City::timeDependentDijkstra(int source, int departureTime) const
+{
+    ShortestPathResult result(nodeCount);
+
+    int sourceIndex = findNode(source);
+    if (sourceIndex == -1)
+    {
+        cout << "Error: Source node " << source << " does not exist!" << endl;
+        return result;
+    }
+
+    runTimeDependentSearch(sourceIndex, departureTime, -1, result.distances, result.predecessors);
+    return result;
+}
+
+int City::getTravelTimeAt(int source, int destination, int departureTime) const
+{
+    int sourceIndex = findNode(source);
+    int destinationIndex = findNode(destination);
+    if (sourceIndex == -1 || destinationIndex == -1)
+    {
+        return -1;
+    }
+
+    ShortestPathResult result(nodeCount);
+    runTimeDependentSearch(sourceIndex, departureTime, destinationIndex,
+                           result.distances, result.predecessors);
+    return result.getDistanceTo(destinationIndex);
+}
+
+bool City::hasTravelTimeProfiles() const
+{
+    return profiles != nullptr && profiles->getProfileCount() > 0;
+}
+
+void City::printTravelTimeProfiles() const
+{
+    if (profiles == nullptr)
+    {
+        cout << "No travel-time profiles defined." << endl;
+        return;
+    }
+    profiles->print();
+}
+
 void City::printGraph() const
 {
     cout << "\n=== City Graph (Weighted with Zones) ===" << endl;
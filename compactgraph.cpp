@@ -0,0 +1,368 @@
+#include "CompactGraph.h"
+#include "MinHeap.h"
+#include <iostream>
+#include <iomanip>
+#include <climits>
+#include <algorithm>
+
+using namespace std;
+
+const int MAX_16BIT_DISTANCE = 65535;
+
+namespace
+{
+    struct EncodedRoad
+    {
+        int toNodeId;
+        int distance;
+    };
+
+    bool roadLess(const EncodedRoad &a, const EncodedRoad &b)
+    {
+        return a.toNodeId < b.toNodeId;
+    }
+
+    // Maps a signed delta to an unsigned value so small negatives stay short
+    unsigned int zigZagEncode(int value)
+    {
+        return ((unsigned int)value << 1) ^ (unsigned int)(value >> 31);
+    }
+
+    int zigZagDecode(unsigned int value)
+    {
+        return (int)(value >> 1) ^ -(int)(value & 1);
+    }
+}
+
+// ==================== CompactGraph Implementation ====================
+
+unsigned int CompactGraph::writeVarint(unsigned char *buffer, unsigned int pos, unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        buffer[pos++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[pos++] = (unsigned char)value;
+    return pos;
+}
+
+unsigned int CompactGraph::readVarint(const unsigned char *buffer, unsigned int pos, unsigned int &value)
+{
+    unsigned int byte = buffer[pos++];
+    value = byte & 0x7F;
+    int shift = 7;
+
+    while (byte & 0x80)
+    {
+        byte = buffer[pos++];
+        value |= (byte & 0x7F) << shift;
+        shift += 7;
+    }
+    return pos;
+}
+
+CompactGraph::CompactGraph(const City &city)
+    : nodeCount(city.getNodeCount()), arcCount(0), adjacencySize(0), weightBytes(2)
+{
+    zones = new int[nodeCount];
+    offsets = new unsigned int[nodeCount + 1];
+
+    // First pass: count roads and pick the distance width
+    int maxDegree = 0;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        int degree = city.getRoadCount(u);
+        zones[u] = city.getZone(u);
+        if (degree < 0)
+        {
+            continue;
+        }
+        arcCount += degree;
+        if (degree > maxDegree)
+        {
+            maxDegree = degree;
+        }
+    }
+
+    int *neighbors = new int[maxDegree > 0 ? maxDegree : 1];
+    int *distances = new int[maxDegree > 0 ? maxDegree : 1];
+    EncodedRoad *sorted = new EncodedRoad[maxDegree > 0 ? maxDegree : 1];
+
+    for (int u = 0; u < nodeCount; u++)
+    {
+        int degree = city.getRoads(u, neighbors, distances);
+        for (int i = 0; i < degree; i++)
+        {
+            if (distances[i] > MAX_16BIT_DISTANCE)
+            {
+                weightBytes = 4;
+            }
+        }
+    }
+
+    // Second pass: encode into a worst-case buffer, then shrink to fit
+    unsigned char *buffer = new unsigned char[(size_t)arcCount * (5 + weightBytes) + 1];
+    unsigned int pos = 0;
+
+    for (int u = 0; u < nodeCount; u++)
+    {
+        offsets[u] = pos;
+        int degree = city.getRoads(u, neighbors, distances);
+
+        for (int i = 0; i < degree; i++)
+        {
+            sorted[i].toNodeId = neighbors[i];
+            sorted[i].distance = distances[i];
+        }
+        sort(sorted, sorted + (degree > 0 ? degree : 0), roadLess);
+
+        int previous = u;
+        for (int i = 0; i < degree; i++)
+        {
+            if (i == 0)
+            {
+                pos = writeVarint(buffer, pos, zigZagEncode(sorted[i].toNodeId - u));
+            }
+            else
+            {
+                pos = writeVarint(buffer, pos, (unsigned int)(sorted[i].toNodeId - previous));
+            }
+            previous = sorted[i].toNodeId;
+
+            unsigned int weight = (unsigned int)sorted[i].distance;
+            for (int b = 0; b < weightBytes; b++)
+            {
+                buffer[pos++] = (unsigned char)(weight >> (8 * b));
+            }
+        }
+    }
+    offsets[nodeCount] = pos;
+
+    adjacencySize = pos;
+    adjacency = new unsigned char[adjacencySize > 0 ? adjacencySize : 1];
+    for (unsigned int i = 0; i < adjacencySize; i++)
+    {
+        adjacency[i] = buffer[i];
+    }
+
+    delete[] buffer;
+    delete[] sorted;
+    delete[] neighbors;
+    delete[] distances;
+}
+
+CompactGraph::~CompactGraph()
+{
+    delete[] zones;
+    delete[] offsets;
+    delete[] adjacency;
+}
+
+int CompactGraph::getNodeCount() const
+{
+    return nodeCount;
+}
+
+int CompactGraph::getRoadCount() const
+{
+    return arcCount / 2;
+}
+
+int CompactGraph::getZone(int nodeId) const
+{
+    if (nodeId < 0 || nodeId >= nodeCount)
+    {
+        return -1;
+    }
+    return zones[nodeId];
+}
+
+int CompactGraph::getRoads(int nodeId, int *neighborArray, int *distanceArray) const
+{
+    if (nodeId < 0 || nodeId >= nodeCount)
+    {
+        return -1;
+    }
+
+    unsigned int pos = offsets[nodeId];
+    unsigned int end = offsets[nodeId + 1];
+    int count = 0;
+    int neighbor = nodeId;
+
+    while (pos < end)
+    {
+        unsigned int delta;
+        pos = readVarint(adjacency, pos, delta);
+        neighbor = (count == 0) ? nodeId + zigZagDecode(delta) : neighbor + (int)delta;
+
+        unsigned int weight = adjacency[pos] | (adjacency[pos + 1] << 8);
+        if (weightBytes == 4)
+        {
+            weight |= (adjacency[pos + 2] << 16) | ((unsigned int)adjacency[pos + 3] << 24);
+        }
+        pos += weightBytes;
+
+        neighborArray[count] = neighbor;
+        distanceArray[count] = (int)weight;
+        count++;
+    }
+    return count;
+}
+
+City::ShortestPathResult CompactGraph::dijkstra(int source) const
+{
+    City::ShortestPathResult result(nodeCount);
+
+    if (source < 0 || source >= nodeCount)
+    {
+        cout << "Error: Source node " << source << " does not exist!" << endl;
+        return result;
+    }
+
+    MinHeap heap(nodeCount > 0 ? nodeCount : 1);
+    result.distances[source] = 0;
+    heap.push(0, source);
+
+    int distance, u;
+    while (heap.pop(distance, u))
+    {
+        if (distance > result.distances[u])
+        {
+            continue; // Stale heap entry
+        }
+
+        // Fast decode path: walk the byte stream without materializing arrays
+        unsigned int pos = offsets[u];
+        unsigned int end = offsets[u + 1];
+        bool first = true;
+        int v = u;
+
+        while (pos < end)
+        {
+            unsigned int delta;
+            pos = readVarint(adjacency, pos, delta);
+            v = first ? u + zigZagDecode(delta) : v + (int)delta;
+            first = false;
+
+            int weight = adjacency[pos] | (adjacency[pos + 1] << 8);
+            if (weightBytes == 4)
+            {
+                weight |= (adjacency[pos + 2] << 16) | ((int)adjacency[pos + 3] << 24);
+            }
+            pos += weightBytes;
+
+            int newDistance = distance + weight;
+            if (newDistance < result.distances[v])
+            {
+                result.distances[v] = newDistance;
+                result.predecessors[v] = u;
+                heap.push(newDistance, v);
+            }
+        }
+    }
+
+    return result;
+}
+
+int CompactGraph::getShortestDistance(int source, int destination) const
+{
+    if (source < 0 || source >= nodeCount || destination < 0 || destination >= nodeCount)
+    {
+        return -1;
+    }
+
+    int *distances = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        distances[i] = INT_MAX;
+    }
+
+    MinHeap heap(64);
+    distances[source] = 0;
+    heap.push(0, source);
+
+    int answer = -1;
+    int distance, u;
+    while (heap.pop(distance, u))
+    {
+        if (distance > distances[u])
+        {
+            continue;
+        }
+        if (u == destination)
+        {
+            answer = distance;
+            break;
+        }
+
+        unsigned int pos = offsets[u];
+        unsigned int end = offsets[u + 1];
+        bool first = true;
+        int v = u;
+
+        while (pos < end)
+        {
+            unsigned int delta;
+            pos = readVarint(adjacency, pos, delta);
+            v = first ? u + zigZagDecode(delta) : v + (int)delta;
+            first = false;
+
+            int weight = adjacency[pos] | (adjacency[pos + 1] << 8);
+            if (weightBytes == 4)
+            {
+                weight |= (adjacency[pos + 2] << 16) | ((int)adjacency[pos + 3] << 24);
+            }
+            pos += weightBytes;
+
+            if (distance + weight < distances[v])
+            {
+                distances[v] = distance + weight;
+                heap.push(distances[v], v);
+            }
+        }
+    }
+
+    delete[] distances;
+    return answer;
+}
+
+long long CompactGraph::getMemoryBytes() const
+{
+    return (long long)adjacencySize +
+           (long long)(nodeCount + 1) * sizeof(unsigned int) +
+           (long long)nodeCount * sizeof(int);
+}
+
+double CompactGraph::getBytesPerRoad() const
+{
+    int roads = getRoadCount();
+    if (roads == 0)
+    {
+        return 0.0;
+    }
+    return (double)getMemoryBytes() / roads;
+}
+
+void CompactGraph::printMemoryReport(const City &city) const
+{
+    long long cityBytes = city.getAdjacencyBytes();
+    int roads = getRoadCount();
+    double cityPerRoad = roads == 0 ? 0.0 : (double)cityBytes / roads;
+
+    cout << "\n=== Compact Graph Memory Report ===" << endl;
+    cout << "Locations: " << nodeCount << ", Roads: " << roads << endl;
+    cout << "Distance width: " << (weightBytes * 8) << " bits" << endl;
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << fixed << setprecision(2);
+    cout << "City layout:    " << cityBytes << " bytes (" << cityPerRoad << " bytes/road)" << endl;
+    cout << "Compact layout: " << getMemoryBytes() << " bytes (" << getBytesPerRoad() << " bytes/road)" << endl;
+    if (getMemoryBytes() > 0)
+    {
+        cout << "Reduction: " << (double)cityBytes / getMemoryBytes() << "x" << endl;
+    }
+    cout.flags(flags);
+    cout.precision(precision);
+    cout << "===================================" << endl;
+}
@@ -0,0 +1,308 @@
+#include "DispatchWorker.h"
+#include <iostream>
+#include <memory>
+
+using namespace std;
+
+const int IDLE_SPINS = 64; // Polls before the dispatcher goes to sleep
+
+// ==================== TripHandle Implementation ====================
+
+TripHandle::TripHandle() : worker(nullptr) {}
+
+TripHandle::TripHandle(shared_ptr<State> sharedState, DispatchWorker *owner)
+    : state(sharedState), worker(owner) {}
+
+bool TripHandle::isValid() const
+{
+    return state != nullptr && worker != nullptr;
+}
+
+bool TripHandle::isReady() const
+{
+    return isValid() && state->result.wait_for(chrono::seconds(0)) == future_status::ready;
+}
+
+bool TripHandle::waitFor(int milliseconds) const
+{
+    return isValid() && state->result.wait_for(chrono::milliseconds(milliseconds)) == future_status::ready;
+}
+
+TripRequestResult TripHandle::get() const
+{
+    if (!isValid())
+    {
+        return TripRequestResult();
+    }
+    return state->result.get();
+}
+
+int TripHandle::getTripId() const
+{
+    return isValid() ? state->tripId.load() : -1;
+}
+
+future<bool> TripHandle::cancel()
+{
+    shared_ptr<promise<bool>> answer = make_shared<promise<bool>>();
+    future<bool> cancelled = answer->get_future();
+
+    if (!isValid())
+    {
+        answer->set_value(false);
+        return cancelled;
+    }
+
+    state->cancelRequested.store(true);
+
+    // Queued behind the request itself, so it runs after dispatch or after the skip
+    shared_ptr<State> shared = state;
+    worker->submitTask([shared, answer](DispatchEngine &engine)
+                       {
+        if (!shared->dispatched.load())
+        {
+            answer->set_value(true); // Never dispatched
+            return;
+        }
+        int tripId = shared->tripId.load();
+        answer->set_value(tripId != -1 && engine.cancelTrip(tripId)); });
+
+    return cancelled;
+}
+
+// ==================== DispatchWorker Implementation ====================
+
+DispatchWorker::DispatchWorker(DispatchEngine &engineRef)
+    : engine(engineRef), running(false), pending(0), sleeping(false), processed(0) {}
+
+DispatchWorker::~DispatchWorker()
+{
+    stop();
+
+    // Commands submitted after stop are executed here so no promise is left broken
+    drain();
+}
+
+void DispatchWorker::start()
+{
+    if (running.exchange(true))
+    {
+        return; // Already running
+    }
+    thread = std::thread(&DispatchWorker::run, this);
+    cout << "Dispatch worker started." << endl;
+}
+
+void DispatchWorker::stop()
+{
+    if (!running.exchange(false))
+    {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        wakeup.notify_one();
+    }
+    thread.join();
+    cout << "Dispatch worker stopped after " << processed.load() << " commands." << endl;
+}
+
+bool DispatchWorker::isRunning() const
+{
+    return running.load();
+}
+
+int DispatchWorker::drain()
+{
+    int count = 0;
+    while (pending.load() > 0)
+    {
+        QueueNode *node = queue.pop();
+        if (node == nullptr)
+        {
+            // A producer is between its exchange and link; it finishes shortly
+            this_thread::yield();
+            continue;
+        }
+
+        Command *command = static_cast<Command *>(node);
+        command->run(engine);
+        delete command;
+
+        pending.fetch_sub(1);
+        processed.fetch_add(1);
+        count++;
+    }
+    return count;
+}
+
+void DispatchWorker::run()
+{
+    int idle = 0;
+    while (running.load())
+    {
+        if (drain() > 0)
+        {
+            idle = 0;
+            continue;
+        }
+
+        if (++idle < IDLE_SPINS)
+        {
+            this_thread::yield();
+            continue;
+        }
+
+        // Sleep until a producer observes sleeping and signals
+        unique_lock<mutex> lock(sleepMutex);
+        sleeping.store(true);
+        wakeup.wait(lock, [this]
+                    { return pending.load() > 0 || !running.load(); });
+        sleeping.store(false);
+        idle = 0;
+    }
+
+    drain(); // Finish whatever was queued before stop
+}
+
+void DispatchWorker::enqueue(Command *command)
+{
+    queue.push(command);
+    pending.fetch_add(1);
+
+    if (sleeping.load())
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        wakeup.notify_one();
+    }
+}
+
+TripRequestResult DispatchWorker::executeRequest(DispatchEngine &engine, const Rider &rider)
+{
+    TripRequestResult result;
+    Trip *trip = engine.requestTrip(rider);
+    if (trip != nullptr)
+    {
+        result.tripId = trip->getId();
+        result.driverId = trip->getDriverId();
+        result.state = trip->getState();
+        result.fare = trip->getFare();
+    }
+    return result;
+}
+
+future<TripRequestResult> DispatchWorker::submitTripRequest(const Rider &rider)
+{
+    shared_ptr<promise<TripRequestResult>> result = make_shared<promise<TripRequestResult>>();
+    int riderId = rider.getId();
+    int pickup = rider.getPickupLocation();
+    int dropoff = rider.getDropoffLocation();
+
+    Command *command = new Command();
+    command->run = [result, riderId, pickup, dropoff](DispatchEngine &target)
+    {
+        Rider request(riderId, pickup, dropoff);
+        result->set_value(executeRequest(target, request));
+    };
+
+    future<TripRequestResult> answer = result->get_future();
+    enqueue(command);
+    return answer;
+}
+
+void DispatchWorker::submitTripRequest(const Rider &rider, TripRequestCallback callback, void *context)
+{
+    int riderId = rider.getId();
+    int pickup = rider.getPickupLocation();
+    int dropoff = rider.getDropoffLocation();
+
+    Command *command = new Command();
+    command->run = [callback, context, riderId, pickup, dropoff](DispatchEngine &target)
+    {
+        Rider request(riderId, pickup, dropoff);
+        TripRequestResult result = executeRequest(target, request);
+        if (callback != nullptr)
+        {
+            callback(result, context);
+        }
+    };
+    enqueue(command);
+}
+
+TripHandle DispatchWorker::requestTripAsync(const Rider &rider, TripContinuation onReady)
+{
+    shared_ptr<TripHandle::State> state = make_shared<TripHandle::State>();
+    int riderId = rider.getId();
+    int pickup = rider.getPickupLocation();
+    int dropoff = rider.getDropoffLocation();
+
+    Command *command = new Command();
+    command->run = [state, onReady, riderId, pickup, dropoff](DispatchEngine &target)
+    {
+        TripRequestResult result; // Defaults to rejected / CANCELLED
+        if (!state->cancelRequested.load())
+        {
+            Rider request(riderId, pickup, dropoff);
+            result = executeRequest(target, request);
+            state->tripId.store(result.tripId);
+            state->dispatched.store(true);
+        }
+
+        state->promise.set_value(result);
+        if (onReady)
+        {
+            onReady(result);
+        }
+    };
+
+    enqueue(command);
+    return TripHandle(state, this);
+}
+
+future<bool> DispatchWorker::submitStartTrip(int tripId)
+{
+    shared_ptr<promise<bool>> result = make_shared<promise<bool>>();
+    Command *command = new Command();
+    command->run = [result, tripId](DispatchEngine &target)
+    { result->set_value(target.startTrip(tripId)); };
+
+    future<bool> answer = result->get_future();
+    enqueue(command);
+    return answer;
+}
+
+future<bool> DispatchWorker::submitCompleteTrip(int tripId)
+{
+    shared_ptr<promise<bool>> result = make_shared<promise<bool>>();
+    Command *command = new Command();
+    command->run = [result, tripId](DispatchEngine &target)
+    { result->set_value(target.completeTrip(tripId)); };
+
+    future<bool> answer = result->get_future();
+    enqueue(command);
+    return answer;
+}
+
+future<bool> DispatchWorker::submitCancelTrip(int tripId)
+{
+    shared_ptr<promise<bool>> result = make_shared<promise<bool>>();
+    Command *command = new Command();
+    command->run = [result, tripId](DispatchEngine &target)
+    { result->set_value(target.cancelTrip(tripId)); };
+
+    future<bool> answer = result->get_future();
+    enqueue(command);
+    return answer;
+}
+
+void DispatchWorker::submitTask(function<void(DispatchEngine &)> task)
+{
+    Command *command = new Command();
+    command->run = task;
+    enqueue(command);
+}
+
+long long DispatchWorker::getProcessedCount() const
+{
+    return processed.load();
+}
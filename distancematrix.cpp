@@ -0,0 +1,520 @@
+#include "DistanceMatrix.h"
+#include "Citydj.h"
+#include "MinHeap.h"
+#include <iostream>
+#include <climits>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+const int BLOCK = DistanceMatrix::BLOCK;
+
+// Floyd-Warshall takes about n^3 vectorized steps and per-source Dijkstra
+// about n * roadEntries * log2(n) scalar ones. Floyd-Warshall wins once
+// roadEntries * log2(n) * this factor reaches n^2 (measured with
+// bench_distancematrix: degree ~15 at 1600 locations, ~6 at 576)
+const int FLOYD_WARSHALL_DENSITY_FACTOR = 10;
+
+/**
+ * @brief Unreachable marker of each entry type
+ */
+template <class T>
+struct Unreachable;
+
+template <>
+struct Unreachable<uint16_t>
+{
+    static const int VALUE = DistanceMatrix::NARROW_UNREACHABLE;
+};
+
+template <>
+struct Unreachable<int32_t>
+{
+    static const int VALUE = DistanceMatrix::WIDE_UNREACHABLE;
+};
+
+/**
+ * @brief Runs work(begin, end) over count items split into contiguous ranges, one per thread
+ */
+template <class Work>
+static void forEachRange(int count, int threadCount, Work work)
+{
+    int chunks = threadCount < count ? threadCount : count;
+    if (chunks <= 1)
+    {
+        work(0, count);
+        return;
+    }
+
+    // Range 0 runs on the calling thread
+    thread *workers = new thread[chunks - 1];
+    for (int c = 1; c < chunks; c++)
+    {
+        workers[c - 1] = thread(work, (int)((long long)count * c / chunks),
+                                (int)((long long)count * (c + 1) / chunks));
+    }
+    work(0, (int)((long long)count / chunks));
+    for (int c = 1; c < chunks; c++)
+    {
+        workers[c - 1].join();
+    }
+    delete[] workers;
+}
+
+/**
+ * @brief cRow = min(cRow, viaK + bRow) over one tile row
+ *
+ * Fixed trip count, restrict-qualified rows and arithmetic in the entry
+ * type, so it compiles to vector adds and mins on 8 (16-bit) or 4 (32-bit)
+ * entries per 16-byte vector. 16-bit sums saturate to NARROW_UNREACHABLE.
+ */
+static inline void relaxRow(uint16_t *__restrict cRow, const uint16_t *__restrict bRow, uint16_t viaK)
+{
+    for (int j = 0; j < BLOCK; j++)
+    {
+        uint16_t through = (uint16_t)(viaK + bRow[j]);
+        through = through < viaK ? (uint16_t)DistanceMatrix::NARROW_UNREACHABLE : through;
+        // min written as c - (c > t ? c - t : 0), which maps to an unsigned
+        // saturating subtract; SSE2 has no 16-bit unsigned min
+        uint16_t excess = cRow[j] > through ? (uint16_t)(cRow[j] - through) : 0;
+        cRow[j] = (uint16_t)(cRow[j] - excess);
+    }
+}
+
+static inline void relaxRow(int32_t *__restrict cRow, const int32_t *__restrict bRow, int32_t viaK)
+{
+    for (int j = 0; j < BLOCK; j++)
+    {
+        int32_t through = viaK + bRow[j]; // Both at most WIDE_UNREACHABLE, so no overflow
+        cRow[j] = through < cRow[j] ? through : cRow[j];
+    }
+}
+
+/**
+ * @brief c = min(c, a + b) over one tile, through each k of the tile in turn
+ *
+ * a, b and c may be the same tile, as in the diagonal, row and column steps
+ * of a round. When c is b, row k of it is read while the other rows are
+ * written and is skipped itself: it would be relaxed through a[k][k] = 0,
+ * which changes nothing. So the rows passed to relaxRow never overlap.
+ */
+template <class T>
+static void relaxTile(T *c, const T *a, const T *b, int stride)
+{
+    bool sharesRows = c == b;
+    for (int k = 0; k < BLOCK; k++)
+    {
+        const T *bRow = b + (long long)k * stride;
+        for (int i = 0; i < BLOCK; i++)
+        {
+            if (sharesRows && i == k)
+                continue;
+            relaxRow(c + (long long)i * stride, bRow, a[(long long)i * stride + k]);
+        }
+    }
+}
+
+// ==================== DistanceMatrix Implementation ====================
+
+DistanceMatrix::DistanceMatrix(const City *cityPtr, DistanceMatrixMethod buildMethod, int threads)
+    : city(cityPtr), method(buildMethod), usedMethod(buildMethod), threadCount(1),
+      nodeCount(0), stride(0), narrow(nullptr), wide(nullptr), stale(true),
+      buildCount(0), lastBuildMillis(0.0)
+{
+    if (threads == 0)
+    {
+        threads = (int)thread::hardware_concurrency();
+    }
+    threadCount = threads > 0 ? threads : 1;
+}
+
+DistanceMatrix::~DistanceMatrix()
+{
+    release();
+}
+
+void DistanceMatrix::release()
+{
+    delete[] narrow;
+    delete[] wide;
+    narrow = nullptr;
+    wide = nullptr;
+    nodeCount = 0;
+    stride = 0;
+}
+
+void DistanceMatrix::invalidate()
+{
+    stale = true;
+}
+
+void DistanceMatrix::refresh()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+}
+
+void DistanceMatrix::rebuild()
+{
+    auto begin = chrono::steady_clock::now();
+    release();
+
+    nodeCount = city->getNodeCount();
+    stride = (nodeCount + BLOCK - 1) / BLOCK * BLOCK;
+
+    // Roads in compressed rows, read once instead of per search or per pass
+    int *offsets = new int[nodeCount + 1];
+    offsets[0] = 0;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        int degree = city->getRoadCount(u);
+        offsets[u + 1] = offsets[u] + (degree > 0 ? degree : 0);
+    }
+    int roadEntries = offsets[nodeCount];
+    int *targets = new int[roadEntries > 0 ? roadEntries : 1];
+    int *weights = new int[roadEntries > 0 ? roadEntries : 1];
+    for (int u = 0; u < nodeCount; u++)
+    {
+        if (offsets[u + 1] > offsets[u])
+        {
+            city->getRoads(u, targets + offsets[u], weights + offsets[u]);
+        }
+    }
+
+    usedMethod = method;
+    if (usedMethod == MATRIX_AUTO)
+    {
+        int log2Nodes = 1;
+        while ((1 << log2Nodes) < nodeCount)
+        {
+            log2Nodes++;
+        }
+        bool dense = (long long)roadEntries * log2Nodes * FLOYD_WARSHALL_DENSITY_FACTOR >=
+                     (long long)nodeCount * nodeCount;
+        usedMethod = dense ? MATRIX_FLOYD_WARSHALL : MATRIX_DIJKSTRA;
+    }
+
+    long long entryCount = (long long)stride * stride;
+    narrow = new uint16_t[entryCount > 0 ? entryCount : 1];
+    if (!build(narrow, offsets, targets, weights))
+    {
+        // Some distance needs more than 16 bits
+        delete[] narrow;
+        narrow = nullptr;
+        wide = new int32_t[entryCount > 0 ? entryCount : 1];
+        build(wide, offsets, targets, weights);
+    }
+
+    delete[] offsets;
+    delete[] targets;
+    delete[] weights;
+
+    stale = false;
+    buildCount++;
+    lastBuildMillis = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+}
+
+template <class T>
+bool DistanceMatrix::build(T *entries, const int *offsets, const int *targets, const int *weights)
+{
+    const int unreachable = Unreachable<T>::VALUE;
+    long long entryCount = (long long)stride * stride;
+    for (long long i = 0; i < entryCount; i++)
+    {
+        entries[i] = (T)unreachable;
+    }
+
+    if (usedMethod == MATRIX_FLOYD_WARSHALL)
+    {
+        for (int u = 0; u < nodeCount; u++)
+        {
+            T *row = entries + (long long)u * stride;
+            row[u] = 0;
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int v = targets[e];
+                // Longer roads start out unreachable; the final check catches them
+                if (v >= 0 && v < nodeCount && weights[e] < row[v])
+                {
+                    row[v] = (T)weights[e];
+                }
+            }
+        }
+        runFloydWarshall(entries);
+    }
+    else
+    {
+        runDijkstra(entries, offsets, targets, weights);
+    }
+
+    return coversComponents(entries);
+}
+
+template <class T>
+void DistanceMatrix::runFloydWarshall(T *entries)
+{
+    int tiles = stride / BLOCK;
+    int tileStride = stride;
+
+    // Top-left corner of tile (row, column)
+    auto tile = [entries, tileStride](int row, int column)
+    {
+        return entries + (long long)row * BLOCK * tileStride + (long long)column * BLOCK;
+    };
+
+    for (int kb = 0; kb < tiles; kb++)
+    {
+        T *diagonal = tile(kb, kb);
+        relaxTile(diagonal, diagonal, diagonal, stride);
+
+        for (int t = 0; t < tiles; t++)
+        {
+            if (t != kb)
+            {
+                relaxTile(tile(kb, t), diagonal, tile(kb, t), stride); // Row kb
+                relaxTile(tile(t, kb), tile(t, kb), diagonal, stride); // Column kb
+            }
+        }
+
+        // Every other tile depends only on row and column kb
+        forEachRange(tiles, threadCount, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; i++)
+            {
+                if (i == kb)
+                    continue;
+                for (int j = 0; j < tiles; j++)
+                {
+                    if (j != kb)
+                    {
+                        relaxTile(tile(i, j), tile(i, kb), tile(kb, j), stride);
+                    }
+                }
+            }
+        });
+    }
+}
+
+template <class T>
+void DistanceMatrix::runDijkstra(T *entries, const int *offsets, const int *targets, const int *weights)
+{
+    const int unreachable = Unreachable<T>::VALUE;
+
+    forEachRange(nodeCount, threadCount, [&](int begin, int end)
+    {
+        int *distance = new int[nodeCount];
+        MinHeap heap(64);
+
+        for (int source = begin; source < end; source++)
+        {
+            for (int i = 0; i < nodeCount; i++)
+            {
+                distance[i] = INT_MAX;
+            }
+            distance[source] = 0;
+            heap.push(0, source);
+
+            int d, u;
+            while (heap.pop(d, u))
+            {
+                if (d > distance[u])
+                {
+                    continue;
+                }
+                for (int e = offsets[u]; e < offsets[u + 1]; e++)
+                {
+                    int v = targets[e];
+                    if (v >= 0 && v < nodeCount && d + weights[e] < distance[v])
+                    {
+                        distance[v] = d + weights[e];
+                        heap.push(distance[v], v);
+                    }
+                }
+            }
+
+            // Distances that don't fit T stay unreachable; the final check catches them
+            T *row = entries + (long long)source * stride;
+            for (int i = 0; i < nodeCount; i++)
+            {
+                row[i] = (T)(distance[i] < unreachable ? distance[i] : unreachable);
+            }
+        }
+        delete[] distance;
+    });
+}
+
+template <class T>
+bool DistanceMatrix::coversComponents(const T *entries) const
+{
+    const int unreachable = Unreachable<T>::VALUE;
+
+    int *labels = new int[nodeCount > 0 ? nodeCount : 1];
+    int *sizes = new int[nodeCount > 0 ? nodeCount : 1];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        sizes[i] = 0;
+    }
+    for (int i = 0; i < nodeCount; i++)
+    {
+        labels[i] = city->getComponentId(i);
+        if (labels[i] >= 0 && labels[i] < nodeCount)
+        {
+            sizes[labels[i]]++;
+        }
+    }
+
+    bool covered = true;
+    for (int i = 0; i < nodeCount && covered; i++)
+    {
+        if (labels[i] < 0 || labels[i] >= nodeCount)
+            continue;
+        const T *row = entries + (long long)i * stride;
+        int reached = 0;
+        for (int j = 0; j < nodeCount; j++)
+        {
+            reached += row[j] < unreachable;
+        }
+        covered = reached == sizes[labels[i]];
+    }
+
+    delete[] labels;
+    delete[] sizes;
+    return covered;
+}
+
+template <class T>
+bool DistanceMatrix::relaxThrough(T *entries, int from, int to, int distance)
+{
+    const int unreachable = Unreachable<T>::VALUE;
+
+    // A shortest path uses the new road at most once, so one pass over the
+    // old distances to and from its endpoints is enough
+    int *viaFrom = new int[nodeCount];
+    int *viaTo = new int[nodeCount];
+    for (int j = 0; j < nodeCount; j++)
+    {
+        viaFrom[j] = entries[(long long)from * stride + j];
+        viaTo[j] = entries[(long long)to * stride + j];
+    }
+
+    bool fits = true;
+    for (int i = 0; i < nodeCount && fits; i++)
+    {
+        // Roads are undirected, so row i's distance to an endpoint is its column entry
+        int toFrom = viaFrom[i];
+        int toTo = viaTo[i];
+        if (toFrom >= unreachable && toTo >= unreachable)
+            continue;
+
+        T *row = entries + (long long)i * stride;
+        for (int j = 0; j < nodeCount; j++)
+        {
+            long long best = LLONG_MAX;
+            if (toFrom < unreachable && viaTo[j] < unreachable)
+            {
+                long long through = (long long)toFrom + distance + viaTo[j];
+                best = through < best ? through : best;
+            }
+            if (toTo < unreachable && viaFrom[j] < unreachable)
+            {
+                long long through = (long long)toTo + distance + viaFrom[j];
+                best = through < best ? through : best;
+            }
+            if (best < row[j] && best < unreachable)
+            {
+                row[j] = (T)best;
+            }
+            else if (best != LLONG_MAX && row[j] == unreachable)
+            {
+                fits = false; // Newly connected, but too far for T
+                break;
+            }
+        }
+    }
+
+    delete[] viaFrom;
+    delete[] viaTo;
+    return fits;
+}
+
+int DistanceMatrix::getDistance(int from, int to)
+{
+    refresh();
+    if (from < 0 || from >= nodeCount || to < 0 || to >= nodeCount)
+    {
+        return -1;
+    }
+
+    long long index = (long long)from * stride + to;
+    if (narrow != nullptr)
+    {
+        return narrow[index] == NARROW_UNREACHABLE ? -1 : narrow[index];
+    }
+    return wide[index] == WIDE_UNREACHABLE ? -1 : wide[index];
+}
+
+void DistanceMatrix::onRoadAdded(int from, int to, int distance)
+{
+    if (stale)
+    {
+        return; // Rebuilt on the next query anyway
+    }
+    if (from < 0 || from >= nodeCount || to < 0 || to >= nodeCount)
+    {
+        stale = true;
+        return;
+    }
+
+    bool fits = narrow != nullptr ? relaxThrough(narrow, from, to, distance)
+                                  : relaxThrough(wide, from, to, distance);
+    if (!fits)
+    {
+        stale = true; // Rebuilt with wider entries
+    }
+}
+
+bool DistanceMatrix::isNarrow() const
+{
+    return narrow != nullptr;
+}
+
+DistanceMatrixMethod DistanceMatrix::getUsedMethod() const
+{
+    return usedMethod;
+}
+
+long long DistanceMatrix::getMemoryBytes() const
+{
+    long long entryCount = (long long)stride * stride;
+    if (narrow != nullptr)
+    {
+        return entryCount * (long long)sizeof(uint16_t);
+    }
+    if (wide != nullptr)
+    {
+        return entryCount * (long long)sizeof(int32_t);
+    }
+    return 0;
+}
+
+void DistanceMatrix::printStats() const
+{
+    cout << "\n=== Distance Matrix ===" << endl;
+    if (narrow == nullptr && wide == nullptr)
+    {
+        cout << "Not built yet." << endl;
+    }
+    else
+    {
+        cout << "Locations: " << nodeCount << " (rows padded to " << stride << ")" << endl;
+        cout << "Entries: " << (narrow != nullptr ? 16 : 32) << "-bit, "
+             << getMemoryBytes() / 1024 << " KB" << endl;
+        cout << "Built with: " << (usedMethod == MATRIX_FLOYD_WARSHALL ? "blocked Floyd-Warshall" : "per-source Dijkstra")
+             << " on " << threadCount << " thread(s), " << buildCount << " build(s), last took "
+             << lastBuildMillis << " ms" << endl;
+    }
+    cout << "=======================" << endl;
+}
@@ -0,0 +1,386 @@
+#include "DistanceTreeCache.h"
+#include "MinHeap.h"
+#include <iostream>
+#include <climits>
+
+using namespace std;
+
+// ==================== DistanceTreeCache Implementation ====================
+
+DistanceTreeCache::DistanceTreeCache(const City *cityPtr, int treeLimit)
+    : city(cityPtr), maxTrees(treeLimit > 0 ? treeLimit : 1), treeCount(0), nodeCount(0),
+      useClock(0), affected(nullptr), affectStamp(0), childHead(nullptr),
+      childNext(nullptr), pending(nullptr), scratchNeighbors(nullptr),
+      scratchDistances(nullptr), scratchCapacity(0),
+      hits(0), misses(0), repairs(0), repairedNodes(0)
+{
+    sources = new int[maxTrees];
+    distances = new int *[maxTrees];
+    parents = new int *[maxTrees];
+    lastUsed = new long long[maxTrees];
+    for (int t = 0; t < maxTrees; t++)
+    {
+        distances[t] = nullptr;
+        parents[t] = nullptr;
+    }
+}
+
+DistanceTreeCache::~DistanceTreeCache()
+{
+    invalidate();
+    delete[] sources;
+    delete[] distances;
+    delete[] parents;
+    delete[] lastUsed;
+    delete[] affected;
+    delete[] childHead;
+    delete[] childNext;
+    delete[] pending;
+    delete[] scratchNeighbors;
+    delete[] scratchDistances;
+}
+
+int DistanceTreeCache::loadRoads(int nodeId)
+{
+    int degree = city->getRoadCount(nodeId);
+    if (degree > scratchCapacity)
+    {
+        delete[] scratchNeighbors;
+        delete[] scratchDistances;
+        scratchCapacity = degree * 2;
+        scratchNeighbors = new int[scratchCapacity];
+        scratchDistances = new int[scratchCapacity];
+    }
+    return city->getRoads(nodeId, scratchNeighbors, scratchDistances);
+}
+
+void DistanceTreeCache::invalidate()
+{
+    for (int t = 0; t < treeCount; t++)
+    {
+        delete[] distances[t];
+        delete[] parents[t];
+        distances[t] = nullptr;
+        parents[t] = nullptr;
+    }
+    treeCount = 0;
+}
+
+void DistanceTreeCache::resizeToCity()
+{
+    nodeCount = city->getNodeCount();
+    delete[] affected;
+    delete[] childHead;
+    delete[] childNext;
+    delete[] pending;
+
+    int size = nodeCount > 0 ? nodeCount : 1;
+    affected = new int[size];
+    childHead = new int[size];
+    childNext = new int[size];
+    pending = new int[size];
+    for (int i = 0; i < size; i++)
+    {
+        affected[i] = 0;
+    }
+    affectStamp = 0;
+}
+
+int DistanceTreeCache::findTree(int source) const
+{
+    for (int t = 0; t < treeCount; t++)
+    {
+        if (sources[t] == source)
+        {
+            return t;
+        }
+    }
+    return -1;
+}
+
+int DistanceTreeCache::buildTree(int source)
+{
+    if (treeCount == 0 && nodeCount != city->getNodeCount())
+    {
+        resizeToCity();
+    }
+
+    int tree;
+    if (treeCount < maxTrees)
+    {
+        tree = treeCount++;
+        distances[tree] = new int[nodeCount > 0 ? nodeCount : 1];
+        parents[tree] = new int[nodeCount > 0 ? nodeCount : 1];
+    }
+    else
+    {
+        // Evict the least recently used tree
+        tree = 0;
+        for (int t = 1; t < treeCount; t++)
+        {
+            if (lastUsed[t] < lastUsed[tree])
+            {
+                tree = t;
+            }
+        }
+    }
+
+    sources[tree] = source;
+    int *distance = distances[tree];
+    int *parent = parents[tree];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        distance[i] = INT_MAX;
+        parent[i] = -1;
+    }
+    distance[source] = 0;
+
+    MinHeap heap(nodeCount > 0 ? nodeCount : 1);
+    heap.push(0, source);
+
+    int d, u;
+    while (heap.pop(d, u))
+    {
+        if (d > distance[u])
+        {
+            continue; // Stale entry
+        }
+
+        int degree = loadRoads(u);
+        for (int j = 0; j < degree; j++)
+        {
+            int v = scratchNeighbors[j];
+            if (d + scratchDistances[j] < distance[v])
+            {
+                distance[v] = d + scratchDistances[j];
+                parent[v] = u;
+                heap.push(distance[v], v);
+            }
+        }
+    }
+    return tree;
+}
+
+int DistanceTreeCache::getShortestDistance(int source, int destination)
+{
+    if (!city->locationExists(source))
+    {
+        cout << "Error: Source node " << source << " does not exist!" << endl;
+        return -1;
+    }
+    if (destination < 0 || destination >= city->getNodeCount())
+    {
+        return -1;
+    }
+
+    int tree = findTree(source);
+    if (tree == -1)
+    {
+        tree = buildTree(source);
+        misses++;
+    }
+    else
+    {
+        hits++;
+    }
+    lastUsed[tree] = ++useClock;
+
+    int distance = distances[tree][destination];
+    return distance == INT_MAX ? -1 : distance;
+}
+
+void DistanceTreeCache::onRoadsChanged(const City::RoadUpdate *updates, const int *oldDistances, int count)
+{
+    if (treeCount == 0)
+    {
+        return;
+    }
+    if (nodeCount != city->getNodeCount())
+    {
+        invalidate(); // Missed a new location; trees are the wrong size
+        return;
+    }
+
+    for (int t = 0; t < treeCount; t++)
+    {
+        repairTree(t, updates, oldDistances, count);
+    }
+}
+
+void DistanceTreeCache::repairTree(int tree, const City::RoadUpdate *updates,
+                                   const int *oldDistances, int count)
+{
+    int *distance = distances[tree];
+    int *parent = parents[tree];
+    MinHeap heap(16);
+    repairs++;
+
+    // ===== Longer or closed roads: invalidate the subtrees below tree edges =====
+    affectStamp++;
+    int pendingCount = 0;
+    bool childrenBuilt = false;
+
+    for (int i = 0; i < count; i++)
+    {
+        int newDistance = updates[i].distance;
+        int oldDistance = oldDistances[i];
+        bool longer = newDistance == City::ROAD_CLOSED ||
+                      (oldDistance != City::ROAD_CLOSED && newDistance > oldDistance);
+        if (!longer)
+        {
+            continue;
+        }
+
+        int ends[2] = {updates[i].from, updates[i].to};
+        for (int e = 0; e < 2; e++)
+        {
+            int child = ends[e];
+            int other = ends[1 - e];
+            if (parent[child] != other || affected[child] == affectStamp)
+            {
+                continue; // Not a tree edge, or already invalidated
+            }
+
+            if (!childrenBuilt)
+            {
+                for (int v = 0; v < nodeCount; v++)
+                {
+                    childHead[v] = -1;
+                }
+                for (int v = 0; v < nodeCount; v++)
+                {
+                    if (parent[v] != -1)
+                    {
+                        childNext[v] = childHead[parent[v]];
+                        childHead[parent[v]] = v;
+                    }
+                }
+                childrenBuilt = true;
+            }
+
+            // Collect the whole subtree into pending
+            int scan = pendingCount;
+            affected[child] = affectStamp;
+            pending[pendingCount++] = child;
+            while (scan < pendingCount)
+            {
+                int x = pending[scan++];
+                for (int c = childHead[x]; c != -1; c = childNext[c])
+                {
+                    if (affected[c] != affectStamp)
+                    {
+                        affected[c] = affectStamp;
+                        pending[pendingCount++] = c;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < pendingCount; i++)
+    {
+        distance[pending[i]] = INT_MAX;
+        parent[pending[i]] = -1;
+    }
+
+    // Re-seed each invalidated location from its best neighbor outside the subtree
+    for (int i = 0; i < pendingCount; i++)
+    {
+        int x = pending[i];
+        int degree = loadRoads(x);
+        for (int j = 0; j < degree; j++)
+        {
+            int y = scratchNeighbors[j];
+            if (affected[y] == affectStamp || distance[y] == INT_MAX)
+            {
+                continue;
+            }
+            if (distance[y] + scratchDistances[j] < distance[x])
+            {
+                distance[x] = distance[y] + scratchDistances[j];
+                parent[x] = y;
+            }
+        }
+        if (distance[x] != INT_MAX)
+        {
+            heap.push(distance[x], x);
+        }
+    }
+    repairedNodes += pendingCount;
+
+    // ===== Shorter or new roads: relax both endpoints =====
+    for (int i = 0; i < count; i++)
+    {
+        if (updates[i].distance == City::ROAD_CLOSED)
+        {
+            continue;
+        }
+
+        int a = updates[i].from;
+        int b = updates[i].to;
+        int road = city->getDistance(a, b); // Current value, in case of repeats in the batch
+        if (road == -1)
+        {
+            continue;
+        }
+        if (distance[a] != INT_MAX && distance[a] + road < distance[b])
+        {
+            distance[b] = distance[a] + road;
+            parent[b] = a;
+            heap.push(distance[b], b);
+        }
+        else if (distance[b] != INT_MAX && distance[b] + road < distance[a])
+        {
+            distance[a] = distance[b] + road;
+            parent[a] = b;
+            heap.push(distance[a], a);
+        }
+    }
+
+    // ===== Propagate: only locations whose distance drops are visited =====
+    int d, u;
+    while (heap.pop(d, u))
+    {
+        if (d > distance[u])
+        {
+            continue; // Stale entry
+        }
+        repairedNodes++;
+
+        int degree = loadRoads(u);
+        for (int j = 0; j < degree; j++)
+        {
+            int v = scratchNeighbors[j];
+            if (d + scratchDistances[j] < distance[v])
+            {
+                distance[v] = d + scratchDistances[j];
+                parent[v] = u;
+                heap.push(distance[v], v);
+            }
+        }
+    }
+}
+
+long long DistanceTreeCache::getHits() const
+{
+    return hits;
+}
+
+long long DistanceTreeCache::getMisses() const
+{
+    return misses;
+}
+
+long long DistanceTreeCache::getRepairedNodes() const
+{
+    return repairedNodes;
+}
+
+void DistanceTreeCache::printStats() const
+{
+    cout << "\n=== Distance Tree Cache ===" << endl;
+    cout << "Trees cached: " << treeCount << " / " << maxTrees << endl;
+    cout << "Hits: " << hits << ", Misses: " << misses << endl;
+    cout << "Repairs: " << repairs << ", Locations touched: " << repairedNodes << endl;
+    cout << "===========================" << endl;
+}
@@ -5,13 +5,15 @@ using namespace std;
 
 // ==================== Driver Implementation ====================
 
-Driver::Driver() : id(-1), currentLocation(-1), zoneId(-1), status(DRIVER_OFFLINE)
+Driver::Driver() : id(-1), currentLocation(-1), zoneId(-1), status(DRIVER_OFFLINE),
+                   rating(MAX_RATING)
 {
     // Default constructor creates an invalid driver
 }
 
 Driver::Driver(int driverId, int locationId, int zone)
-    : id(driverId), currentLocation(locationId), zoneId(zone), status(DRIVER_AVAILABLE)
+    : id(driverId), currentLocation(locationId), zoneId(zone), status(DRIVER_AVAILABLE),
+      rating(MAX_RATING)
 {
 
     // Validate input
@@ -100,6 +102,23 @@ void Driver::setStatus(DriverStatus newStatus)
          << statusToString(newStatus) << endl;
 }
 
+int Driver::getRating() const
+{
+    return rating;
+}
+
+void Driver::setRating(int tenths)
+{
+    if (tenths < MIN_RATING || tenths > MAX_RATING)
+    {
+        cout << "Error: Rating must be between " << MIN_RATING << " and "
+             << MAX_RATING << " tenths of a star!" << endl;
+        return;
+    }
+
+    rating = tenths;
+}
+
 bool Driver::isAvailable() const
 {
     return status == DRIVER_AVAILABLE;
@@ -112,6 +131,7 @@ void Driver::printInfo() const
     cout << "Current Location: " << currentLocation << endl;
     cout << "Zone: " << zoneId << endl;
     cout << "Status: " << statusToString(status) << endl;
+    cout << "Rating: " << rating / 10 << "." << rating % 10 << endl;
     cout << "Available: " << (isAvailable() ? "Yes" : "No") << endl;
     cout << "==========================" << endl;
 }
@@ -0,0 +1,213 @@
+#include "EngineSnapshot.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char IMAGE_MAGIC[8] = {'D', 'S', 'N', 'A', 'P', 'v', '0', '1'};
+const unsigned int BYTE_ORDER_MARK = 0x01020304u;
+
+/**
+ * @brief FNV-1a continued over another byte range
+ */
+static unsigned int checksumAdd(unsigned int hash, const void *data, size_t count)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < count; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes bytes and folds them into the running checksum
+ */
+static bool writeBytes(FILE *file, const void *data, size_t count, unsigned int &hash)
+{
+    hash = checksumAdd(hash, data, count);
+    return count == 0 || fwrite(data, 1, count, file) == count;
+}
+
+/**
+ * @brief Reads bytes and folds them into the running checksum
+ */
+static bool readBytes(FILE *file, void *data, size_t count, unsigned int &hash)
+{
+    if (count > 0 && fread(data, 1, count, file) != count)
+    {
+        return false;
+    }
+    hash = checksumAdd(hash, data, count);
+    return true;
+}
+
+// ==================== EngineImage Implementation ====================
+
+EngineImage::EngineImage(int drivers, int riders, int trips, int finished)
+    : lsn(0), nextTripId(0), tripIdStep(1), currentTime(0),
+      driverCount(drivers), riderCount(riders), tripCount(trips), historyCount(finished)
+{
+    for (int c = 0; c < DRIVER_COLUMN_COUNT; c++)
+    {
+        driverColumns[c] = new int[drivers > 0 ? drivers : 1];
+    }
+    for (int c = 0; c < RIDER_COLUMN_COUNT; c++)
+    {
+        riderColumns[c] = new int[riders > 0 ? riders : 1];
+    }
+    tripRows = new TripRecord[trips > 0 ? trips : 1];
+    for (int c = 0; c < HISTORY_COLUMN_COUNT; c++)
+    {
+        historyColumns[c] = new int[finished > 0 ? finished : 1];
+    }
+}
+
+EngineImage::~EngineImage()
+{
+    for (int c = 0; c < DRIVER_COLUMN_COUNT; c++)
+    {
+        delete[] driverColumns[c];
+    }
+    for (int c = 0; c < RIDER_COLUMN_COUNT; c++)
+    {
+        delete[] riderColumns[c];
+    }
+    delete[] tripRows;
+    for (int c = 0; c < HISTORY_COLUMN_COUNT; c++)
+    {
+        delete[] historyColumns[c];
+    }
+}
+
+bool EngineImage::write(const char *path) const
+{
+    // Write beside the target and rename, so a crash never leaves a half image
+    string tempPath = string(path) + ".tmp";
+    FILE *file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr)
+    {
+        cout << "Error: Cannot create snapshot file " << tempPath << "!" << endl;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    memset(header, 0, sizeof(header));
+    unsigned int formatVersion = 5;
+    int counts[7] = {nextTripId, tripIdStep, currentTime, driverCount, riderCount, tripCount,
+                     historyCount};
+    memcpy(header, IMAGE_MAGIC, 8);
+    memcpy(header + 8, &BYTE_ORDER_MARK, 4);
+    memcpy(header + 12, &formatVersion, 4);
+    memcpy(header + 16, &lsn, 8);
+    memcpy(header + 24, counts, sizeof(counts));
+
+    unsigned int hash = 2166136261u;
+    bool ok = writeBytes(file, header, sizeof(header), hash);
+    for (int c = 0; ok && c < DRIVER_COLUMN_COUNT; c++)
+    {
+        ok = writeBytes(file, driverColumns[c], (size_t)driverCount * sizeof(int), hash);
+    }
+    for (int c = 0; ok && c < RIDER_COLUMN_COUNT; c++)
+    {
+        ok = writeBytes(file, riderColumns[c], (size_t)riderCount * sizeof(int), hash);
+    }
+    ok = ok && writeBytes(file, tripRows, (size_t)tripCount * sizeof(TripRecord), hash);
+    for (int c = 0; ok && c < HISTORY_COLUMN_COUNT; c++)
+    {
+        ok = writeBytes(file, historyColumns[c], (size_t)historyCount * sizeof(int), hash);
+    }
+    ok = ok && fwrite(&hash, 1, sizeof(hash), file) == sizeof(hash);
+
+    ok = ok && fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    fclose(file);
+
+    error_code error;
+    if (ok)
+    {
+        filesystem::rename(tempPath, path, error);
+    }
+    if (!ok || error)
+    {
+        cout << "Error: Cannot write snapshot " << path << "!" << endl;
+        filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+EngineImage *EngineImage::read(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        cout << "Cannot load snapshot: " << path << " not found!" << endl;
+        return nullptr;
+    }
+
+    unsigned int hash = 2166136261u;
+    unsigned char header[HEADER_SIZE];
+    unsigned int byteOrder = 0;
+    unsigned int formatVersion = 0;
+    int counts[7] = {0, 0, 0, 0, 0, 0, 0};
+    bool ok = readBytes(file, header, sizeof(header), hash);
+    if (ok)
+    {
+        memcpy(&byteOrder, header + 8, 4);
+        memcpy(&formatVersion, header + 12, 4);
+        memcpy(counts, header + 24, sizeof(counts));
+        ok = memcmp(header, IMAGE_MAGIC, 8) == 0 && byteOrder == BYTE_ORDER_MARK &&
+             formatVersion == 5 && counts[3] >= 0 && counts[4] >= 0 && counts[5] >= 0 &&
+             counts[6] >= 0;
+    }
+    if (!ok)
+    {
+        cout << "Error: " << path << " is not a snapshot of this format or byte order!" << endl;
+        fclose(file);
+        return nullptr;
+    }
+
+    EngineImage *image = new EngineImage(counts[3], counts[4], counts[5], counts[6]);
+    memcpy(&image->lsn, header + 16, 8);
+    image->nextTripId = counts[0];
+    image->tripIdStep = counts[1];
+    image->currentTime = counts[2];
+
+    for (int c = 0; ok && c < DRIVER_COLUMN_COUNT; c++)
+    {
+        ok = readBytes(file, image->driverColumns[c], (size_t)image->driverCount * sizeof(int), hash);
+    }
+    for (int c = 0; ok && c < RIDER_COLUMN_COUNT; c++)
+    {
+        ok = readBytes(file, image->riderColumns[c], (size_t)image->riderCount * sizeof(int), hash);
+    }
+    ok = ok && readBytes(file, image->tripRows, (size_t)image->tripCount * sizeof(TripRecord), hash);
+    for (int c = 0; ok && c < HISTORY_COLUMN_COUNT; c++)
+    {
+        ok = readBytes(file, image->historyColumns[c], (size_t)image->historyCount * sizeof(int), hash);
+    }
+    unsigned int stored = 0;
+    ok = ok && fread(&stored, 1, sizeof(stored), file) == sizeof(stored) && stored == hash;
+    fclose(file);
+
+    if (!ok)
+    {
+        cout << "Error: Snapshot " << path << " is truncated or corrupt!" << endl;
+        delete image;
+        return nullptr;
+    }
+    return image;
+}
@@ -1,45 +1,25 @@
  #include <iostream>
-#include "Citydj.h"
+#include "DemoCity.h"
 #include "Driver.h"
 #include "Rider.h"
 #include "Trip.h"
 #include "DispatchEngine.h"
+#include "DispatchWorker.h"
 using namespace std;
-void setupCity(City &city)
-{
-    city.addLocation(0);
-    city.addLocation(1);
-    city.addLocation(2);
-    city.addLocation(3);
-    city.addLocation(4);
-    city.addLocation(5);
-
-    city.addRoad(0, 1, 5);
-    city.addRoad(0, 2, 10);
-    city.addRoad(1, 3, 3);
-    city.addRoad(2, 3, 7);
-    city.addRoad(3, 4, 4);
-    city.addRoad(4, 5, 6);
-
-    city.setZone(0, 1);
-    city.setZone(1, 1);
-    city.setZone(2, 2);
-    city.setZone(3, 2);
-    city.setZone(4, 3);
-    city.setZone(5, 3);
-}
 
 int main()
 {
-    City city;
-    setupCity(city);
-
-    DispatchEngine engine(&city);
+    // Distances were computed at compile time; nothing to build
+    DispatchEngine engine(&DEMO_CITY);
 
     // Register drivers (system side)
-    engine.registerDriver(new Driver(101, 0, 1));
-    engine.registerDriver(new Driver(102, 2, 2));
-    engine.registerDriver(new Driver(103, 4, 3));
+    engine.createDriver(101, 0, 1);
+    engine.createDriver(102, 2, 2);
+    engine.createDriver(103, 4, 3);
+
+    // From here on the engine is owned by the dispatcher thread
+    DispatchWorker worker(engine);
+    worker.start();
 
     int choice;
     int riderIdCounter = 500;
@@ -81,21 +61,22 @@ int main()
 
             Rider rider(riderIdCounter++, pickup, dropoff);
 
-            Trip *trip = engine.requestTrip(rider);
+            TripRequestResult trip = worker.submitTripRequest(rider).get();
 
-            if (!trip)
+            if (trip.tripId == -1)
             {
                 cout << "❌ No route available.\n";
                 continue;
             }
 
             cout << "\n🚕 Trip Created Successfully!\n";
-            cout << "Trip ID: " << trip->getId() << endl;
-            cout << "Fare: Rs. " << trip->getFare() << endl;
-            cout << "Status: " << Trip::stateToString(trip->getState()) << endl;
+            cout << "Trip ID: " << trip.tripId << endl;
+            cout << "Fare: Rs. " << trip.fare << endl;
+            cout << "Status: " << Trip::stateToString(trip.state) << endl;
         }
     }
 
+    worker.stop();
     cout << "\nThank you for using the system!\n";
     return 0;
 }
@@ -0,0 +1,201 @@
+#include "FleetStore.h"
+#include <iostream>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace std;
+
+const int INITIAL_FLEET_CAPACITY = 64; // Must be a multiple of 64
+const int BITS_PER_WORD = 64;
+
+/**
+ * @brief Number of set bits in a word
+ */
+static inline int popCount(unsigned long long word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return (int)__popcnt64(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (int)((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit of a non-zero word
+ */
+static inline int lowestBit(unsigned long long word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return popCount((word & (0 - word)) - 1);
+#endif
+}
+
+// ==================== FleetStore Implementation ====================
+
+FleetStore::FleetStore() : count(0), capacity(INITIAL_FLEET_CAPACITY)
+{
+    ids = new int[capacity];
+    statuses = new unsigned char[capacity];
+    zones = new int[capacity];
+    locations = new int[capacity];
+    availableBits = new unsigned long long[capacity / BITS_PER_WORD]();
+}
+
+FleetStore::~FleetStore()
+{
+    delete[] ids;
+    delete[] statuses;
+    delete[] zones;
+    delete[] locations;
+    delete[] availableBits;
+}
+
+void FleetStore::grow()
+{
+    int newCapacity = capacity * 2;
+
+    int *newIds = new int[newCapacity];
+    unsigned char *newStatuses = new unsigned char[newCapacity];
+    int *newZones = new int[newCapacity];
+    int *newLocations = new int[newCapacity];
+    unsigned long long *newBits = new unsigned long long[newCapacity / BITS_PER_WORD]();
+    for (int i = 0; i < count; i++)
+    {
+        newIds[i] = ids[i];
+        newStatuses[i] = statuses[i];
+        newZones[i] = zones[i];
+        newLocations[i] = locations[i];
+    }
+    for (int w = 0; w < capacity / BITS_PER_WORD; w++)
+    {
+        newBits[w] = availableBits[w];
+    }
+
+    delete[] ids;
+    delete[] statuses;
+    delete[] zones;
+    delete[] locations;
+    delete[] availableBits;
+    ids = newIds;
+    statuses = newStatuses;
+    zones = newZones;
+    locations = newLocations;
+    availableBits = newBits;
+    capacity = newCapacity;
+}
+
+void FleetStore::setAvailableBit(int slot, bool available)
+{
+    unsigned long long mask = 1ull << (slot % BITS_PER_WORD);
+    if (available)
+        availableBits[slot / BITS_PER_WORD] |= mask;
+    else
+        availableBits[slot / BITS_PER_WORD] &= ~mask;
+}
+
+int FleetStore::add(int driverId, int location, int zone, DriverStatus status)
+{
+    if (count == capacity)
+    {
+        grow();
+    }
+    int slot = count++;
+    ids[slot] = driverId;
+    locations[slot] = location;
+    zones[slot] = zone;
+    setStatus(slot, status);
+    return slot;
+}
+
+void FleetStore::removeAt(int slot)
+{
+    if (slot < 0 || slot >= count)
+    {
+        cout << "Error: Fleet slot " << slot << " out of range!" << endl;
+        return;
+    }
+
+    int last = --count;
+    if (slot != last)
+    {
+        ids[slot] = ids[last];
+        locations[slot] = locations[last];
+        zones[slot] = zones[last];
+        setStatus(slot, (DriverStatus)statuses[last]);
+    }
+    setAvailableBit(last, false); // Bits past count stay clear for the popcount
+}
+
+int FleetStore::findSlot(int driverId) const
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (ids[i] == driverId)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void FleetStore::setStatus(int slot, DriverStatus status)
+{
+    statuses[slot] = (unsigned char)status;
+    setAvailableBit(slot, status == DRIVER_AVAILABLE);
+}
+
+void FleetStore::setLocation(int slot, int location, int zone)
+{
+    locations[slot] = location;
+    zones[slot] = zone;
+}
+
+int FleetStore::getCount() const { return count; }
+int FleetStore::getId(int slot) const { return ids[slot]; }
+DriverStatus FleetStore::getStatus(int slot) const { return (DriverStatus)statuses[slot]; }
+int FleetStore::getZone(int slot) const { return zones[slot]; }
+int FleetStore::getLocation(int slot) const { return locations[slot]; }
+
+int FleetStore::countAvailable() const
+{
+    int words = (count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    int available = 0;
+    for (int w = 0; w < words; w++)
+    {
+        available += popCount(availableBits[w]);
+    }
+    return available;
+}
+
+int FleetStore::nextAvailable(int from) const
+{
+    if (from >= count)
+    {
+        return -1;
+    }
+
+    int word = from / BITS_PER_WORD;
+    int words = (count + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    unsigned long long bits = availableBits[word] & (~0ull << (from % BITS_PER_WORD));
+    while (bits == 0)
+    {
+        if (++word == words)
+        {
+            return -1;
+        }
+        bits = availableBits[word];
+    }
+    return word * BITS_PER_WORD + lowestBit(bits);
+}
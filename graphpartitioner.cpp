@@ -0,0 +1,587 @@
+#include "GraphPartitioner.h"
+#include <iostream>
+#include <iomanip>
+#include <climits>
+
+using namespace std;
+
+const int MAX_LEVELS = 64;             // Upper bound on coarsening levels
+const int COARSEST_NODES_PER_PART = 15; // Stop coarsening near this size per zone
+const int REFINEMENT_PASSES = 8;       // Boundary refinement passes per level
+const int INITIAL_ATTEMPTS = 4;        // Greedy growing attempts on the coarsest graph
+
+namespace
+{
+    /**
+     * One level of the multilevel hierarchy in compressed adjacency form
+     */
+    struct Level
+    {
+        int n;          // Vertex count
+        int *xadj;      // Edge range of each vertex (n + 1 entries)
+        int *adj;       // Neighbor of each edge
+        int *ewgt;      // Number of original roads merged into each edge
+        int *vwgt;      // Number of original locations merged into each vertex
+        int *cmap;      // Vertex of the next coarser level (nullptr on the coarsest)
+        int *part;      // Zone of each vertex
+
+        Level() : n(0), xadj(nullptr), adj(nullptr), ewgt(nullptr),
+                  vwgt(nullptr), cmap(nullptr), part(nullptr) {}
+
+        ~Level()
+        {
+            delete[] xadj;
+            delete[] adj;
+            delete[] ewgt;
+            delete[] vwgt;
+            delete[] cmap;
+            delete[] part;
+        }
+    };
+
+    unsigned int nextRandom(unsigned int &state)
+    {
+        state = state * 1103515245u + 12345u;
+        return state >> 8;
+    }
+
+    Level *buildFromCity(const City &city)
+    {
+        Level *g = new Level();
+        g->n = city.getNodeCount();
+        g->xadj = new int[g->n + 1];
+        g->vwgt = new int[g->n > 0 ? g->n : 1];
+
+        int arcs = 0;
+        for (int v = 0; v < g->n; v++)
+        {
+            g->xadj[v] = arcs;
+            g->vwgt[v] = 1;
+            int degree = city.getRoadCount(v);
+            arcs += degree > 0 ? degree : 0;
+        }
+        g->xadj[g->n] = arcs;
+
+        g->adj = new int[arcs > 0 ? arcs : 1];
+        g->ewgt = new int[arcs > 0 ? arcs : 1];
+        int *distances = new int[arcs > 0 ? arcs : 1];
+        for (int v = 0; v < g->n; v++)
+        {
+            city.getRoads(v, g->adj + g->xadj[v], distances + g->xadj[v]);
+        }
+        for (int e = 0; e < arcs; e++)
+        {
+            g->ewgt[e] = 1; // Every road counts once in the cut
+        }
+        delete[] distances;
+        return g;
+    }
+
+    /**
+     * Contracts a heavy-edge matching of g; fills g->cmap and returns the coarser level
+     */
+    Level *coarsen(Level *g, int maxVertexWeight, unsigned int &seed)
+    {
+        int n = g->n;
+        int *match = new int[n];
+        int *order = new int[n];
+        for (int v = 0; v < n; v++)
+        {
+            match[v] = -1;
+            order[v] = v;
+        }
+        for (int i = n - 1; i > 0; i--)
+        {
+            int j = (int)(nextRandom(seed) % (unsigned int)(i + 1));
+            int temp = order[i];
+            order[i] = order[j];
+            order[j] = temp;
+        }
+
+        // Heavy-edge matching: pair each vertex with its heaviest unmatched neighbor
+        for (int i = 0; i < n; i++)
+        {
+            int v = order[i];
+            if (match[v] != -1)
+                continue;
+
+            int best = -1;
+            int bestWeight = -1;
+            for (int e = g->xadj[v]; e < g->xadj[v + 1]; e++)
+            {
+                int u = g->adj[e];
+                if (match[u] == -1 && u != v &&
+                    g->vwgt[v] + g->vwgt[u] <= maxVertexWeight &&
+                    g->ewgt[e] > bestWeight)
+                {
+                    best = u;
+                    bestWeight = g->ewgt[e];
+                }
+            }
+
+            if (best == -1)
+            {
+                match[v] = v;
+            }
+            else
+            {
+                match[v] = best;
+                match[best] = v;
+            }
+        }
+
+        g->cmap = new int[n];
+        for (int v = 0; v < n; v++)
+            g->cmap[v] = -1;
+
+        int coarseCount = 0;
+        int *firstMember = new int[n];
+        for (int v = 0; v < n; v++)
+        {
+            if (g->cmap[v] != -1)
+                continue;
+            g->cmap[v] = coarseCount;
+            g->cmap[match[v]] = coarseCount;
+            firstMember[coarseCount] = v;
+            coarseCount++;
+        }
+
+        Level *c = new Level();
+        c->n = coarseCount;
+        c->xadj = new int[coarseCount + 1];
+        c->vwgt = new int[coarseCount > 0 ? coarseCount : 1];
+        c->adj = new int[g->xadj[n] > 0 ? g->xadj[n] : 1];
+        c->ewgt = new int[g->xadj[n] > 0 ? g->xadj[n] : 1];
+
+        // Merge parallel edges with a position marker per coarse neighbor
+        int *marker = new int[coarseCount > 0 ? coarseCount : 1];
+        for (int i = 0; i < coarseCount; i++)
+            marker[i] = -1;
+
+        int arcs = 0;
+        for (int cv = 0; cv < coarseCount; cv++)
+        {
+            c->xadj[cv] = arcs;
+            int a = firstMember[cv];
+            int b = match[a];
+            c->vwgt[cv] = g->vwgt[a] + (b != a ? g->vwgt[b] : 0);
+
+            for (int m = 0; m < 2; m++)
+            {
+                int v = (m == 0) ? a : b;
+                if (m == 1 && b == a)
+                    break;
+                for (int e = g->xadj[v]; e < g->xadj[v + 1]; e++)
+                {
+                    int cu = g->cmap[g->adj[e]];
+                    if (cu == cv)
+                        continue; // Contracted edge
+                    if (marker[cu] >= c->xadj[cv])
+                    {
+                        c->ewgt[marker[cu]] += g->ewgt[e];
+                    }
+                    else
+                    {
+                        marker[cu] = arcs;
+                        c->adj[arcs] = cu;
+                        c->ewgt[arcs] = g->ewgt[e];
+                        arcs++;
+                    }
+                }
+            }
+        }
+        c->xadj[coarseCount] = arcs;
+
+        delete[] marker;
+        delete[] firstMember;
+        delete[] match;
+        delete[] order;
+        return c;
+    }
+
+    int computeCut(const Level *g)
+    {
+        int cut = 0;
+        for (int v = 0; v < g->n; v++)
+            for (int e = g->xadj[v]; e < g->xadj[v + 1]; e++)
+                if (g->part[v] != g->part[g->adj[e]])
+                    cut += g->ewgt[e];
+        return cut / 2; // Each road is seen from both ends
+    }
+
+    /**
+     * Greedy graph growing: each zone grows from a seed by absorbing the
+     * frontier vertex most connected to it until it reaches its target weight
+     */
+    void growInitialPartition(Level *g, int k, int startSeed)
+    {
+        int n = g->n;
+        for (int v = 0; v < n; v++)
+            g->part[v] = -1;
+
+        int *connection = new int[n > 0 ? n : 1];
+        int assigned = 0;
+        int scan = n > 0 ? startSeed % n : 0;
+
+        for (int p = 0; p < k - 1 && assigned < n; p++)
+        {
+            // Remaining weight is shared evenly by the zones still to grow
+            int remaining = 0;
+            for (int v = 0; v < n; v++)
+            {
+                connection[v] = 0;
+                if (g->part[v] == -1)
+                    remaining += g->vwgt[v];
+            }
+            int target = remaining / (k - p);
+            int weight = 0;
+
+            while (weight < target && assigned < n)
+            {
+                // Best frontier vertex, or a fresh seed if the frontier is empty
+                int best = -1;
+                for (int v = 0; v < n; v++)
+                    if (g->part[v] == -1 && connection[v] > 0 &&
+                        (best == -1 || connection[v] > connection[best]))
+                        best = v;
+
+                if (best == -1)
+                {
+                    while (g->part[scan] != -1)
+                        scan = (scan + 1) % n;
+                    best = scan;
+                }
+
+                g->part[best] = p;
+                weight += g->vwgt[best];
+                assigned++;
+
+                for (int e = g->xadj[best]; e < g->xadj[best + 1]; e++)
+                    connection[g->adj[e]] += g->ewgt[e];
+            }
+        }
+
+        for (int v = 0; v < n; v++)
+            if (g->part[v] == -1)
+                g->part[v] = k - 1;
+
+        delete[] connection;
+    }
+
+    /**
+     * Boundary refinement: move vertices to the neighboring zone they are most
+     * connected to when it lowers the cut (or keeps it and improves balance),
+     * and push vertices out of overweight zones
+     */
+    void refine(Level *g, int k, int maxPartWeight)
+    {
+        int *weights = new int[k];
+        int *connection = new int[k];
+        int *touched = new int[k];
+        for (int p = 0; p < k; p++)
+        {
+            weights[p] = 0;
+            connection[p] = 0;
+        }
+        for (int v = 0; v < g->n; v++)
+            weights[g->part[v]] += g->vwgt[v];
+
+        for (int pass = 0; pass < REFINEMENT_PASSES; pass++)
+        {
+            int moves = 0;
+            for (int v = 0; v < g->n; v++)
+            {
+                int from = g->part[v];
+                int touchedCount = 0;
+                bool boundary = false;
+
+                for (int e = g->xadj[v]; e < g->xadj[v + 1]; e++)
+                {
+                    int q = g->part[g->adj[e]];
+                    if (q != from)
+                        boundary = true;
+                    if (connection[q] == 0)
+                        touched[touchedCount++] = q;
+                    connection[q] += g->ewgt[e];
+                }
+
+                if (boundary)
+                {
+                    bool overweight = weights[from] > maxPartWeight;
+                    int best = -1;
+                    int bestGain = INT_MIN;
+
+                    for (int t = 0; t < touchedCount; t++)
+                    {
+                        int q = touched[t];
+                        if (q == from || weights[q] + g->vwgt[v] > maxPartWeight)
+                            continue;
+                        int gain = connection[q] - connection[from];
+                        if (gain > bestGain ||
+                            (gain == bestGain && best != -1 && weights[q] < weights[best]))
+                        {
+                            best = q;
+                            bestGain = gain;
+                        }
+                    }
+
+                    bool improves = best != -1 &&
+                                    (bestGain > 0 || overweight ||
+                                     (bestGain == 0 && weights[from] > weights[best] + g->vwgt[v]));
+                    if (improves)
+                    {
+                        g->part[v] = best;
+                        weights[from] -= g->vwgt[v];
+                        weights[best] += g->vwgt[v];
+                        moves++;
+                    }
+                }
+
+                for (int t = 0; t < touchedCount; t++)
+                    connection[touched[t]] = 0;
+            }
+
+            if (moves == 0)
+                break;
+        }
+
+        delete[] weights;
+        delete[] connection;
+        delete[] touched;
+    }
+}
+
+// ==================== GraphPartitioner Implementation ====================
+
+GraphPartitioner::GraphPartitioner(const City &cityRef)
+    : city(cityRef), nodeCount(0), partCount(0), parts(nullptr),
+      partSizes(nullptr), cutSize(0) {}
+
+GraphPartitioner::~GraphPartitioner()
+{
+    delete[] parts;
+    delete[] partSizes;
+}
+
+bool GraphPartitioner::partition(int zoneCount, double imbalanceTolerance)
+{
+    if (zoneCount < 1)
+    {
+        cout << "Cannot partition: Zone count must be positive!" << endl;
+        return false;
+    }
+
+    nodeCount = city.getNodeCount();
+    if (nodeCount == 0)
+    {
+        cout << "Cannot partition: City is empty!" << endl;
+        return false;
+    }
+    if (zoneCount > nodeCount)
+    {
+        zoneCount = nodeCount;
+    }
+
+    delete[] parts;
+    delete[] partSizes;
+    partCount = zoneCount;
+    parts = new int[nodeCount];
+    partSizes = new int[partCount];
+
+    int maxPartWeight = (int)((double)nodeCount / partCount * (1.0 + imbalanceTolerance)) + 1;
+    int coarsestTarget = partCount * COARSEST_NODES_PER_PART;
+
+    // 1. Coarsening
+    Level *levels[MAX_LEVELS];
+    int levelCount = 1;
+    levels[0] = buildFromCity(city);
+    unsigned int seed = 12345u;
+
+    while (levelCount < MAX_LEVELS && levels[levelCount - 1]->n > coarsestTarget)
+    {
+        Level *fine = levels[levelCount - 1];
+        int maxVertexWeight = nodeCount / coarsestTarget + 1;
+        Level *coarse = coarsen(fine, maxVertexWeight > 1 ? maxVertexWeight : 2, seed);
+
+        if (coarse->n > fine->n * 95 / 100)
+        {
+            // Matching no longer shrinks the graph
+            delete coarse;
+            delete[] fine->cmap;
+            fine->cmap = nullptr;
+            break;
+        }
+        levels[levelCount++] = coarse;
+    }
+
+    // 2. Initial partition: keep the best of several greedy growths
+    Level *coarsest = levels[levelCount - 1];
+    coarsest->part = new int[coarsest->n];
+    int *bestParts = new int[coarsest->n];
+    int bestCut = INT_MAX;
+
+    for (int attempt = 0; attempt < INITIAL_ATTEMPTS; attempt++)
+    {
+        growInitialPartition(coarsest, partCount, (int)(nextRandom(seed) % (unsigned int)coarsest->n));
+        refine(coarsest, partCount, maxPartWeight);
+        int cut = computeCut(coarsest);
+        if (cut < bestCut)
+        {
+            bestCut = cut;
+            for (int v = 0; v < coarsest->n; v++)
+                bestParts[v] = coarsest->part[v];
+        }
+    }
+    for (int v = 0; v < coarsest->n; v++)
+        coarsest->part[v] = bestParts[v];
+    delete[] bestParts;
+
+    // 3. Uncoarsening with refinement at every level
+    for (int l = levelCount - 2; l >= 0; l--)
+    {
+        Level *fine = levels[l];
+        Level *coarse = levels[l + 1];
+        fine->part = new int[fine->n];
+        for (int v = 0; v < fine->n; v++)
+            fine->part[v] = coarse->part[fine->cmap[v]];
+        refine(fine, partCount, maxPartWeight);
+    }
+
+    for (int p = 0; p < partCount; p++)
+        partSizes[p] = 0;
+    for (int v = 0; v < nodeCount; v++)
+    {
+        parts[v] = levels[0]->part[v];
+        partSizes[parts[v]]++;
+    }
+    cutSize = computeCut(levels[0]);
+
+    for (int l = 0; l < levelCount; l++)
+        delete levels[l];
+
+    cout << "Partitioned " << nodeCount << " locations into " << partCount
+         << " zones, cut roads: " << cutSize << endl;
+    return true;
+}
+
+int GraphPartitioner::getPart(int nodeId) const
+{
+    if (parts == nullptr || nodeId < 0 || nodeId >= nodeCount)
+    {
+        return -1;
+    }
+    return parts[nodeId];
+}
+
+int GraphPartitioner::getCutSize() const
+{
+    return cutSize;
+}
+
+double GraphPartitioner::getImbalance() const
+{
+    if (partSizes == nullptr || partCount == 0)
+    {
+        return 0.0;
+    }
+
+    int largest = 0;
+    for (int p = 0; p < partCount; p++)
+    {
+        if (partSizes[p] > largest)
+            largest = partSizes[p];
+    }
+    return largest / ((double)nodeCount / partCount);
+}
+
+int GraphPartitioner::getPartSize(int zoneId) const
+{
+    if (partSizes == nullptr || zoneId < 0 || zoneId >= partCount)
+    {
+        return 0;
+    }
+    return partSizes[zoneId];
+}
+
+int GraphPartitioner::applyToCity(City &target) const
+{
+    if (parts == nullptr)
+    {
+        cout << "Cannot apply partition: No partition computed!" << endl;
+        return 0;
+    }
+
+    // Only the locations that move are passed on, in one batch
+    int *movedNodes = new int[nodeCount > 0 ? nodeCount : 1];
+    int *movedZones = new int[nodeCount > 0 ? nodeCount : 1];
+    int moved = 0;
+    for (int v = 0; v < nodeCount; v++)
+    {
+        if (target.getZone(v) != parts[v])
+        {
+            movedNodes[moved] = v;
+            movedZones[moved] = parts[v];
+            moved++;
+        }
+    }
+
+    int changed = target.setZones(movedNodes, movedZones, moved);
+    delete[] movedNodes;
+    delete[] movedZones;
+    return changed;
+}
+
+int GraphPartitioner::countCutRoads(const City &city)
+{
+    int n = city.getNodeCount();
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++)
+    {
+        if (city.getRoadCount(v) > maxDegree)
+            maxDegree = city.getRoadCount(v);
+    }
+
+    int *neighbors = new int[maxDegree > 0 ? maxDegree : 1];
+    int *distances = new int[maxDegree > 0 ? maxDegree : 1];
+    int cut = 0;
+
+    for (int v = 0; v < n; v++)
+    {
+        int degree = city.getRoads(v, neighbors, distances);
+        for (int i = 0; i < degree; i++)
+        {
+            if (neighbors[i] > v && city.getZone(v) != city.getZone(neighbors[i]))
+                cut++;
+        }
+    }
+
+    delete[] neighbors;
+    delete[] distances;
+    return cut;
+}
+
+void GraphPartitioner::printReport() const
+{
+    cout << "\n=== Partition Report ===" << endl;
+    if (parts == nullptr)
+    {
+        cout << "No partition computed!" << endl;
+        cout << "========================" << endl;
+        return;
+    }
+
+    cout << "Zones: " << partCount << endl;
+    cout << "Cut roads: " << cutSize << " of " << city.getTotalRoadCount() << endl;
+    cout << "Cut roads with current zones: " << countCutRoads(city) << endl;
+    ios::fmtflags flags = cout.flags();
+    streamsize precision = cout.precision();
+    cout << "Balance (largest / average): " << fixed << setprecision(3)
+         << getImbalance() << endl;
+    cout.flags(flags);
+    cout.precision(precision);
+    for (int p = 0; p < partCount; p++)
+    {
+        cout << "Zone " << p << ": " << partSizes[p] << " locations" << endl;
+    }
+    cout << "========================" << endl;
+}
@@ -1,5 +1,7 @@
 #include "MainWindow.h"
 #include <QHeaderView>
+#include <QMetaObject>
+#include <QVector>
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     initializeData();
@@ -10,21 +12,21 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 }
 
 MainWindow::~MainWindow() {
+    // Finish queued requests before the engine goes away
+    worker->stop();
+    delete worker;
     delete engine;
-    delete city;
 }
 
 void MainWindow::initializeData() {
-    city = new City();
-    for(int i=0; i<=5; i++) city->addLocation(i);
-    city->addRoad(0, 1, 5); city->addRoad(1, 3, 3);
-    city->addRoad(3, 4, 4); city->addRoad(4, 5, 6);
-    city->addRoad(0, 2, 10); city->addRoad(2, 3, 7);
-
-    engine = new DispatchEngine(city);
-    engine->registerDriver(new Driver(101, 0, 1));
-    engine->registerDriver(new Driver(102, 2, 2));
-    engine->registerDriver(new Driver(103, 4, 3));
+    engine = new DispatchEngine(&DEMO_CITY);
+    engine->createDriver(101, 0, 1);
+    engine->createDriver(102, 2, 2);
+    engine->createDriver(103, 4, 3);
+
+    // From here on the engine is only touched on the dispatcher thread
+    worker = new DispatchWorker(*engine);
+    worker->start();
 }
 
 void MainWindow::setupUI() {
@@ -163,35 +165,56 @@ void MainWindow::handleRequestRide() {
 
     logToTerminal(QString("INITIATING PATH_FIND %1 -> %2").arg(p).arg(d), "CALC");
 
+    // Dispatch runs on the worker; the continuation hops back to the UI thread
     Rider rider(riderIdCounter++, p, d);
-    Trip* trip = engine->requestTrip(rider);
-
-    if (trip) {
-        logToTerminal(QString("TRIP_%1 AUTH_SUCCESS").arg(trip->getId()), "OK");
-        logToTerminal(QString("> ASSIGNED_DRIVER: %1").arg(trip->getDriverId()), "DISPATCH");
-    } else {
-        logToTerminal("PATHFINDING_ERROR: DESTINATION_UNREACHABLE", "CRITICAL");
-    }
-    updateDashboard();
+    worker->requestTripAsync(rider, [this](const TripRequestResult &result) {
+        QMetaObject::invokeMethod(this, [this, result]() {
+            if (result.tripId != -1) {
+                logToTerminal(QString("TRIP_%1 AUTH_SUCCESS").arg(result.tripId), "OK");
+                logToTerminal(QString("> ASSIGNED_DRIVER: %1").arg(result.driverId), "DISPATCH");
+            } else {
+                logToTerminal("PATHFINDING_ERROR: DESTINATION_UNREACHABLE", "CRITICAL");
+            }
+            updateDashboard();
+        }, Qt::QueuedConnection);
+    });
 }
 
+struct TripRow {
+    int id;
+    int pickup;
+    int dropoff;
+    TripState state;
+};
+
 void MainWindow::updateDashboard() {
-    tripCountLabel->setText(QString("ACTIVE_TRIPS: %1").arg(engine->getActiveTripCount()));
-
-    mainTable->setRowCount(0);
-    for(int i=1000; i<1020; i++) {
-        Trip* t = engine->findTripById(i);
-        if(!t) continue;
-        int row = mainTable->rowCount();
-        mainTable->insertRow(row);
-        mainTable->setItem(row, 0, new QTableWidgetItem(QString::number(t->getId())));
-        mainTable->setItem(row, 1, new QTableWidgetItem(QString::number(t->getPickupLocation())));
-        mainTable->setItem(row, 2, new QTableWidgetItem(QString::number(t->getDropoffLocation())));
-
-        auto *item = new QTableWidgetItem(Trip::stateToString(t->getState()));
-        item->setForeground(QBrush(QColor("#00f2ff")));
-        mainTable->setItem(row, 3, item);
-    }
+    // Snapshot the trips on the dispatcher thread, then render on the UI thread
+    worker->submitTask([this](DispatchEngine &target) {
+        int activeTrips = target.getActiveTripCount();
+        QVector<TripRow> rows;
+        for(int i=1000; i<1020; i++) {
+            Trip* t = target.findTripById(i);
+            if(!t) continue;
+            rows.append({t->getId(), t->getPickupLocation(), t->getDropoffLocation(), t->getState()});
+        }
+
+        QMetaObject::invokeMethod(this, [this, activeTrips, rows]() {
+            tripCountLabel->setText(QString("ACTIVE_TRIPS: %1").arg(activeTrips));
+
+            mainTable->setRowCount(0);
+            for(const TripRow &r : rows) {
+                int row = mainTable->rowCount();
+                mainTable->insertRow(row);
+                mainTable->setItem(row, 0, new QTableWidgetItem(QString::number(r.id)));
+                mainTable->setItem(row, 1, new QTableWidgetItem(QString::number(r.pickup)));
+                mainTable->setItem(row, 2, new QTableWidgetItem(QString::number(r.dropoff)));
+
+                auto *item = new QTableWidgetItem(Trip::stateToString(r.state));
+                item->setForeground(QBrush(QColor("#00f2ff")));
+                mainTable->setItem(row, 3, item);
+            }
+        }, Qt::QueuedConnection);
+    });
 }
 
 void MainWindow::logToTerminal(QString msg, QString type) {
@@ -12,7 +12,8 @@
 #include <QTime>
 #include <QFrame>
 #include "DispatchEngine.h"
-#include "Citydj.h"
+#include "DispatchWorker.h"
+#include "DemoCity.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -26,8 +27,8 @@ private slots:
     void updateDashboard();
 
 private:
-    City* city;
     DispatchEngine* engine;
+    DispatchWorker* worker; // Runs the engine off the UI thread
     int riderIdCounter = 500;
 
     // UI Components
@@ -0,0 +1,138 @@
+#include "MinHeap.h"
+#include <climits>
+
+// ==================== MinHeap Implementation ====================
+
+MinHeap::MinHeap(int initialCapacity) : size(0)
+{
+    capacity = initialCapacity > 0 ? initialCapacity : 16;
+    keys = new int[capacity];
+    values = new int[capacity];
+}
+
+MinHeap::~MinHeap()
+{
+    delete[] keys;
+    delete[] values;
+}
+
+void MinHeap::resize()
+{
+    capacity *= 2;
+    int *newKeys = new int[capacity];
+    int *newValues = new int[capacity];
+
+    for (int i = 0; i < size; i++)
+    {
+        newKeys[i] = keys[i];
+        newValues[i] = values[i];
+    }
+
+    delete[] keys;
+    delete[] values;
+    keys = newKeys;
+    values = newValues;
+}
+
+void MinHeap::siftUp(int index)
+{
+    int key = keys[index];
+    int value = values[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (keys[parent] <= key)
+        {
+            break;
+        }
+        keys[index] = keys[parent];
+        values[index] = values[parent];
+        index = parent;
+    }
+
+    keys[index] = key;
+    values[index] = value;
+}
+
+void MinHeap::siftDown(int index)
+{
+    int key = keys[index];
+    int value = values[index];
+
+    while (true)
+    {
+        int child = 2 * index + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && keys[child + 1] < keys[child])
+        {
+            child++;
+        }
+        if (key <= keys[child])
+        {
+            break;
+        }
+        keys[index] = keys[child];
+        values[index] = values[child];
+        index = child;
+    }
+
+    keys[index] = key;
+    values[index] = value;
+}
+
+void MinHeap::push(int key, int value)
+{
+    if (size >= capacity)
+    {
+        resize();
+    }
+
+    keys[size] = key;
+    values[size] = value;
+    size++;
+    siftUp(size - 1);
+}
+
+bool MinHeap::pop(int &key, int &value)
+{
+    if (size == 0)
+    {
+        return false;
+    }
+
+    key = keys[0];
+    value = values[0];
+
+    size--;
+    if (size > 0)
+    {
+        keys[0] = keys[size];
+        values[0] = values[size];
+        siftDown(0);
+    }
+    return true;
+}
+
+int MinHeap::peekKey() const
+{
+    return size == 0 ? INT_MAX : keys[0];
+}
+
+bool MinHeap::isEmpty() const
+{
+    return size == 0;
+}
+
+int MinHeap::getSize() const
+{
+    return size;
+}
+
+void MinHeap::clear()
+{
+    size = 0;
+}
@@ -0,0 +1,588 @@
+#include "MultiMetricGraph.h"
+#include "MinHeap.h"
+#include <iostream>
+#include <climits>
+
+using namespace std;
+
+// ==================== MetricWeights Implementation ====================
+
+MetricWeights::MetricWeights()
+{
+    weights[METRIC_DISTANCE] = 1;
+    weights[METRIC_TIME] = 0;
+    weights[METRIC_TOLL] = 0;
+}
+
+MetricWeights::MetricWeights(int distance, int time, int toll)
+{
+    weights[METRIC_DISTANCE] = distance;
+    weights[METRIC_TIME] = time;
+    weights[METRIC_TOLL] = toll;
+}
+
+MetricWeights MetricWeights::only(Metric metric)
+{
+    MetricWeights result(0, 0, 0);
+    result.weights[metric] = 1;
+    return result;
+}
+
+bool MetricWeights::operator==(const MetricWeights &other) const
+{
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        if (weights[m] != other.weights[m])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================== MultiMetricGraph Implementation ====================
+
+MultiMetricGraph::MultiMetricGraph(const City &city)
+    : nodeCount(city.getNodeCount()), arcCount(0), cellCount(0),
+      customized(false), touchedCount(0), customizedCells(0)
+{
+    int size = nodeCount > 0 ? nodeCount : 1;
+    firstArc = new int[nodeCount + 1];
+    cellOf = new int[size];
+
+    // ===== Topology =====
+    int maxDegree = 0;
+    int maxZone = -1;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        int degree = city.getRoadCount(u);
+        if (degree > 0)
+        {
+            arcCount += degree;
+            if (degree > maxDegree)
+            {
+                maxDegree = degree;
+            }
+        }
+        int zone = city.getZone(u);
+        if (zone > maxZone)
+        {
+            maxZone = zone;
+        }
+    }
+
+    int arcSize = arcCount > 0 ? arcCount : 1;
+    arcHead = new int[arcSize];
+    arcCost = new int[arcSize];
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        metrics[m] = new int[arcSize];
+    }
+
+    int *distances = new int[maxDegree > 0 ? maxDegree : 1];
+    int arc = 0;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        firstArc[u] = arc;
+        int degree = city.getRoads(u, arcHead + arc, distances);
+        for (int i = 0; i < degree; i++)
+        {
+            metrics[METRIC_DISTANCE][arc + i] = distances[i];
+            metrics[METRIC_TIME][arc + i] = distances[i];
+            metrics[METRIC_TOLL][arc + i] = 0;
+        }
+        if (degree > 0)
+        {
+            arc += degree;
+        }
+    }
+    firstArc[nodeCount] = arc;
+    delete[] distances;
+
+    // ===== Cells and boundary locations (metric independent) =====
+    // Zones are cells 0 .. maxZone; unassigned locations share the last cell
+    cellCount = maxZone + 2;
+    for (int u = 0; u < nodeCount; u++)
+    {
+        int zone = city.getZone(u);
+        cellOf[u] = zone >= 0 ? zone : cellCount - 1;
+    }
+
+    boundaryStart = new int[cellCount + 1];
+    boundaryIndex = new int[size];
+    for (int c = 0; c <= cellCount; c++)
+    {
+        boundaryStart[c] = 0;
+    }
+    for (int u = 0; u < nodeCount; u++)
+    {
+        boundaryIndex[u] = -1;
+        for (int a = firstArc[u]; a < firstArc[u + 1]; a++)
+        {
+            if (cellOf[arcHead[a]] != cellOf[u])
+            {
+                boundaryIndex[u] = boundaryStart[cellOf[u] + 1]++;
+                break;
+            }
+        }
+    }
+    for (int c = 0; c < cellCount; c++)
+    {
+        boundaryStart[c + 1] += boundaryStart[c];
+    }
+
+    int boundaryCount = boundaryStart[cellCount];
+    boundaryNodes = new int[boundaryCount > 0 ? boundaryCount : 1];
+    for (int u = 0; u < nodeCount; u++)
+    {
+        if (boundaryIndex[u] >= 0)
+        {
+            boundaryNodes[boundaryStart[cellOf[u]] + boundaryIndex[u]] = u;
+        }
+    }
+
+    cliqueStart = new int[cellCount + 1];
+    cliqueStart[0] = 0;
+    for (int c = 0; c < cellCount; c++)
+    {
+        int b = boundaryStart[c + 1] - boundaryStart[c];
+        cliqueStart[c + 1] = cliqueStart[c] + b * b;
+    }
+    int cliqueSize = cliqueStart[cellCount] > 0 ? cliqueStart[cellCount] : 1;
+    cliqueCost = new int[cliqueSize];
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        cliqueTotals[m] = new int[cliqueSize];
+    }
+
+    cellDirty = new bool[cellCount];
+    for (int c = 0; c < cellCount; c++)
+    {
+        cellDirty[c] = true;
+    }
+
+    // ===== Search scratch =====
+    scratchCost = new int[size];
+    touched = new int[size];
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        scratchTotals[m] = new int[size];
+    }
+    for (int u = 0; u < nodeCount; u++)
+    {
+        scratchCost[u] = INT_MAX;
+    }
+}
+
+MultiMetricGraph::~MultiMetricGraph()
+{
+    delete[] firstArc;
+    delete[] arcHead;
+    delete[] arcCost;
+    delete[] cellOf;
+    delete[] boundaryStart;
+    delete[] boundaryNodes;
+    delete[] boundaryIndex;
+    delete[] cliqueStart;
+    delete[] cliqueCost;
+    delete[] cellDirty;
+    delete[] scratchCost;
+    delete[] touched;
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        delete[] metrics[m];
+        delete[] cliqueTotals[m];
+        delete[] scratchTotals[m];
+    }
+}
+
+int MultiMetricGraph::getNodeCount() const
+{
+    return nodeCount;
+}
+
+int MultiMetricGraph::getCellCount() const
+{
+    return cellCount;
+}
+
+int MultiMetricGraph::getBoundaryCount() const
+{
+    return boundaryStart[cellCount];
+}
+
+int MultiMetricGraph::findArc(int from, int to) const
+{
+    if (from < 0 || from >= nodeCount)
+    {
+        return -1;
+    }
+    for (int a = firstArc[from]; a < firstArc[from + 1]; a++)
+    {
+        if (arcHead[a] == to)
+        {
+            return a;
+        }
+    }
+    return -1;
+}
+
+bool MultiMetricGraph::setRoadMetric(int from, int to, Metric metric, int value)
+{
+    if (metric < 0 || metric >= METRIC_COUNT || value < 0)
+    {
+        cout << "Error: Road metrics must be non-negative!" << endl;
+        return false;
+    }
+
+    int forward = findArc(from, to);
+    int backward = findArc(to, from);
+    if (forward == -1 || backward == -1)
+    {
+        cout << "Cannot set road metric: No road between " << from << " and " << to << "!" << endl;
+        return false;
+    }
+
+    int arcs[2] = {forward, backward};
+    for (int i = 0; i < 2; i++)
+    {
+        int a = arcs[i];
+        metrics[metric][a] = value;
+        if (customized)
+        {
+            // Keep the blended cost current so only the cell clique is stale
+            int cost = 0;
+            for (int m = 0; m < METRIC_COUNT; m++)
+            {
+                cost += customWeights.weights[m] * metrics[m][a];
+            }
+            arcCost[a] = cost;
+        }
+    }
+
+    // Roads crossing cells are not part of any clique
+    if (cellOf[from] == cellOf[to])
+    {
+        cellDirty[cellOf[from]] = true;
+    }
+    return true;
+}
+
+int MultiMetricGraph::getRoadMetric(int from, int to, Metric metric) const
+{
+    int a = findArc(from, to);
+    if (a == -1 || metric < 0 || metric >= METRIC_COUNT)
+    {
+        return -1;
+    }
+    return metrics[metric][a];
+}
+
+void MultiMetricGraph::setScratch(int node, int cost, const int *totals)
+{
+    if (scratchCost[node] == INT_MAX)
+    {
+        touched[touchedCount++] = node;
+    }
+    scratchCost[node] = cost;
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        scratchTotals[m][node] = totals[m];
+    }
+}
+
+void MultiMetricGraph::resetScratch()
+{
+    for (int i = 0; i < touchedCount; i++)
+    {
+        scratchCost[touched[i]] = INT_MAX;
+    }
+    touchedCount = 0;
+}
+
+void MultiMetricGraph::customizeCell(int cell)
+{
+    int first = boundaryStart[cell];
+    int b = boundaryStart[cell + 1] - first;
+    MinHeap heap;
+    int zero[METRIC_COUNT] = {0};
+    int totals[METRIC_COUNT];
+
+    for (int i = 0; i < b; i++)
+    {
+        // Dijkstra from one boundary location over roads inside the cell
+        int source = boundaryNodes[first + i];
+        setScratch(source, 0, zero);
+        heap.push(0, source);
+
+        int cost, u;
+        while (heap.pop(cost, u))
+        {
+            if (cost > scratchCost[u])
+            {
+                continue; // Stale entry
+            }
+            for (int a = firstArc[u]; a < firstArc[u + 1]; a++)
+            {
+                int v = arcHead[a];
+                if (cellOf[v] != cell)
+                {
+                    continue;
+                }
+                int newCost = cost + arcCost[a];
+                if (newCost < scratchCost[v])
+                {
+                    for (int m = 0; m < METRIC_COUNT; m++)
+                    {
+                        totals[m] = scratchTotals[m][u] + metrics[m][a];
+                    }
+                    setScratch(v, newCost, totals);
+                    heap.push(newCost, v);
+                }
+            }
+        }
+
+        int row = cliqueStart[cell] + i * b;
+        for (int j = 0; j < b; j++)
+        {
+            int target = boundaryNodes[first + j];
+            bool reached = scratchCost[target] != INT_MAX;
+            cliqueCost[row + j] = reached ? scratchCost[target] : -1;
+            for (int m = 0; m < METRIC_COUNT; m++)
+            {
+                cliqueTotals[m][row + j] = reached ? scratchTotals[m][target] : -1;
+            }
+        }
+        resetScratch();
+    }
+
+    cellDirty[cell] = false;
+    customizedCells++;
+}
+
+int MultiMetricGraph::customize(const MetricWeights &weights)
+{
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        if (weights.weights[m] < 0)
+        {
+            cout << "Error: Metric weights must be non-negative!" << endl;
+            return -1;
+        }
+    }
+
+    // A new blend changes every arc; a metric edit only its own cells
+    if (!customized || !(weights == customWeights))
+    {
+        for (int a = 0; a < arcCount; a++)
+        {
+            int cost = 0;
+            for (int m = 0; m < METRIC_COUNT; m++)
+            {
+                cost += weights.weights[m] * metrics[m][a];
+            }
+            arcCost[a] = cost;
+        }
+        for (int c = 0; c < cellCount; c++)
+        {
+            cellDirty[c] = true;
+        }
+        customWeights = weights;
+        customized = true;
+    }
+
+    int count = 0;
+    for (int c = 0; c < cellCount; c++)
+    {
+        if (cellDirty[c])
+        {
+            customizeCell(c);
+            count++;
+        }
+    }
+    return count;
+}
+
+int MultiMetricGraph::overlaySearch(int source, int target, int *totals)
+{
+    int sourceCell = cellOf[source];
+    int targetCell = cellOf[target];
+    MinHeap heap;
+    int zero[METRIC_COUNT] = {0};
+    int newTotals[METRIC_COUNT];
+    int result = -1;
+
+    setScratch(source, 0, zero);
+    heap.push(0, source);
+
+    int cost, u;
+    while (heap.pop(cost, u))
+    {
+        if (cost > scratchCost[u])
+        {
+            continue; // Stale entry
+        }
+        if (u == target)
+        {
+            result = cost;
+            if (totals != nullptr)
+            {
+                for (int m = 0; m < METRIC_COUNT; m++)
+                {
+                    totals[m] = scratchTotals[m][u];
+                }
+            }
+            break;
+        }
+
+        int cell = cellOf[u];
+        bool fullCell = cell == sourceCell || cell == targetCell;
+
+        // Roads: all of them in the source and target cells, only cut roads elsewhere
+        for (int a = firstArc[u]; a < firstArc[u + 1]; a++)
+        {
+            int v = arcHead[a];
+            if (!fullCell && cellOf[v] == cell)
+            {
+                continue;
+            }
+            int newCost = cost + arcCost[a];
+            if (newCost < scratchCost[v])
+            {
+                for (int m = 0; m < METRIC_COUNT; m++)
+                {
+                    newTotals[m] = scratchTotals[m][u] + metrics[m][a];
+                }
+                setScratch(v, newCost, newTotals);
+                heap.push(newCost, v);
+            }
+        }
+
+        // Shortcuts across every other cell
+        if (!fullCell)
+        {
+            int first = boundaryStart[cell];
+            int b = boundaryStart[cell + 1] - first;
+            int row = cliqueStart[cell] + boundaryIndex[u] * b;
+            for (int j = 0; j < b; j++)
+            {
+                int shortcut = cliqueCost[row + j];
+                int v = boundaryNodes[first + j];
+                if (shortcut < 0 || v == u)
+                {
+                    continue;
+                }
+                int newCost = cost + shortcut;
+                if (newCost < scratchCost[v])
+                {
+                    for (int m = 0; m < METRIC_COUNT; m++)
+                    {
+                        newTotals[m] = scratchTotals[m][u] + cliqueTotals[m][row + j];
+                    }
+                    setScratch(v, newCost, newTotals);
+                    heap.push(newCost, v);
+                }
+            }
+        }
+    }
+
+    resetScratch();
+    return result;
+}
+
+int MultiMetricGraph::getShortestCost(int source, int target, const MetricWeights &weights)
+{
+    return getRouteMetrics(source, target, weights, nullptr);
+}
+
+int MultiMetricGraph::getRouteMetrics(int source, int target, const MetricWeights &weights, int *totals)
+{
+    if (source < 0 || source >= nodeCount || target < 0 || target >= nodeCount)
+    {
+        cout << "Error: Invalid source or destination!" << endl;
+        return -1;
+    }
+    if (customize(weights) < 0)
+    {
+        return -1;
+    }
+    return overlaySearch(source, target, totals);
+}
+
+int MultiMetricGraph::getShortestCostDirect(int source, int target, const MetricWeights &weights) const
+{
+    if (source < 0 || source >= nodeCount || target < 0 || target >= nodeCount)
+    {
+        cout << "Error: Invalid source or destination!" << endl;
+        return -1;
+    }
+
+    int *costs = new int[nodeCount];
+    for (int u = 0; u < nodeCount; u++)
+    {
+        costs[u] = INT_MAX;
+    }
+
+    MinHeap heap;
+    costs[source] = 0;
+    heap.push(0, source);
+
+    int result = -1;
+    int cost, u;
+    while (heap.pop(cost, u))
+    {
+        if (cost > costs[u])
+        {
+            continue; // Stale entry
+        }
+        if (u == target)
+        {
+            result = cost;
+            break;
+        }
+        for (int a = firstArc[u]; a < firstArc[u + 1]; a++)
+        {
+            int arcBlend = 0;
+            for (int m = 0; m < METRIC_COUNT; m++)
+            {
+                arcBlend += weights.weights[m] * metrics[m][a];
+            }
+            int v = arcHead[a];
+            if (cost + arcBlend < costs[v])
+            {
+                costs[v] = cost + arcBlend;
+                heap.push(costs[v], v);
+            }
+        }
+    }
+
+    delete[] costs;
+    return result;
+}
+
+long long MultiMetricGraph::getCustomizedCellCount() const
+{
+    return customizedCells;
+}
+
+void MultiMetricGraph::printReport() const
+{
+    cout << "\n=== Multi-Metric Graph Report ===" << endl;
+    cout << "Locations: " << nodeCount << ", Arcs: " << arcCount
+         << ", Metrics per arc: " << METRIC_COUNT << endl;
+    cout << "Cells: " << cellCount << ", Boundary locations: " << boundaryStart[cellCount]
+         << ", Clique entries: " << cliqueStart[cellCount] << endl;
+    if (customized)
+    {
+        cout << "Customized for weights (distance, time, toll): ("
+             << customWeights.weights[METRIC_DISTANCE] << ", "
+             << customWeights.weights[METRIC_TIME] << ", "
+             << customWeights.weights[METRIC_TOLL] << ")" << endl;
+    }
+    else
+    {
+        cout << "Not customized yet." << endl;
+    }
+    cout << "Cells customized so far: " << customizedCells << endl;
+    cout << "=================================" << endl;
+}
@@ -0,0 +1,657 @@
+#include "PagedCity.h"
+#include "MinHeap.h"
+#include <iostream>
+#include <iomanip>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+const int DEFAULT_PREFETCH_DEPTH = 2;
+const char PAGE_FILE_MAGIC[8] = {'D', 'P', 'A', 'G', 'E', 'v', '0', '1'};
+const unsigned int PAGE_BYTE_ORDER_MARK = 0x01020304u;
+const int PAGE_HEADER_SIZE = 32; ///< Magic, byte order mark, node count, page size, page count, max degree
+
+namespace
+{
+    const int *sortZones = nullptr;
+
+    bool zoneLess(int a, int b)
+    {
+        return sortZones[a] < sortZones[b];
+    }
+
+    /**
+     * Streams bytes to the page file at increasing offsets, padding gaps with zeros
+     */
+    struct PageWriter
+    {
+        ofstream &out;
+        long long position;
+
+        PageWriter(ofstream &stream) : out(stream), position(0) {}
+
+        void padTo(long long offset)
+        {
+            while (position < offset)
+            {
+                out.put(0);
+                position++;
+            }
+        }
+
+        void writeBytes(const void *data, long long count)
+        {
+            out.write((const char *)data, count);
+            position += count;
+        }
+
+        void writeInt(int value)
+        {
+            writeBytes(&value, sizeof(int));
+        }
+    };
+}
+
+// ==================== PagedCity Implementation ====================
+
+PagedCity::PagedCity(const City &city, const char *path,
+                     long long cacheBudgetBytes, int pageSizeBytes)
+    : nodeCount(city.getNodeCount()), pageSize(pageSizeBytes), pageCount(0),
+      maxDegree(0), prefetchDepth(DEFAULT_PREFETCH_DEPTH), dataStart(0),
+      frames(nullptr), framePages(nullptr), pageFrames(nullptr),
+      lruPrev(nullptr), lruNext(nullptr), lruHead(-1), lruTail(-1), usedFrames(0),
+      pageFaults(0), cacheHits(0), prefetches(0)
+{
+    if (pageSize < 64)
+    {
+        cout << "Warning: Page size too small, using 64 bytes" << endl;
+        pageSize = 64;
+    }
+
+    recordOffsets = new long long[nodeCount];
+    zones = new int[nodeCount];
+    pagePartitions = nullptr;
+    recordBuffer = nullptr;
+
+    if (!writePages(city, path))
+    {
+        cout << "Error: Could not write page file " << path << endl;
+        frameCount = 0;
+        return;
+    }
+
+    file.open(path, ios::binary);
+    if (!file.is_open())
+    {
+        cout << "Error: Could not open page file " << path << endl;
+    }
+
+    openCache(cacheBudgetBytes);
+}
+
+PagedCity::PagedCity(const char *path, long long cacheBudgetBytes)
+    : nodeCount(0), pageSize(0), pageCount(0), recordOffsets(nullptr), zones(nullptr),
+      pagePartitions(nullptr), maxDegree(0), prefetchDepth(DEFAULT_PREFETCH_DEPTH), dataStart(0),
+      frameCount(0), frames(nullptr), framePages(nullptr), pageFrames(nullptr),
+      lruPrev(nullptr), lruNext(nullptr), lruHead(-1), lruTail(-1), usedFrames(0),
+      recordBuffer(nullptr), pageFaults(0), cacheHits(0), prefetches(0)
+{
+    file.open(path, ios::binary);
+    if (!file.is_open())
+    {
+        cout << "Error: Could not open page file " << path << endl;
+        return;
+    }
+    if (!readHeader())
+    {
+        cout << "Error: " << path << " is not a page file of this format or byte order!" << endl;
+        file.close();
+        nodeCount = 0;
+        pageCount = 0;
+        return;
+    }
+
+    openCache(cacheBudgetBytes);
+}
+
+void PagedCity::openCache(long long cacheBudgetBytes)
+{
+    recordBuffer = new int[2 * (maxDegree > 0 ? maxDegree : 1)];
+
+    long long budgetFrames = cacheBudgetBytes / pageSize;
+    frameCount = budgetFrames < 1 ? 1 : (int)budgetFrames;
+    if (frameCount > pageCount && pageCount > 0)
+    {
+        frameCount = pageCount;
+    }
+
+    frames = new unsigned char[(size_t)frameCount * pageSize];
+    framePages = new int[frameCount];
+    lruPrev = new int[frameCount];
+    lruNext = new int[frameCount];
+    for (int i = 0; i < frameCount; i++)
+    {
+        framePages[i] = -1;
+        lruPrev[i] = -1;
+        lruNext[i] = -1;
+    }
+
+    pageFrames = new int[pageCount > 0 ? pageCount : 1];
+    for (int i = 0; i < pageCount; i++)
+    {
+        pageFrames[i] = -1;
+    }
+
+    cout << "PagedCity ready: " << nodeCount << " locations in " << pageCount
+         << " pages of " << pageSize << " bytes, cache of " << frameCount << " pages" << endl;
+}
+
+PagedCity::~PagedCity()
+{
+    delete[] recordOffsets;
+    delete[] zones;
+    delete[] pagePartitions;
+    delete[] recordBuffer;
+    delete[] frames;
+    delete[] framePages;
+    delete[] pageFrames;
+    delete[] lruPrev;
+    delete[] lruNext;
+}
+
+bool PagedCity::writePages(const City &city, const char *path)
+{
+    // Group locations by partition so a zone's records share pages
+    int *order = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        order[i] = i;
+        zones[i] = city.getZone(i);
+        int degree = city.getRoadCount(i);
+        if (degree > maxDegree)
+        {
+            maxDegree = degree;
+        }
+    }
+    sortZones = zones;
+    stable_sort(order, order + nodeCount, zoneLess);
+    sortZones = nullptr;
+
+    // First pass: place records so small ones never straddle a page
+    long long position = 0;
+    for (int i = 0; i < nodeCount; i++)
+    {
+        int node = order[i];
+        long long size = sizeof(int) + 2LL * sizeof(int) * city.getRoadCount(node);
+        long long usedInPage = position % pageSize;
+        if (usedInPage != 0 && usedInPage + size > pageSize)
+        {
+            position += pageSize - usedInPage;
+        }
+        recordOffsets[node] = position;
+        position += size;
+    }
+    pageCount = (int)((position + pageSize - 1) / pageSize);
+
+    pagePartitions = new int[pageCount > 0 ? pageCount : 1];
+    for (int i = 0; i < pageCount; i++)
+    {
+        pagePartitions[i] = INT_MIN;
+    }
+    for (int i = 0; i < nodeCount; i++)
+    {
+        int node = order[i];
+        long long size = sizeof(int) + 2LL * sizeof(int) * city.getRoadCount(node);
+        int firstPage = (int)(recordOffsets[node] / pageSize);
+        int lastPage = (int)((recordOffsets[node] + size - 1) / pageSize);
+        for (int p = firstPage; p <= lastPage; p++)
+        {
+            if (pagePartitions[p] == INT_MIN)
+            {
+                pagePartitions[p] = zones[node];
+            }
+        }
+    }
+
+    // Pages start on the first page boundary after the header
+    long long headerBytes = PAGE_HEADER_SIZE + (long long)nodeCount * (sizeof(long long) + sizeof(int)) +
+                            (long long)pageCount * sizeof(int);
+    dataStart = (headerBytes + pageSize - 1) / pageSize * pageSize;
+
+    // Second pass: stream the header and records to disk
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out.is_open())
+    {
+        delete[] order;
+        return false;
+    }
+
+    PageWriter writer(out);
+    writer.writeBytes(PAGE_FILE_MAGIC, 8);
+    writer.writeBytes(&PAGE_BYTE_ORDER_MARK, 4);
+    writer.writeInt(nodeCount);
+    writer.writeInt(pageSize);
+    writer.writeInt(pageCount);
+    writer.writeInt(maxDegree);
+    writer.writeInt(0); // Reserved
+    writer.writeBytes(recordOffsets, (long long)nodeCount * sizeof(long long));
+    writer.writeBytes(zones, (long long)nodeCount * sizeof(int));
+    writer.writeBytes(pagePartitions, (long long)pageCount * sizeof(int));
+
+    int *neighbors = new int[maxDegree > 0 ? maxDegree : 1];
+    int *distances = new int[maxDegree > 0 ? maxDegree : 1];
+
+    for (int i = 0; i < nodeCount; i++)
+    {
+        int node = order[i];
+        int degree = city.getRoads(node, neighbors, distances);
+
+        writer.padTo(dataStart + recordOffsets[node]);
+        writer.writeInt(degree);
+        for (int j = 0; j < degree; j++)
+        {
+            writer.writeInt(neighbors[j]);
+            writer.writeInt(distances[j]);
+        }
+    }
+    writer.padTo(dataStart + (long long)pageCount * pageSize);
+
+    bool ok = out.good();
+    out.close();
+
+    delete[] neighbors;
+    delete[] distances;
+    delete[] order;
+    return ok;
+}
+
+bool PagedCity::readHeader()
+{
+    char magic[8];
+    unsigned int byteOrder = 0;
+    int fields[5] = {0, 0, 0, 0, 0};
+
+    file.read(magic, 8);
+    file.read((char *)&byteOrder, 4);
+    file.read((char *)fields, sizeof(fields));
+    if (!file || memcmp(magic, PAGE_FILE_MAGIC, 8) != 0 || byteOrder != PAGE_BYTE_ORDER_MARK)
+    {
+        return false;
+    }
+
+    nodeCount = fields[0];
+    pageSize = fields[1];
+    pageCount = fields[2];
+    maxDegree = fields[3];
+    if (nodeCount < 0 || pageSize < 64 || pageCount < 0 || maxDegree < 0)
+    {
+        return false;
+    }
+
+    // The file must hold the header arrays and every page
+    long long headerBytes = PAGE_HEADER_SIZE + (long long)nodeCount * (sizeof(long long) + sizeof(int)) +
+                            (long long)pageCount * sizeof(int);
+    dataStart = (headerBytes + pageSize - 1) / pageSize * pageSize;
+    long long dataBytes = (long long)pageCount * pageSize;
+    file.seekg(0, ios::end);
+    long long fileBytes = (long long)file.tellg();
+    if (fileBytes < dataStart + dataBytes)
+    {
+        return false;
+    }
+    file.seekg(PAGE_HEADER_SIZE);
+
+    recordOffsets = new long long[nodeCount > 0 ? nodeCount : 1];
+    zones = new int[nodeCount > 0 ? nodeCount : 1];
+    pagePartitions = new int[pageCount > 0 ? pageCount : 1];
+    file.read((char *)recordOffsets, (long long)nodeCount * sizeof(long long));
+    file.read((char *)zones, (long long)nodeCount * sizeof(int));
+    file.read((char *)pagePartitions, (long long)pageCount * sizeof(int));
+    if (!file)
+    {
+        return false;
+    }
+
+    // A record must at least fit its road count inside the pages
+    for (int i = 0; i < nodeCount; i++)
+    {
+        if (recordOffsets[i] < 0 || recordOffsets[i] + (long long)sizeof(int) > dataBytes)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PagedCity::isOpen() const
+{
+    return file.is_open() && frameCount > 0;
+}
+
+void PagedCity::setPrefetchDepth(int depth)
+{
+    prefetchDepth = depth < 0 ? 0 : depth;
+}
+
+void PagedCity::touchFrame(int frame) const
+{
+    if (lruHead == frame)
+    {
+        return;
+    }
+
+    // Unlink
+    if (lruPrev[frame] != -1)
+        lruNext[lruPrev[frame]] = lruNext[frame];
+    if (lruNext[frame] != -1)
+        lruPrev[lruNext[frame]] = lruPrev[frame];
+    if (lruTail == frame)
+        lruTail = lruPrev[frame];
+
+    // Link at head
+    lruPrev[frame] = -1;
+    lruNext[frame] = lruHead;
+    if (lruHead != -1)
+        lruPrev[lruHead] = frame;
+    lruHead = frame;
+    if (lruTail == -1)
+        lruTail = frame;
+}
+
+int PagedCity::loadPage(int page) const
+{
+    // Use a free frame if one exists, otherwise evict the least recently used
+    int frame;
+    bool freshFrame = usedFrames < frameCount;
+    if (freshFrame)
+    {
+        frame = usedFrames++;
+    }
+    else
+    {
+        frame = lruTail;
+        if (framePages[frame] != -1)
+        {
+            pageFrames[framePages[frame]] = -1;
+            framePages[frame] = -1;
+        }
+    }
+
+    file.clear();
+    file.seekg(dataStart + (long long)page * pageSize);
+    file.read((char *)(frames + (size_t)frame * pageSize), pageSize);
+    if (file.gcount() != pageSize)
+    {
+        // Every page is written full size, so a short read means the file changed
+        cout << "Error: Could not read page " << page << " of the page file!" << endl;
+        if (freshFrame)
+        {
+            usedFrames--;
+        }
+        return -1;
+    }
+
+    framePages[frame] = page;
+    pageFrames[page] = frame;
+    touchFrame(frame);
+    return frame;
+}
+
+void PagedCity::prefetchAfter(int page) const
+{
+    // Never let prefetching evict more than half the cache
+    int depth = prefetchDepth < frameCount / 2 ? prefetchDepth : frameCount / 2;
+
+    for (int p = page + 1; p <= page + depth && p < pageCount; p++)
+    {
+        if (pagePartitions[p] != pagePartitions[page])
+        {
+            break; // Stay inside the partition
+        }
+        if (pageFrames[p] == -1)
+        {
+            if (loadPage(p) == -1)
+            {
+                break;
+            }
+            prefetches++;
+        }
+    }
+    // Keep the demanded page most recent
+    touchFrame(pageFrames[page]);
+}
+
+const unsigned char *PagedCity::fetchPage(int page) const
+{
+    int frame = pageFrames[page];
+    if (frame != -1)
+    {
+        cacheHits++;
+        touchFrame(frame);
+        return frames + (size_t)frame * pageSize;
+    }
+
+    pageFaults++;
+    if (loadPage(page) == -1)
+    {
+        return nullptr;
+    }
+    prefetchAfter(page);
+    return frames + (size_t)pageFrames[page] * pageSize;
+}
+
+bool PagedCity::readBytes(long long offset, unsigned char *destination, int length) const
+{
+    while (length > 0)
+    {
+        int page = (int)(offset / pageSize);
+        int inPage = (int)(offset % pageSize);
+        int chunk = pageSize - inPage < length ? pageSize - inPage : length;
+
+        if (page >= pageCount)
+        {
+            return false;
+        }
+        const unsigned char *data = fetchPage(page);
+        if (data == nullptr)
+        {
+            return false;
+        }
+        memcpy(destination, data + inPage, chunk);
+
+        destination += chunk;
+        offset += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+int PagedCity::readRoads(int nodeId, int *neighborArray, int *distanceArray) const
+{
+    if (nodeId < 0 || nodeId >= nodeCount || !isOpen())
+    {
+        return -1;
+    }
+
+    long long offset = recordOffsets[nodeId];
+    int degree = 0;
+    if (!readBytes(offset, (unsigned char *)&degree, sizeof(int)))
+    {
+        return -1;
+    }
+    offset += sizeof(int);
+
+    // recordBuffer and the callers' arrays hold maxDegree roads
+    if (degree < 0 || degree > maxDegree)
+    {
+        cout << "Error: Corrupt road record for location " << nodeId << " in the page file!" << endl;
+        return -1;
+    }
+    if (!readBytes(offset, (unsigned char *)recordBuffer, 2 * sizeof(int) * degree))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < degree; i++)
+    {
+        neighborArray[i] = recordBuffer[2 * i];
+        distanceArray[i] = recordBuffer[2 * i + 1];
+        if (neighborArray[i] < 0 || neighborArray[i] >= nodeCount)
+        {
+            cout << "Error: Corrupt road record for location " << nodeId << " in the page file!" << endl;
+            return -1;
+        }
+    }
+    return degree;
+}
+
+int PagedCity::getNodeCount() const
+{
+    return nodeCount;
+}
+
+bool PagedCity::locationExists(int id) const
+{
+    return id >= 0 && id < nodeCount;
+}
+
+int PagedCity::getZone(int nodeId) const
+{
+    if (!locationExists(nodeId))
+    {
+        return -1;
+    }
+    return zones[nodeId];
+}
+
+City::ShortestPathResult PagedCity::dijkstra(int source) const
+{
+    City::ShortestPathResult result(nodeCount);
+
+    if (!locationExists(source))
+    {
+        cout << "Error: Source node " << source << " does not exist!" << endl;
+        return result;
+    }
+
+    int *neighbors = new int[maxDegree > 0 ? maxDegree : 1];
+    int *distances = new int[maxDegree > 0 ? maxDegree : 1];
+    MinHeap heap(64);
+
+    result.distances[source] = 0;
+    heap.push(0, source);
+
+    int distance, u;
+    while (heap.pop(distance, u))
+    {
+        if (distance > result.distances[u])
+        {
+            continue; // Stale heap entry
+        }
+
+        int degree = readRoads(u, neighbors, distances);
+        for (int i = 0; i < degree; i++)
+        {
+            int v = neighbors[i];
+            int newDistance = distance + distances[i];
+            if (newDistance < result.distances[v])
+            {
+                result.distances[v] = newDistance;
+                result.predecessors[v] = u;
+                heap.push(newDistance, v);
+            }
+        }
+    }
+
+    delete[] neighbors;
+    delete[] distances;
+    return result;
+}
+
+int PagedCity::getShortestDistance(int source, int destination) const
+{
+    if (!locationExists(source) || !locationExists(destination))
+    {
+        return -1;
+    }
+
+    int *best = new int[nodeCount];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        best[i] = INT_MAX;
+    }
+    int *neighbors = new int[maxDegree > 0 ? maxDegree : 1];
+    int *distances = new int[maxDegree > 0 ? maxDegree : 1];
+    MinHeap heap(64);
+
+    best[source] = 0;
+    heap.push(0, source);
+
+    int answer = -1;
+    int distance, u;
+    while (heap.pop(distance, u))
+    {
+        if (distance > best[u])
+        {
+            continue;
+        }
+        if (u == destination)
+        {
+            answer = distance; // Settled: no need to touch further pages
+            break;
+        }
+
+        int degree = readRoads(u, neighbors, distances);
+        for (int i = 0; i < degree; i++)
+        {
+            int v = neighbors[i];
+            if (distance + distances[i] < best[v])
+            {
+                best[v] = distance + distances[i];
+                heap.push(best[v], v);
+            }
+        }
+    }
+
+    delete[] best;
+    delete[] neighbors;
+    delete[] distances;
+    return answer;
+}
+
+long long PagedCity::getPageFaults() const { return pageFaults; }
+long long PagedCity::getCacheHits() const { return cacheHits; }
+long long PagedCity::getPrefetches() const { return prefetches; }
+int PagedCity::getPageCount() const { return pageCount; }
+int PagedCity::getCachedPageLimit() const { return frameCount; }
+
+void PagedCity::resetCounters()
+{
+    pageFaults = 0;
+    cacheHits = 0;
+    prefetches = 0;
+}
+
+void PagedCity::printCacheStats() const
+{
+    long long requests = pageFaults + cacheHits;
+
+    cout << "\n=== Paged City Cache Stats ===" << endl;
+    cout << "Pages on disk: " << pageCount << " x " << pageSize << " bytes" << endl;
+    cout << "Cache limit: " << frameCount << " pages" << endl;
+    cout << "Page faults: " << pageFaults << endl;
+    cout << "Cache hits: " << cacheHits << endl;
+    cout << "Prefetched pages: " << prefetches << endl;
+    if (requests > 0)
+    {
+        ios::fmtflags flags = cout.flags();
+        streamsize precision = cout.precision();
+        cout << "Hit ratio: " << fixed << setprecision(2)
+             << (100.0 * cacheHits / requests) << "%" << endl;
+        cout.flags(flags);
+        cout.precision(precision);
+    }
+    cout << "==============================" << endl;
+}
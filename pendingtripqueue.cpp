@@ -0,0 +1,182 @@
+#include "PendingTripQueue.h"
+
+// ==================== PendingTripQueue Implementation ====================
+
+PendingTripQueue::PendingTripQueue(int initialCapacity) : count(0)
+{
+    capacity = initialCapacity > 0 ? initialCapacity : 16;
+    entries = new PendingTrip[capacity];
+}
+
+PendingTripQueue::~PendingTripQueue()
+{
+    delete[] entries;
+}
+
+bool PendingTripQueue::before(const PendingTrip &a, const PendingTrip &b)
+{
+    if (a.priority != b.priority)
+    {
+        return a.priority > b.priority;
+    }
+    return a.sequence < b.sequence;
+}
+
+void PendingTripQueue::resize()
+{
+    capacity *= 2;
+    PendingTrip *newEntries = new PendingTrip[capacity];
+
+    for (int i = 0; i < count; i++)
+    {
+        newEntries[i] = entries[i];
+    }
+
+    delete[] entries;
+    entries = newEntries;
+}
+
+void PendingTripQueue::siftUp(int index)
+{
+    PendingTrip entry = entries[index];
+
+    while (index > 0)
+    {
+        int parent = (index - 1) / 2;
+        if (!before(entry, entries[parent]))
+        {
+            break;
+        }
+        entries[index] = entries[parent];
+        index = parent;
+    }
+
+    entries[index] = entry;
+}
+
+void PendingTripQueue::siftDown(int index)
+{
+    PendingTrip entry = entries[index];
+
+    while (true)
+    {
+        int child = 2 * index + 1;
+        if (child >= count)
+        {
+            break;
+        }
+        if (child + 1 < count && before(entries[child + 1], entries[child]))
+        {
+            child++;
+        }
+        if (!before(entries[child], entry))
+        {
+            break;
+        }
+        entries[index] = entries[child];
+        index = child;
+    }
+
+    entries[index] = entry;
+}
+
+int PendingTripQueue::indexOf(int tripId) const
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (entries[i].tripId == tripId)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void PendingTripQueue::push(const PendingTrip &entry)
+{
+    if (count == capacity)
+    {
+        resize();
+    }
+
+    entries[count] = entry;
+    siftUp(count);
+    count++;
+}
+
+bool PendingTripQueue::pop(PendingTrip &entry)
+{
+    if (count == 0)
+    {
+        return false;
+    }
+
+    entry = entries[0];
+    count--;
+    if (count > 0)
+    {
+        entries[0] = entries[count];
+        siftDown(0);
+    }
+    return true;
+}
+
+bool PendingTripQueue::remove(int tripId)
+{
+    int index = indexOf(tripId);
+    if (index == -1)
+    {
+        return false;
+    }
+
+    // Fill the hole with the last entry, which may belong above or below it
+    count--;
+    if (index < count)
+    {
+        entries[index] = entries[count];
+        if (index > 0 && before(entries[index], entries[(index - 1) / 2]))
+        {
+            siftUp(index);
+        }
+        else
+        {
+            siftDown(index);
+        }
+    }
+    return true;
+}
+
+bool PendingTripQueue::setPriority(int tripId, int priority)
+{
+    int index = indexOf(tripId);
+    if (index == -1)
+    {
+        return false;
+    }
+
+    PendingTrip entry = entries[index];
+    entry.priority = priority;
+    remove(tripId);
+    push(entry);
+    return true;
+}
+
+bool PendingTripQueue::contains(int tripId) const
+{
+    return indexOf(tripId) != -1;
+}
+
+bool PendingTripQueue::isEmpty() const
+{
+    return count == 0;
+}
+
+int PendingTripQueue::getCount() const
+{
+    return count;
+}
+
+void PendingTripQueue::clear()
+{
+    count = 0;
+}
@@ -0,0 +1,59 @@
+#include "RequestQueue.h"
+
+// ==================== RequestQueue Implementation ====================
+
+RequestQueue::RequestQueue() : head(&stub), tail(&stub) {}
+
+void RequestQueue::push(QueueNode *node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    QueueNode *previous = head.exchange(node, std::memory_order_acq_rel);
+    // Between the exchange and this store the list is briefly disconnected;
+    // pop() treats that window as empty and the consumer retries later
+    previous->next.store(node, std::memory_order_release);
+}
+
+QueueNode *RequestQueue::pop()
+{
+    QueueNode *first = tail;
+    QueueNode *next = first->next.load(std::memory_order_acquire);
+
+    // Skip over the sentinel
+    if (first == &stub)
+    {
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+
+    // first is the last linked node; a producer may be linking after it
+    if (first != head.load(std::memory_order_acquire))
+    {
+        return nullptr;
+    }
+
+    // Re-insert the sentinel so first can be handed out
+    push(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+bool RequestQueue::isEmpty() const
+{
+    return tail == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+}
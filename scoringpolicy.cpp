@@ -0,0 +1,71 @@
+#include "ScoringPolicy.h"
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+// ==================== Scoring Policy Implementation ====================
+
+int selectBestCandidate(ScoringPolicyKind kind, const int *costs, const unsigned char *sameZone,
+                        const int *ratings, int count)
+{
+    switch (kind)
+    {
+    case SCORING_DISTANCE:
+        return selectBestCandidate<DistanceScoring>(costs, sameZone, ratings, count);
+    case SCORING_ETA_WEIGHTED:
+        return selectBestCandidate<EtaWeightedScoring>(costs, sameZone, ratings, count);
+    case SCORING_RATING_WEIGHTED:
+        return selectBestCandidate<RatingWeightedScoring>(costs, sameZone, ratings, count);
+    case SCORING_ZONE_WEIGHTED:
+    default:
+        return selectBestCandidate<ZoneWeightedScoring>(costs, sameZone, ratings, count);
+    }
+}
+
+int scoreCandidate(ScoringPolicyKind kind, int cost, bool sameZone, int rating)
+{
+    switch (kind)
+    {
+    case SCORING_DISTANCE:
+        return DistanceScoring::score(cost, sameZone, rating);
+    case SCORING_ETA_WEIGHTED:
+        return EtaWeightedScoring::score(cost, sameZone, rating);
+    case SCORING_RATING_WEIGHTED:
+        return RatingWeightedScoring::score(cost, sameZone, rating);
+    case SCORING_ZONE_WEIGHTED:
+    default:
+        return ZoneWeightedScoring::score(cost, sameZone, rating);
+    }
+}
+
+const char *scoringPolicyName(ScoringPolicyKind kind)
+{
+    switch (kind)
+    {
+    case SCORING_DISTANCE:
+        return "distance";
+    case SCORING_ZONE_WEIGHTED:
+        return "zone";
+    case SCORING_ETA_WEIGHTED:
+        return "eta";
+    case SCORING_RATING_WEIGHTED:
+        return "rating";
+    default:
+        return "unknown";
+    }
+}
+
+bool parseScoringPolicy(const char *name, ScoringPolicyKind &kind)
+{
+    for (int k = 0; k < SCORING_POLICY_COUNT; k++)
+    {
+        if (strcmp(name, scoringPolicyName((ScoringPolicyKind)k)) == 0)
+        {
+            kind = (ScoringPolicyKind)k;
+            return true;
+        }
+    }
+    cout << "Error: Unknown scoring policy \"" << name << "\"!" << endl;
+    return false;
+}
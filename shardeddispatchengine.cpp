@@ -0,0 +1,267 @@
+#include "ShardedDispatchEngine.h"
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+const int ShardedDispatchEngine::FIRST_TRIP_ID = 1000;
+
+// ==================== ShardedDispatchEngine Implementation ====================
+
+ShardedDispatchEngine::ShardedDispatchEngine(City *cityPtr, int shards, int stealHops)
+    : city(cityPtr), shardCount(shards > 0 ? shards : 1),
+      maxStealHops(stealHops > 0 ? stealHops : 0), started(false),
+      inFlight(0), stealAttempts(0), stealSuccesses(0)
+{
+    engines = new DispatchEngine *[shardCount];
+    workers = new DispatchWorker *[shardCount];
+
+    for (int s = 0; s < shardCount; s++)
+    {
+        engines[s] = new DispatchEngine(city, FIRST_TRIP_ID + s, shardCount);
+        workers[s] = new DispatchWorker(*engines[s]);
+    }
+
+    cout << "ShardedDispatchEngine created with " << shardCount << " shards" << endl;
+}
+
+ShardedDispatchEngine::~ShardedDispatchEngine()
+{
+    stop();
+    for (int s = 0; s < shardCount; s++)
+    {
+        delete workers[s];
+        delete engines[s];
+    }
+    delete[] workers;
+    delete[] engines;
+}
+
+int ShardedDispatchEngine::getShardCount() const
+{
+    return shardCount;
+}
+
+int ShardedDispatchEngine::getShardForLocation(int nodeId) const
+{
+    int zone = city->getZone(nodeId);
+    return zone < 0 ? 0 : zone % shardCount;
+}
+
+int ShardedDispatchEngine::getShardOfTrip(int tripId) const
+{
+    int offset = tripId - FIRST_TRIP_ID;
+    return offset < 0 ? 0 : offset % shardCount;
+}
+
+bool ShardedDispatchEngine::registerDriver(Driver *driver)
+{
+    if (driver == nullptr)
+    {
+        return false;
+    }
+    if (started)
+    {
+        cout << "Error: Register drivers before starting the sharded engine!" << endl;
+        return false;
+    }
+    return engines[getShardForLocation(driver->getCurrentLocation())]->registerDriver(driver);
+}
+
+Driver *ShardedDispatchEngine::createDriver(int driverId, int locationId, int zone)
+{
+    if (started)
+    {
+        cout << "Error: Register drivers before starting the sharded engine!" << endl;
+        return nullptr;
+    }
+    return engines[getShardForLocation(locationId)]->createDriver(driverId, locationId, zone);
+}
+
+bool ShardedDispatchEngine::start()
+{
+    if (started)
+    {
+        return true;
+    }
+    if (city->hasDistanceCache())
+    {
+        cout << "Cannot start sharded engine: The city's distance cache is not thread-safe!" << endl;
+        return false;
+    }
+
+    // Shards read the city concurrently; build lazy structures up front
+    city->prepareForConcurrentReads();
+
+    started = true;
+    for (int s = 0; s < shardCount; s++)
+    {
+        workers[s]->start();
+    }
+    return true;
+}
+
+void ShardedDispatchEngine::stop()
+{
+    if (!started)
+    {
+        return;
+    }
+
+    // Steal messages may still be bouncing between shards
+    while (inFlight.load() > 0)
+    {
+        this_thread::yield();
+    }
+
+    for (int s = 0; s < shardCount; s++)
+    {
+        workers[s]->stop();
+    }
+    started = false;
+}
+
+int ShardedDispatchEngine::victimShard(int originShard, int hop) const
+{
+    // Each other shard is asked at most once
+    if (hop >= maxStealHops || hop >= shardCount - 1)
+    {
+        return -1;
+    }
+
+    int distance = hop / 2 + 1;
+    int offset = (hop % 2 == 0) ? distance : -distance;
+    return ((originShard + offset) % shardCount + shardCount) % shardCount;
+}
+
+void ShardedDispatchEngine::finishRequest(DispatchEngine &origin, int tripId,
+                                          shared_ptr<promise<TripRequestResult>> result)
+{
+    TripRequestResult answer;
+    Trip *trip = origin.findTripById(tripId);
+    if (trip != nullptr)
+    {
+        answer.tripId = trip->getId();
+        answer.driverId = trip->getDriverId();
+        answer.state = trip->getState();
+        answer.fare = trip->getFare();
+    }
+    result->set_value(answer);
+    inFlight.fetch_sub(1);
+}
+
+void ShardedDispatchEngine::requestSteal(int originShard, int tripId, int pickup, int hop,
+                                         shared_ptr<promise<TripRequestResult>> result)
+{
+    int victim = victimShard(originShard, hop);
+    if (victim == -1)
+    {
+        // Hop budget exhausted: the trip waits in its shard's pending queue
+        workers[originShard]->submitTask([this, tripId, result](DispatchEngine &origin)
+                                         { finishRequest(origin, tripId, result); });
+        return;
+    }
+
+    stealAttempts.fetch_add(1);
+    workers[victim]->submitTask(
+        [this, originShard, tripId, pickup, hop, result](DispatchEngine &victimEngine)
+        {
+            Driver *driver = victimEngine.findBestDriver(pickup);
+            if (driver == nullptr)
+            {
+                requestSteal(originShard, tripId, pickup, hop + 1, result);
+                return;
+            }
+
+            // Hand the driver over; from now on only the origin shard touches it
+            // (its memory stays in the victim's pool, which lives as long as the shards)
+            victimEngine.detachDriver(driver->getId());
+            workers[originShard]->submitTask(
+                [this, driver, tripId, result](DispatchEngine &origin)
+                {
+                    // Registering offers the driver to the shard's pending queue,
+                    // which may hand it this trip or one that has waited longer
+                    origin.registerDriver(driver);
+                    Trip *trip = origin.findTripById(tripId);
+                    if (trip != nullptr && trip->getState() == REQUESTED && driver->isAvailable() &&
+                        origin.assignDriverToTrip(tripId, driver->getId()))
+                    {
+                        origin.startTrip(tripId);
+                    }
+                    if (trip != nullptr && trip->getDriverId() == driver->getId())
+                    {
+                        stealSuccesses.fetch_add(1);
+                    }
+                    finishRequest(origin, tripId, result);
+                });
+        });
+}
+
+future<TripRequestResult> ShardedDispatchEngine::submitTripRequest(const Rider &rider)
+{
+    shared_ptr<promise<TripRequestResult>> result = make_shared<promise<TripRequestResult>>();
+    future<TripRequestResult> answer = result->get_future();
+
+    int shard = getShardForLocation(rider.getPickupLocation());
+    int riderId = rider.getId();
+    int pickup = rider.getPickupLocation();
+    int dropoff = rider.getDropoffLocation();
+
+    inFlight.fetch_add(1);
+    workers[shard]->submitTask(
+        [this, shard, riderId, pickup, dropoff, result](DispatchEngine &engine)
+        {
+            Rider request(riderId, pickup, dropoff);
+            Trip *trip = engine.requestTrip(request);
+
+            if (trip == nullptr)
+            {
+                result->set_value(TripRequestResult());
+                inFlight.fetch_sub(1);
+                return;
+            }
+            if (trip->getDriverId() != -1)
+            {
+                finishRequest(engine, trip->getId(), result);
+                return;
+            }
+            requestSteal(shard, trip->getId(), pickup, 0, result);
+        });
+
+    return answer;
+}
+
+future<bool> ShardedDispatchEngine::submitCompleteTrip(int tripId)
+{
+    return workers[getShardOfTrip(tripId)]->submitCompleteTrip(tripId);
+}
+
+future<bool> ShardedDispatchEngine::submitCancelTrip(int tripId)
+{
+    return workers[getShardOfTrip(tripId)]->submitCancelTrip(tripId);
+}
+
+long long ShardedDispatchEngine::getStealAttempts() const
+{
+    return stealAttempts.load();
+}
+
+long long ShardedDispatchEngine::getSuccessfulSteals() const
+{
+    return stealSuccesses.load();
+}
+
+void ShardedDispatchEngine::printStatus() const
+{
+    cout << "\n=== Sharded Dispatch Status ===" << endl;
+    cout << "Shards: " << shardCount << ", Max steal hops: " << maxStealHops << endl;
+    cout << "Steal attempts: " << stealAttempts.load()
+         << ", Successful steals: " << stealSuccesses.load() << endl;
+    for (int s = 0; s < shardCount; s++)
+    {
+        cout << "Shard " << s << ": " << engines[s]->getTotalDriverCount() << " drivers ("
+             << engines[s]->getAvailableDriverCount() << " available), "
+             << engines[s]->getTotalTripCount() << " trips" << endl;
+    }
+    cout << "===============================" << endl;
+}
@@ -0,0 +1,273 @@
+#include "TravelTimeProfiles.h"
+#include <iostream>
+
+using namespace std;
+
+const int INITIAL_PROFILE_CAPACITY = 4;
+const int INITIAL_POINT_CAPACITY = 32;
+
+// ==================== TravelTimeProfiles Implementation ====================
+
+TravelTimeProfiles::TravelTimeProfiles()
+    : profileCount(0), profileCapacity(INITIAL_PROFILE_CAPACITY),
+      pointCount(0), pointCapacity(INITIAL_POINT_CAPACITY)
+{
+    pointOffsets = new int[profileCapacity + 1];
+    hashes = new unsigned int[profileCapacity];
+    steepestDrops = new int[profileCapacity];
+    pointOffsets[0] = 0;
+
+    pointTimes = new unsigned short[pointCapacity];
+    pointFactors = new unsigned short[pointCapacity];
+}
+
+TravelTimeProfiles::~TravelTimeProfiles()
+{
+    delete[] pointOffsets;
+    delete[] hashes;
+    delete[] steepestDrops;
+    delete[] pointTimes;
+    delete[] pointFactors;
+}
+
+unsigned int TravelTimeProfiles::hashPoints(const int *times, const int *factors, int count)
+{
+    // FNV-1a over the breakpoint values
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < count; i++)
+    {
+        hash = (hash ^ (unsigned int)times[i]) * 16777619u;
+        hash = (hash ^ (unsigned int)factors[i]) * 16777619u;
+    }
+    return hash;
+}
+
+bool TravelTimeProfiles::samePoints(int profileId, const int *times, const int *factors, int count) const
+{
+    int start = pointOffsets[profileId];
+    if (pointOffsets[profileId + 1] - start != count)
+    {
+        return false;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (pointTimes[start + i] != times[i] || pointFactors[start + i] != factors[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+int TravelTimeProfiles::addProfile(const int *times, const int *factors, int count)
+{
+    if (times == nullptr || factors == nullptr || count < 1)
+    {
+        cout << "Error: A travel-time profile needs at least one breakpoint!" << endl;
+        return -1;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        if (times[i] < 0 || times[i] >= PERIOD || (i > 0 && times[i] <= times[i - 1]))
+        {
+            cout << "Error: Profile times must be increasing minutes of day!" << endl;
+            return -1;
+        }
+        if (factors[i] <= 0 || factors[i] > 65535)
+        {
+            cout << "Error: Profile factors must be between 1 and 65535 per-mille!" << endl;
+            return -1;
+        }
+    }
+
+    // Share an identical existing profile
+    unsigned int hash = hashPoints(times, factors, count);
+    for (int p = 0; p < profileCount; p++)
+    {
+        if (hashes[p] == hash && samePoints(p, times, factors, count))
+        {
+            return p;
+        }
+    }
+
+    if (profileCount == profileCapacity)
+    {
+        int newCapacity = profileCapacity * 2;
+        int *newOffsets = new int[newCapacity + 1];
+        unsigned int *newHashes = new unsigned int[newCapacity];
+        int *newDrops = new int[newCapacity];
+        for (int p = 0; p < profileCount; p++)
+        {
+            newOffsets[p] = pointOffsets[p];
+            newHashes[p] = hashes[p];
+            newDrops[p] = steepestDrops[p];
+        }
+        newOffsets[profileCount] = pointOffsets[profileCount];
+        delete[] pointOffsets;
+        delete[] hashes;
+        delete[] steepestDrops;
+        pointOffsets = newOffsets;
+        hashes = newHashes;
+        steepestDrops = newDrops;
+        profileCapacity = newCapacity;
+    }
+
+    if (pointCount + count > pointCapacity)
+    {
+        int newCapacity = pointCapacity * 2;
+        while (newCapacity < pointCount + count)
+        {
+            newCapacity *= 2;
+        }
+        unsigned short *newTimes = new unsigned short[newCapacity];
+        unsigned short *newFactors = new unsigned short[newCapacity];
+        for (int i = 0; i < pointCount; i++)
+        {
+            newTimes[i] = pointTimes[i];
+            newFactors[i] = pointFactors[i];
+        }
+        delete[] pointTimes;
+        delete[] pointFactors;
+        pointTimes = newTimes;
+        pointFactors = newFactors;
+        pointCapacity = newCapacity;
+    }
+
+    int steepest = 0;
+    for (int i = 0; i < count; i++)
+    {
+        pointTimes[pointCount + i] = (unsigned short)times[i];
+        pointFactors[pointCount + i] = (unsigned short)factors[i];
+
+        // Segment to the next breakpoint, wrapping into the next day
+        int next = (i + 1) % count;
+        int span = (next == 0) ? times[0] + PERIOD - times[i] : times[next] - times[i];
+        int drop = factors[i] - factors[next];
+        if (drop > 0 && span > 0)
+        {
+            int perMinute = (drop + span - 1) / span;
+            if (perMinute > steepest)
+            {
+                steepest = perMinute;
+            }
+        }
+    }
+
+    int id = profileCount++;
+    hashes[id] = hash;
+    steepestDrops[id] = steepest;
+    pointCount += count;
+    pointOffsets[profileCount] = pointCount;
+    return id;
+}
+
+int TravelTimeProfiles::getProfileCount() const
+{
+    return profileCount;
+}
+
+int TravelTimeProfiles::getFactor(int profileId, int timeOfDay) const
+{
+    if (profileId < 0 || profileId >= profileCount)
+    {
+        return FREE_FLOW_FACTOR;
+    }
+
+    int start = pointOffsets[profileId];
+    int count = pointOffsets[profileId + 1] - start;
+    int t = timeOfDay % PERIOD;
+    if (t < 0)
+    {
+        t += PERIOD;
+    }
+    if (count == 1)
+    {
+        return pointFactors[start];
+    }
+
+    // Last breakpoint at or before t (binary search)
+    int low = 0;
+    int high = count - 1;
+    int before = -1;
+    while (low <= high)
+    {
+        int mid = (low + high) / 2;
+        if (pointTimes[start + mid] <= t)
+        {
+            before = mid;
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    // Before the first breakpoint the segment comes from the previous day
+    int fromIndex = before == -1 ? count - 1 : before;
+    int toIndex = (fromIndex + 1) % count;
+    int fromTime = pointTimes[start + fromIndex];
+    int toTime = pointTimes[start + toIndex];
+    if (toIndex == 0)
+    {
+        toTime += PERIOD;
+    }
+    if (before == -1)
+    {
+        fromTime -= PERIOD;
+        toTime -= PERIOD;
+    }
+
+    int fromFactor = pointFactors[start + fromIndex];
+    int toFactor = pointFactors[start + toIndex];
+    return fromFactor + (toFactor - fromFactor) * (t - fromTime) / (toTime - fromTime);
+}
+
+int TravelTimeProfiles::getTravelTime(int profileId, int freeFlowTime, int departureTime) const
+{
+    if (profileId < 0)
+    {
+        return freeFlowTime;
+    }
+
+    long long scaled = (long long)freeFlowTime * getFactor(profileId, departureTime);
+    int time = (int)((scaled + FREE_FLOW_FACTOR / 2) / FREE_FLOW_FACTOR);
+    return time > 0 ? time : 1;
+}
+
+bool TravelTimeProfiles::isFifo(int profileId, int freeFlowTime) const
+{
+    if (profileId < 0 || profileId >= profileCount)
+    {
+        return true;
+    }
+    return (long long)freeFlowTime * steepestDrops[profileId] <= FREE_FLOW_FACTOR;
+}
+
+long long TravelTimeProfiles::getMemoryBytes() const
+{
+    return (long long)(profileCapacity + 1) * sizeof(int) +
+           (long long)profileCapacity * (sizeof(unsigned int) + sizeof(int)) +
+           (long long)pointCapacity * 2 * sizeof(unsigned short);
+}
+
+void TravelTimeProfiles::print() const
+{
+    cout << "\n=== Travel-Time Profiles ===" << endl;
+    if (profileCount == 0)
+    {
+        cout << "No profiles defined." << endl;
+    }
+    for (int p = 0; p < profileCount; p++)
+    {
+        cout << "Profile " << p << ":";
+        for (int i = pointOffsets[p]; i < pointOffsets[p + 1]; i++)
+        {
+            int minute = pointTimes[i];
+            cout << " " << minute / 60 << ":" << (minute % 60 < 10 ? "0" : "") << minute % 60
+                 << "=x" << pointFactors[i] / 1000.0;
+        }
+        cout << endl;
+    }
+    cout << "============================" << endl;
+}
@@ -1,26 +1,99 @@
 #include "Trip.h"
 #include <iostream>
+#include <cstring>
+#if !defined(__GNUC__) && !defined(__clang__)
+#include <mutex>
+#endif
 
 using namespace std;
 
+// The record is plain data, so state and driver ID are accessed through
+// these instead of std::atomic members (which would make it non-copyable)
+#if defined(__GNUC__) || defined(__clang__)
+template <class T>
+static inline T atomicLoad(const T *field)
+{
+    return __atomic_load_n(field, __ATOMIC_ACQUIRE);
+}
+
+template <class T>
+static inline void atomicStore(T *field, T value)
+{
+    __atomic_store_n(field, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Compare-and-swap; on failure writes the current value into expected
+ */
+template <class T>
+static inline bool atomicCompareExchange(T *field, T &expected, T desired)
+{
+    return __atomic_compare_exchange_n(field, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#else
+static mutex recordLock; // One lock for every trip where the builtins are unavailable
+
+template <class T>
+static inline T atomicLoad(const T *field)
+{
+    lock_guard<mutex> guard(recordLock);
+    return *field;
+}
+
+template <class T>
+static inline void atomicStore(T *field, T value)
+{
+    lock_guard<mutex> guard(recordLock);
+    *field = value;
+}
+
+template <class T>
+static inline bool atomicCompareExchange(T *field, T &expected, T desired)
+{
+    lock_guard<mutex> guard(recordLock);
+    if (*field != expected)
+    {
+        expected = *field;
+        return false;
+    }
+    *field = desired;
+    return true;
+}
+#endif
+
 // Initialize static constants
 const float Trip::BASE_FARE = 50.0f;
 const float Trip::RATE_PER_KM = 10.0f;
 
 // ==================== Trip Implementation ====================
 
-Trip::Trip() : id(-1), riderId(-1), driverId(-1),
-               pickupLocation(-1), dropoffLocation(-1),
-               distance(0), state(REQUESTED), fare(0.0f)
+Trip::Trip()
 {
     // Default constructor creates an invalid trip
+    memset(&record, 0, sizeof(record));
+    record.id = -1;
+    record.riderId = -1;
+    record.driverId = -1;
+    record.pickupLocation = -1;
+    record.dropoffLocation = -1;
+    record.eta = -1;
+    record.pickupDistance = -1;
+    record.state = REQUESTED;
 }
 
 Trip::Trip(int tripId, int rider, int pickup, int dropoff, int dist)
-    : id(tripId), riderId(rider), driverId(-1),
-      pickupLocation(pickup), dropoffLocation(dropoff),
-      distance(dist), state(REQUESTED)
 {
+    memset(&record, 0, sizeof(record));
+    record.id = tripId;
+    record.riderId = rider;
+    record.driverId = -1;
+    record.pickupLocation = pickup;
+    record.dropoffLocation = dropoff;
+    record.distance = dist;
+    record.eta = -1;
+    record.pickupDistance = -1;
+    record.state = REQUESTED;
 
     // Validate input
     if (tripId < 0)
@@ -41,7 +114,7 @@ Trip::Trip(int tripId, int rider, int pickup, int dropoff, int dist)
     if (dist <= 0)
     {
         cout << "Warning: Trip distance should be positive!" << endl;
-        distance = 1; // Default minimum distance
+        record.distance = 1; // Default minimum distance
     }
 
     if (pickup == dropoff)
@@ -52,64 +125,86 @@ Trip::Trip(int tripId, int rider, int pickup, int dropoff, int dist)
     // Calculate initial fare
     calculateFare();
 
-    cout << "Trip " << id << " created for rider " << riderId
-         << " from " << pickupLocation << " to " << dropoffLocation
-         << " (distance: " << distance << "km)" << endl;
+    cout << "Trip " << record.id << " created for rider " << record.riderId
+         << " from " << record.pickupLocation << " to " << record.dropoffLocation
+         << " (distance: " << record.distance << "km)" << endl;
+}
+
+Trip::Trip(const TripRecord &saved) : record(saved)
+{
 }
 
 Trip::~Trip()
 {
-    cout << "Trip " << id << " destroyed." << endl;
+    cout << "Trip " << record.id << " destroyed." << endl;
 }
 
-bool Trip::isValidTransition(TripState newState) const
+bool Trip::transitionFrom(TripState expected, TripState newState, TripState &observed)
 {
-    // Define valid state transitions
-    switch (state)
+    observed = expected;
+    if (!isValidTransition(expected, newState))
     {
-    case REQUESTED:
-        // Can only go to ASSIGNED or CANCELLED
-        return (newState == ASSIGNED || newState == CANCELLED);
+        return false;
+    }
 
-    case ASSIGNED:
-        // Can go to ONGOING or CANCELLED
-        return (newState == ONGOING || newState == CANCELLED);
+    // On failure the swap writes the current state into current
+    unsigned char current = (unsigned char)expected;
+    if (!atomicCompareExchange(&record.state, current, (unsigned char)newState))
+    {
+        observed = (TripState)current;
+        return false;
+    }
 
-    case ONGOING:
-        // Can go to COMPLETED or CANCELLED
-        return (newState == COMPLETED || newState == CANCELLED);
+    reportTransition(expected, newState);
+    return true;
+}
 
-    case COMPLETED:
-        // Final state - no further transitions allowed
-        return false;
+void Trip::reportTransition(TripState oldState, TripState newState) const
+{
+    cout << "Trip " << record.id << " state changed from "
+         << stateToString(oldState) << " to "
+         << stateToString(newState) << endl;
 
+    // Additional actions based on new state
+    switch (newState)
+    {
+    case COMPLETED:
+        cout << "Trip " << record.id << " completed successfully. Fare: " << getFare() << endl;
+        break;
     case CANCELLED:
-        // Final state - no further transitions allowed
-        return false;
-
+        cout << "Trip " << record.id << " cancelled. ";
+        if (oldState == ONGOING)
+        {
+            cout << "Partial fare may apply." << endl;
+        }
+        else
+        {
+            cout << "No charges applied." << endl;
+        }
+        break;
     default:
-        return false;
+        break;
     }
 }
 
 void Trip::calculateFare()
 {
-    fare = BASE_FARE + (distance * RATE_PER_KM);
+    record.fareCents = TripRecord::toFixedFare(BASE_FARE + (record.distance * RATE_PER_KM) + record.toll);
 }
 
 int Trip::getId() const
 {
-    return id;
+    return record.id;
 }
 
 int Trip::getRiderId() const
 {
-    return riderId;
+    return record.riderId;
 }
 
 int Trip::getDriverId() const
 {
-    return driverId;
+    return atomicLoad(&record.driverId);
 }
 
 void Trip::setDriverId(int driverId)
@@ -120,23 +215,23 @@ void Trip::setDriverId(int driverId)
         return;
     }
 
-    this->driverId = driverId;
-    cout << "Driver " << driverId << " assigned to trip " << id << endl;
+    atomicStore(&record.driverId, (int32_t)driverId);
+    cout << "Driver " << driverId << " assigned to trip " << record.id << endl;
 }
 
 int Trip::getPickupLocation() const
 {
-    return pickupLocation;
+    return record.pickupLocation;
 }
 
 int Trip::getDropoffLocation() const
 {
-    return dropoffLocation;
+    return record.dropoffLocation;
 }
 
 int Trip::getDistance() const
 {
-    return distance;
+    return record.distance;
 }
 
 void Trip::setDistance(int dist)
@@ -147,130 +242,202 @@ void Trip::setDistance(int dist)
         return;
     }
 
-    distance = dist;
+    record.distance = dist;
     calculateFare(); // Recalculate fare with new distance
 
-    cout << "Trip " << id << " distance updated to " << distance
-         << "km, new fare: " << fare << endl;
+    cout << "Trip " << record.id << " distance updated to " << record.distance
+         << "km, new fare: " << getFare() << endl;
 }
 
 TripState Trip::getState() const
 {
-    return state;
+    return (TripState)atomicLoad(&record.state);
 }
 
-float Trip::getFare() const
+int Trip::getEta() const
 {
-    return fare;
+    return record.eta;
 }
 
-bool Trip::transitionTo(TripState newState)
+void Trip::setEta(int minutes)
+{
+    record.eta = minutes;
+}
+
+int Trip::getPickupDistance() const
+{
+    return record.pickupDistance;
+}
+
+void Trip::setPickupDistance(int cost)
+{
+    record.pickupDistance = cost;
+}
+
+int Trip::getToll() const
+{
+    return record.toll;
+}
+
+void Trip::setToll(int amount)
 {
-    // Check if transition is valid
-    if (!isValidTransition(newState))
+    if (amount < 0)
     {
-        cout << "Error: Invalid transition from " << stateToString(state)
-             << " to " << stateToString(newState) << " for trip " << id << endl;
-        return false;
+        cout << "Error: Toll cannot be negative!" << endl;
+        return;
+    }
+    if (amount > TripRecord::MAX_TOLL)
+    {
+        cout << "Error: Toll " << amount << " exceeds " << TripRecord::MAX_TOLL << "!" << endl;
+        return;
     }
 
-    // Perform the transition
-    TripState oldState = state;
-    state = newState;
+    record.toll = (uint16_t)amount;
+    calculateFare();
+}
 
-    cout << "Trip " << id << " state changed from "
-         << stateToString(oldState) << " to "
-         << stateToString(newState) << endl;
+int Trip::getPriority() const
+{
+    return record.priority;
+}
 
-    // Additional actions based on new state
-    switch (newState)
+void Trip::setPriority(int level)
+{
+    if (level < 0 || level > TripRecord::MAX_PRIORITY)
     {
-    case COMPLETED:
-        cout << "Trip " << id << " completed successfully. Fare: " << fare << endl;
-        break;
-    case CANCELLED:
-        cout << "Trip " << id << " cancelled. ";
-        if (oldState == ONGOING)
-        {
-            cout << "Partial fare may apply." << endl;
-        }
-        else
+        cout << "Error: Priority must be between 0 and " << TripRecord::MAX_PRIORITY << "!" << endl;
+        return;
+    }
+
+    record.priority = (uint8_t)level;
+}
+
+float Trip::getFare() const
+{
+    return record.getFare();
+}
+
+TripRecord Trip::getRecord() const
+{
+    TripRecord copy = record;
+    copy.driverId = atomicLoad(&record.driverId);
+    copy.state = atomicLoad(&record.state);
+    return copy;
+}
+
+bool Trip::transitionTo(TripState newState)
+{
+    unsigned char current = atomicLoad(&record.state);
+    while (isValidTransition((TripState)current, newState))
+    {
+        // A failed swap refreshes current; re-check it against the table
+        if (atomicCompareExchange(&record.state, current, (unsigned char)newState))
         {
-            cout << "No charges applied." << endl;
+            reportTransition((TripState)current, newState);
+            return true;
         }
-        break;
-    default:
-        break;
     }
 
-    return true;
+    cout << "Error: Invalid transition from " << stateToString((TripState)current)
+         << " to " << stateToString(newState) << " for trip " << record.id << endl;
+    return false;
+}
+
+void Trip::restore(TripState savedState, int savedDriverId)
+{
+    atomicStore(&record.driverId, (int32_t)savedDriverId);
+    atomicStore(&record.state, (unsigned char)savedState);
 }
 
 bool Trip::assignDriver(int driverId)
 {
-    // Can only assign driver if in REQUESTED state
-    if (state != REQUESTED)
+    if (driverId < 0)
     {
-        cout << "Error: Cannot assign driver to trip " << id
-             << " in state " << stateToString(state) << endl;
+        cout << "Error: Cannot set negative driver ID!" << endl;
+        return false;
+    }
+
+    // Claim the driver slot first so two concurrent assignments cannot both write it
+    int32_t unassigned = -1;
+    if (!atomicCompareExchange(&record.driverId, unassigned, (int32_t)driverId))
+    {
+        cout << "Error: Cannot assign driver to trip " << record.id
+             << ", driver " << unassigned << " already assigned" << endl;
+        return false;
+    }
+
+    TripState observed;
+    if (!transitionFrom(REQUESTED, ASSIGNED, observed))
+    {
+        atomicStore(&record.driverId, (int32_t)-1); // Release the claim
+        cout << "Error: Cannot assign driver to trip " << record.id
+             << " in state " << stateToString(observed) << endl;
         return false;
     }
 
-    setDriverId(driverId);
-    return transitionTo(ASSIGNED);
+    cout << "Driver " << driverId << " assigned to trip " << record.id << endl;
+    return true;
 }
 
 bool Trip::startTrip()
 {
     // Can only start trip if in ASSIGNED state
-    if (state != ASSIGNED)
+    TripState observed;
+    if (!transitionFrom(ASSIGNED, ONGOING, observed))
     {
-        cout << "Error: Cannot start trip " << id
-             << " in state " << stateToString(state) << endl;
+        cout << "Error: Cannot start trip " << record.id
+             << " in state " << stateToString(observed) << endl;
         return false;
     }
 
-    cout << "Driver " << driverId << " picked up rider " << riderId
-         << " for trip " << id << endl;
-    return transitionTo(ONGOING);
+    cout << "Driver " << getDriverId() << " picked up rider " << record.riderId
+         << " for trip " << record.id << endl;
+    return true;
 }
 
 bool Trip::completeTrip()
 {
     // Can only complete trip if in ONGOING state
-    if (state != ONGOING)
+    TripState observed;
+    if (!transitionFrom(ONGOING, COMPLETED, observed))
     {
-        cout << "Error: Cannot complete trip " << id
-             << " in state " << stateToString(state) << endl;
+        cout << "Error: Cannot complete trip " << record.id
+             << " in state " << stateToString(observed) << endl;
         return false;
     }
 
-    cout << "Driver " << driverId << " dropped off rider " << riderId
-         << " for trip " << id << endl;
-    return transitionTo(COMPLETED);
+    cout << "Driver " << getDriverId() << " dropped off rider " << record.riderId
+         << " for trip " << record.id << endl;
+    return true;
 }
 
 bool Trip::cancelTrip()
 {
     // Can cancel from REQUESTED, ASSIGNED, or ONGOING states
-    if (state == COMPLETED || state == CANCELLED)
+    unsigned char current = atomicLoad(&record.state);
+    while (isValidTransition((TripState)current, CANCELLED))
     {
-        cout << "Error: Cannot cancel trip " << id
-             << " in final state " << stateToString(state) << endl;
-        return false;
+        if (atomicCompareExchange(&record.state, current, (unsigned char)CANCELLED))
+        {
+            reportTransition((TripState)current, CANCELLED);
+            return true;
+        }
     }
 
-    return transitionTo(CANCELLED);
+    cout << "Error: Cannot cancel trip " << record.id
+         << " in final state " << stateToString((TripState)current) << endl;
+    return false;
 }
 
 bool Trip::isFinalState() const
 {
-    return (state == COMPLETED || state == CANCELLED);
+    TripState current = getState();
+    return (current == COMPLETED || current == CANCELLED);
 }
 
 bool Trip::isActive() const
 {
-    return (state == REQUESTED || state == ASSIGNED || state == ONGOING);
+    return !isFinalState();
 }
 
 const char *Trip::stateToString(TripState state)
@@ -295,14 +462,19 @@ const char *Trip::stateToString(TripState state)
 void Trip::printInfo() const
 {
     cout << "\n=== Trip Information ===" << endl;
-    cout << "Trip ID: " << id << endl;
-    cout << "Rider ID: " << riderId << endl;
-    cout << "Driver ID: " << (driverId == -1 ? "Not assigned" : to_string(driverId)) << endl;
-    cout << "Pickup: " << pickupLocation << endl;
-    cout << "Dropoff: " << dropoffLocation << endl;
-    cout << "Distance: " << distance << "km" << endl;
-    cout << "State: " << stateToString(state) << endl;
-    cout << "Fare: " << fare << endl;
+    cout << "Trip ID: " << record.id << endl;
+    cout << "Rider ID: " << record.riderId << endl;
+    int driver = getDriverId();
+    cout << "Driver ID: " << (driver == -1 ? "Not assigned" : to_string(driver)) << endl;
+    cout << "Pickup: " << record.pickupLocation << endl;
+    cout << "Dropoff: " << record.dropoffLocation << endl;
+    cout << "Distance: " << record.distance << "km" << endl;
+    cout << "State: " << stateToString(getState()) << endl;
+    cout << "Fare: " << getFare() << endl;
+    if (record.eta != -1)
+    {
+        cout << "ETA: " << record.eta << " min" << endl;
+    }
     cout << "Active: " << (isActive() ? "Yes" : "No") << endl;
     cout << "Final State: " << (isFinalState() ? "Yes" : "No") << endl;
     cout << "========================" << endl;
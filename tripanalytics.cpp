@@ -0,0 +1,460 @@
+#include "TripAnalytics.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <climits>
+#include <thread>
+
+using namespace std;
+
+const int MIN_ROWS_PER_CHUNK = 1 << 16;     // Below this a thread costs more than it saves
+const int SUM_LANES = 8;                    // Independent partial sums per revenue loop
+const long long HISTOGRAM_CELLS = 1 << 20;  // Most histogram buckets across all chunks
+
+/**
+ * @brief 1 if a row passes the filter, else 0, evaluated without branches
+ */
+static inline int rowMask(const TripFilter &filter, int zone, int state, int finishTime)
+{
+    return ((filter.zone < 0) | (zone == filter.zone)) &
+           ((filter.state < 0) | (state == filter.state)) &
+           (finishTime >= filter.fromTime) & (finishTime < filter.toTime);
+}
+
+/**
+ * @brief Index of the nearest-rank percentile in a sorted sequence of n values
+ */
+static long long percentileRank(double fraction, long long n)
+{
+    long long rank = (long long)ceil(fraction * (double)n);
+    if (rank < 1)
+        rank = 1;
+    if (rank > n)
+        rank = n;
+    return rank - 1;
+}
+
+// ==================== TripFilter Implementation ====================
+
+TripFilter::TripFilter() : zone(-1), state(-1), fromTime(INT_MIN), toTime(INT_MAX)
+{
+}
+
+// ==================== TripAnalytics Implementation ====================
+
+TripAnalytics::TripAnalytics(const TripHistory &history, int threadCount)
+    : history(history), threadCount(1)
+{
+    setThreadCount(threadCount);
+}
+
+void TripAnalytics::setThreadCount(int count)
+{
+    if (count < 0)
+    {
+        cout << "Error: Thread count cannot be negative!" << endl;
+        return;
+    }
+    if (count == 0)
+    {
+        count = (int)thread::hardware_concurrency();
+    }
+    threadCount = count > 0 ? count : 1;
+}
+
+int TripAnalytics::getThreadCount() const
+{
+    return threadCount;
+}
+
+int TripAnalytics::getChunkCount() const
+{
+    int byRows = history.getCount() / MIN_ROWS_PER_CHUNK;
+    if (byRows < 1)
+        byRows = 1;
+    return threadCount < byRows ? threadCount : byRows;
+}
+
+template <class Work>
+void TripAnalytics::forEachChunk(Work work) const
+{
+    int chunks = getChunkCount();
+    int rows = history.getCount();
+    if (chunks == 1)
+    {
+        work(0, 0, rows);
+        return;
+    }
+
+    // Chunk 0 runs on the calling thread
+    thread *workers = new thread[chunks - 1];
+    for (int c = 1; c < chunks; c++)
+    {
+        int begin = (int)((long long)rows * c / chunks);
+        int end = (int)((long long)rows * (c + 1) / chunks);
+        workers[c - 1] = thread(work, c, begin, end);
+    }
+    work(0, 0, (int)((long long)rows / chunks));
+    for (int c = 0; c < chunks - 1; c++)
+    {
+        workers[c].join();
+    }
+    delete[] workers;
+}
+
+long long TripAnalytics::count(const TripFilter &filter) const
+{
+    const int *zones = history.getPickupZones();
+    const unsigned char *states = history.getStates();
+    const int *times = history.getFinishTimes();
+
+    int chunks = getChunkCount();
+    long long *partial = new long long[chunks];
+    forEachChunk([&](int chunk, int begin, int end)
+    {
+        long long matched = 0;
+        for (int i = begin; i < end; i++)
+        {
+            matched += rowMask(filter, zones[i], states[i], times[i]);
+        }
+        partial[chunk] = matched;
+    });
+
+    long long total = 0;
+    for (int c = 0; c < chunks; c++)
+    {
+        total += partial[c];
+    }
+    delete[] partial;
+    return total;
+}
+
+double TripAnalytics::totalRevenue(const TripFilter &filter) const
+{
+    const int *zones = history.getPickupZones();
+    const unsigned char *states = history.getStates();
+    const int *times = history.getFinishTimes();
+    const float *fares = history.getFares();
+
+    int chunks = getChunkCount();
+    double *partial = new double[chunks];
+    forEachChunk([&](int chunk, int begin, int end)
+    {
+        // Separate lanes keep the additions independent, so they vectorize
+        // without reordering a single floating-point sum
+        double lanes[SUM_LANES] = {0.0};
+        int i = begin;
+        for (; i + SUM_LANES <= end; i += SUM_LANES)
+        {
+            for (int k = 0; k < SUM_LANES; k++)
+            {
+                int row = i + k;
+                int keep = rowMask(filter, zones[row], states[row], times[row]) &
+                           (states[row] == COMPLETED);
+                lanes[k] += (double)(keep * fares[row]);
+            }
+        }
+        for (; i < end; i++)
+        {
+            int keep = rowMask(filter, zones[i], states[i], times[i]) & (states[i] == COMPLETED);
+            lanes[0] += (double)(keep * fares[i]);
+        }
+
+        double sum = 0.0;
+        for (int k = 0; k < SUM_LANES; k++)
+        {
+            sum += lanes[k];
+        }
+        partial[chunk] = sum;
+    });
+
+    double total = 0.0;
+    for (int c = 0; c < chunks; c++)
+    {
+        total += partial[c];
+    }
+    delete[] partial;
+    return total;
+}
+
+void TripAnalytics::revenueByZoneHour(const TripFilter &filter, double *out, int zoneCount) const
+{
+    if (zoneCount <= 0)
+    {
+        cout << "Error: Zone count must be positive!" << endl;
+        return;
+    }
+
+    const int *zones = history.getPickupZones();
+    const unsigned char *states = history.getStates();
+    const int *times = history.getFinishTimes();
+    const float *fares = history.getFares();
+
+    int cells = zoneCount * HOURS_PER_DAY;
+    int chunks = getChunkCount();
+    double *tables = new double[(size_t)chunks * cells]();
+    forEachChunk([&](int chunk, int begin, int end)
+    {
+        double *table = tables + (size_t)chunk * cells;
+        for (int i = begin; i < end; i++)
+        {
+            int zone = zones[i];
+            int keep = rowMask(filter, zone, states[i], times[i]) & (states[i] == COMPLETED) &
+                       ((unsigned)zone < (unsigned)zoneCount);
+            int hour = ((unsigned)times[i] / 60) % HOURS_PER_DAY;
+            // Rejected rows add zero to cell 0 instead of branching around the store
+            int cell = keep ? zone * HOURS_PER_DAY + hour : 0;
+            table[cell] += (double)(keep * fares[i]);
+        }
+    });
+
+    for (int cell = 0; cell < cells; cell++)
+    {
+        double sum = 0.0;
+        for (int c = 0; c < chunks; c++)
+        {
+            sum += tables[(size_t)c * cells + cell];
+        }
+        out[cell] = sum;
+    }
+    delete[] tables;
+}
+
+void TripAnalytics::countByZone(const TripFilter &filter, long long *out, int zoneCount) const
+{
+    if (zoneCount <= 0)
+    {
+        cout << "Error: Zone count must be positive!" << endl;
+        return;
+    }
+
+    const int *zones = history.getPickupZones();
+    const unsigned char *states = history.getStates();
+    const int *times = history.getFinishTimes();
+
+    int chunks = getChunkCount();
+    long long *tables = new long long[(size_t)chunks * zoneCount]();
+    forEachChunk([&](int chunk, int begin, int end)
+    {
+        long long *table = tables + (size_t)chunk * zoneCount;
+        for (int i = begin; i < end; i++)
+        {
+            int zone = zones[i];
+            int keep = rowMask(filter, zone, states[i], times[i]) &
+                       ((unsigned)zone < (unsigned)zoneCount);
+            table[keep ? zone : 0] += keep;
+        }
+    });
+
+    for (int zone = 0; zone < zoneCount; zone++)
+    {
+        long long sum = 0;
+        for (int c = 0; c < chunks; c++)
+        {
+            sum += tables[(size_t)c * zoneCount + zone];
+        }
+        out[zone] = sum;
+    }
+    delete[] tables;
+}
+
+long long TripAnalytics::pickupDistancePercentiles(const TripFilter &filter, const double *fractions,
+                                                   int fractionCount, int *out) const
+{
+    const int *zones = history.getPickupZones();
+    const unsigned char *states = history.getStates();
+    const int *times = history.getFinishTimes();
+    const int *pickupDistances = history.getPickupDistances();
+
+    // Pass 1: how many rows qualify and how large the distances get
+    int chunks = getChunkCount();
+    long long *chunkCounts = new long long[chunks];
+    int *chunkMax = new int[chunks];
+    forEachChunk([&](int chunk, int begin, int end)
+    {
+        long long matched = 0;
+        int largest = 0;
+        for (int i = begin; i < end; i++)
+        {
+            int distance = pickupDistances[i];
+            int keep = rowMask(filter, zones[i], states[i], times[i]) & (distance >= 0);
+            matched += keep;
+            int candidate = keep ? distance : 0;
+            largest = candidate > largest ? candidate : largest;
+        }
+        chunkCounts[chunk] = matched;
+        chunkMax[chunk] = largest;
+    });
+
+    long long total = 0;
+    int largest = 0;
+    for (int c = 0; c < chunks; c++)
+    {
+        total += chunkCounts[c];
+        largest = chunkMax[c] > largest ? chunkMax[c] : largest;
+    }
+    delete[] chunkMax;
+
+    if (total == 0)
+    {
+        delete[] chunkCounts;
+        return 0;
+    }
+
+    // One histogram per chunk, so the buckets are capped across all chunks
+    if ((long long)chunks * (largest + 1) <= HISTOGRAM_CELLS)
+    {
+        // Pass 2: per-chunk histograms, merged and walked once per fraction
+        int buckets = largest + 1;
+        int *histograms = new int[(size_t)chunks * buckets]();
+        forEachChunk([&](int chunk, int begin, int end)
+        {
+            int *histogram = histograms + (size_t)chunk * buckets;
+            for (int i = begin; i < end; i++)
+            {
+                int distance = pickupDistances[i];
+                int keep = rowMask(filter, zones[i], states[i], times[i]) & (distance >= 0);
+                histogram[keep ? distance : 0] += keep;
+            }
+        });
+
+        long long *merged = new long long[buckets]();
+        for (int c = 0; c < chunks; c++)
+        {
+            for (int b = 0; b < buckets; b++)
+            {
+                merged[b] += histograms[(size_t)c * buckets + b];
+            }
+        }
+        delete[] histograms;
+
+        for (int f = 0; f < fractionCount; f++)
+        {
+            long long rank = percentileRank(fractions[f], total);
+            long long seen = 0;
+            int b = 0;
+            while (seen + merged[b] <= rank)
+            {
+                seen += merged[b];
+                b++;
+            }
+            out[f] = b;
+        }
+        delete[] merged;
+    }
+    else
+    {
+        // Pass 2: gather the qualifying distances, each chunk into its own slice
+        long long *offsets = new long long[chunks];
+        long long offset = 0;
+        for (int c = 0; c < chunks; c++)
+        {
+            offsets[c] = offset;
+            offset += chunkCounts[c];
+        }
+
+        int *values = new int[total];
+        forEachChunk([&](int chunk, int begin, int end)
+        {
+            int *slot = values + offsets[chunk];
+            for (int i = begin; i < end; i++)
+            {
+                int distance = pickupDistances[i];
+                if (rowMask(filter, zones[i], states[i], times[i]) & (distance >= 0))
+                {
+                    *slot++ = distance;
+                }
+            }
+        });
+        delete[] offsets;
+
+        for (int f = 0; f < fractionCount; f++)
+        {
+            long long rank = percentileRank(fractions[f], total);
+            nth_element(values, values + rank, values + total);
+            out[f] = values[rank];
+        }
+        delete[] values;
+    }
+
+    delete[] chunkCounts;
+    return total;
+}
+
+long long TripAnalytics::cancellationRateByState(const TripFilter &filter, double *rates) const
+{
+    const int *zones = history.getPickupZones();
+    const unsigned char *states = history.getStates();
+    const unsigned char *priorStates = history.getPriorStates();
+    const int *times = history.getFinishTimes();
+
+    // Per chunk: cancellations from each state, then the matching row count
+    const int stride = TRIP_STATE_COUNT + 1;
+    int chunks = getChunkCount();
+    long long *tables = new long long[(size_t)chunks * stride]();
+    forEachChunk([&](int chunk, int begin, int end)
+    {
+        long long cancelledFrom[TRIP_STATE_COUNT] = {0};
+        long long matched = 0;
+        for (int i = begin; i < end; i++)
+        {
+            int keep = rowMask(filter, zones[i], states[i], times[i]);
+            int cancelled = keep & (states[i] == CANCELLED);
+            matched += keep;
+            for (int s = 0; s < TRIP_STATE_COUNT; s++)
+            {
+                cancelledFrom[s] += cancelled & (priorStates[i] == s);
+            }
+        }
+
+        long long *table = tables + (size_t)chunk * stride;
+        for (int s = 0; s < TRIP_STATE_COUNT; s++)
+        {
+            table[s] = cancelledFrom[s];
+        }
+        table[TRIP_STATE_COUNT] = matched;
+    });
+
+    long long matched = 0;
+    for (int c = 0; c < chunks; c++)
+    {
+        matched += tables[(size_t)c * stride + TRIP_STATE_COUNT];
+    }
+    for (int s = 0; s < TRIP_STATE_COUNT; s++)
+    {
+        long long cancelled = 0;
+        for (int c = 0; c < chunks; c++)
+        {
+            cancelled += tables[(size_t)c * stride + s];
+        }
+        rates[s] = matched > 0 ? (double)cancelled / (double)matched : 0.0;
+    }
+    delete[] tables;
+    return matched;
+}
+
+void TripAnalytics::printReport(const TripFilter &filter) const
+{
+    const double fractions[2] = {0.5, 0.95};
+    int percentiles[2] = {-1, -1};
+    double rates[TRIP_STATE_COUNT];
+
+    long long matched = cancellationRateByState(filter, rates);
+    double revenue = totalRevenue(filter);
+    long long assigned = pickupDistancePercentiles(filter, fractions, 2, percentiles);
+
+    cout << "\n=== Trip Analytics ===" << endl;
+    cout << "Matching trips: " << matched << endl;
+    cout << "Revenue: " << revenue << endl;
+    if (assigned > 0)
+    {
+        cout << "Pickup distance p50: " << percentiles[0] << ", p95: " << percentiles[1]
+             << " (" << assigned << " assigned trips)" << endl;
+    }
+    cout << "Cancellation rate by state at cancellation:" << endl;
+    for (int s = REQUESTED; s <= ONGOING; s++)
+    {
+        cout << "  " << Trip::stateToString((TripState)s) << ": " << rates[s] * 100.0 << "%" << endl;
+    }
+    cout << "======================" << endl;
+}
@@ -0,0 +1,164 @@
+#include "TripHistory.h"
+#include <iostream>
+
+using namespace std;
+
+const int INITIAL_HISTORY_CAPACITY = 64;
+
+/**
+ * @brief Copies a column into a larger one and frees the old one
+ */
+template <class T>
+static T *growColumn(T *column, int count, int newCapacity)
+{
+    T *grown = new T[newCapacity];
+    for (int i = 0; i < count; i++)
+    {
+        grown[i] = column[i];
+    }
+    delete[] column;
+    return grown;
+}
+
+// ==================== TripHistory Implementation ====================
+
+TripHistory::TripHistory() : count(0), capacity(INITIAL_HISTORY_CAPACITY)
+{
+    ids = new int[capacity];
+    riders = new int[capacity];
+    drivers = new int[capacity];
+    pickups = new int[capacity];
+    dropoffs = new int[capacity];
+    distances = new int[capacity];
+    fares = new float[capacity];
+    states = new unsigned char[capacity];
+    priorStates = new unsigned char[capacity];
+    pickupDistances = new int[capacity];
+    pickupZones = new int[capacity];
+    finishTimes = new int[capacity];
+}
+
+TripHistory::~TripHistory()
+{
+    delete[] ids;
+    delete[] riders;
+    delete[] drivers;
+    delete[] pickups;
+    delete[] dropoffs;
+    delete[] distances;
+    delete[] fares;
+    delete[] states;
+    delete[] priorStates;
+    delete[] pickupDistances;
+    delete[] pickupZones;
+    delete[] finishTimes;
+}
+
+void TripHistory::grow()
+{
+    int newCapacity = capacity * 2;
+    ids = growColumn(ids, count, newCapacity);
+    riders = growColumn(riders, count, newCapacity);
+    drivers = growColumn(drivers, count, newCapacity);
+    pickups = growColumn(pickups, count, newCapacity);
+    dropoffs = growColumn(dropoffs, count, newCapacity);
+    distances = growColumn(distances, count, newCapacity);
+    fares = growColumn(fares, count, newCapacity);
+    states = growColumn(states, count, newCapacity);
+    priorStates = growColumn(priorStates, count, newCapacity);
+    pickupDistances = growColumn(pickupDistances, count, newCapacity);
+    pickupZones = growColumn(pickupZones, count, newCapacity);
+    finishTimes = growColumn(finishTimes, count, newCapacity);
+    capacity = newCapacity;
+}
+
+int TripHistory::append(const Trip &trip, TripState priorState, int pickupZone, int finishTime)
+{
+    TripRecord row = trip.getRecord();
+    return appendRow(row.id, row.riderId, row.driverId, row.pickupLocation, row.dropoffLocation,
+                     row.distance, row.getFare(), (TripState)row.state, priorState,
+                     row.pickupDistance, pickupZone, finishTime);
+}
+
+int TripHistory::appendRow(int id, int rider, int driver, int pickup, int dropoff, int distance,
+                           float fare, TripState state, TripState priorState, int pickupDistance,
+                           int pickupZone, int finishTime)
+{
+    if (count == capacity)
+    {
+        grow();
+    }
+    ids[count] = id;
+    riders[count] = rider;
+    drivers[count] = driver;
+    pickups[count] = pickup;
+    dropoffs[count] = dropoff;
+    distances[count] = distance;
+    fares[count] = fare;
+    states[count] = (unsigned char)state;
+    priorStates[count] = (unsigned char)priorState;
+    pickupDistances[count] = pickupDistance;
+    pickupZones[count] = pickupZone;
+    finishTimes[count] = finishTime;
+    return count++;
+}
+
+int TripHistory::getCount() const
+{
+    return count;
+}
+
+int TripHistory::findRow(int tripId) const
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (ids[i] == tripId)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const int *TripHistory::getIds() const { return ids; }
+const int *TripHistory::getRiders() const { return riders; }
+const int *TripHistory::getDrivers() const { return drivers; }
+const int *TripHistory::getPickups() const { return pickups; }
+const int *TripHistory::getDropoffs() const { return dropoffs; }
+const int *TripHistory::getDistances() const { return distances; }
+const float *TripHistory::getFares() const { return fares; }
+const unsigned char *TripHistory::getStates() const { return states; }
+const unsigned char *TripHistory::getPriorStates() const { return priorStates; }
+const int *TripHistory::getPickupDistances() const { return pickupDistances; }
+const int *TripHistory::getPickupZones() const { return pickupZones; }
+const int *TripHistory::getFinishTimes() const { return finishTimes; }
+
+long long TripHistory::getMemoryBytes() const
+{
+    return (long long)capacity * (9 * sizeof(int) + sizeof(float) + 2 * sizeof(unsigned char));
+}
+
+void TripHistory::printSummary() const
+{
+    int completed = 0;
+    int cancelled = 0;
+    double revenue = 0.0;
+    for (int i = 0; i < count; i++)
+    {
+        if (states[i] == COMPLETED)
+        {
+            completed++;
+            revenue += fares[i];
+        }
+        else
+        {
+            cancelled++;
+        }
+    }
+
+    cout << "\n=== Trip History ===" << endl;
+    cout << "Finished trips: " << count << " (" << completed << " completed, "
+         << cancelled << " cancelled)" << endl;
+    cout << "Revenue: " << revenue << endl;
+    cout << "====================" << endl;
+}
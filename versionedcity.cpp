@@ -0,0 +1,313 @@
+#include "VersionedCity.h"
+#include <iostream>
+#include <climits>
+#include <thread>
+
+using namespace std;
+
+const long long VersionedCity::IDLE_SLOT = LLONG_MAX;
+
+const int INITIAL_RETIRED_CAPACITY = 4;
+
+// ==================== CitySnapshot Implementation ====================
+
+CitySnapshot::CitySnapshot(const City &city, long long snapshotVersion)
+    : version(snapshotVersion), graph(city), componentLabels(nullptr),
+      zoneCount(0), zoneBounds(nullptr)
+{
+    int nodeCount = graph.getNodeCount();
+    componentLabels = new int[nodeCount > 0 ? nodeCount : 1];
+    for (int i = 0; i < nodeCount; i++)
+    {
+        componentLabels[i] = city.getComponentId(i);
+        int zone = graph.getZone(i);
+        if (zone + 1 > zoneCount)
+        {
+            zoneCount = zone + 1;
+        }
+    }
+
+    zoneBounds = new int[zoneCount > 0 ? zoneCount * zoneCount : 1];
+    for (int a = 0; a < zoneCount; a++)
+    {
+        for (int b = 0; b < zoneCount; b++)
+        {
+            zoneBounds[a * zoneCount + b] = city.getZoneLowerBound(a, b);
+        }
+    }
+}
+
+CitySnapshot::~CitySnapshot()
+{
+    delete[] componentLabels;
+    delete[] zoneBounds;
+}
+
+long long CitySnapshot::getVersion() const
+{
+    return version;
+}
+
+int CitySnapshot::getNodeCount() const
+{
+    return graph.getNodeCount();
+}
+
+const CompactGraph &CitySnapshot::getGraph() const
+{
+    return graph;
+}
+
+int CitySnapshot::getZone(int nodeId) const
+{
+    return graph.getZone(nodeId);
+}
+
+bool CitySnapshot::areConnected(int a, int b) const
+{
+    int nodeCount = graph.getNodeCount();
+    if (a < 0 || a >= nodeCount || b < 0 || b >= nodeCount)
+    {
+        return false;
+    }
+    return componentLabels[a] == componentLabels[b];
+}
+
+int CitySnapshot::getShortestDistance(int source, int destination) const
+{
+    return graph.getShortestDistance(source, destination);
+}
+
+int CitySnapshot::getZoneLowerBound(int zoneA, int zoneB) const
+{
+    if (zoneA < 0 || zoneB < 0 || zoneA >= zoneCount || zoneB >= zoneCount)
+    {
+        return 0;
+    }
+    return zoneBounds[zoneA * zoneCount + zoneB];
+}
+
+// ==================== VersionedCity Implementation ====================
+
+VersionedCity::VersionedCity()
+    : current(nullptr), globalEpoch(0), nextVersion(0), dirty(false),
+      retiredCount(0), retiredCapacity(INITIAL_RETIRED_CAPACITY)
+{
+    for (int i = 0; i < MAX_READERS; i++)
+    {
+        readerEpochs[i].store(IDLE_SLOT);
+    }
+    retired = new const CitySnapshot *[retiredCapacity];
+    retiredEpochs = new long long[retiredCapacity];
+
+    master.enableZoneBounds();
+    current.store(new CitySnapshot(master, nextVersion++));
+}
+
+VersionedCity::~VersionedCity()
+{
+    delete current.load();
+    for (int i = 0; i < retiredCount; i++)
+    {
+        delete retired[i];
+    }
+    delete[] retired;
+    delete[] retiredEpochs;
+}
+
+bool VersionedCity::addLocation(int id)
+{
+    lock_guard<mutex> lock(writerMutex);
+    bool added = master.addLocation(id);
+    dirty = dirty || added;
+    return added;
+}
+
+bool VersionedCity::addRoad(int from, int to, int distance)
+{
+    lock_guard<mutex> lock(writerMutex);
+    bool added = master.addRoad(from, to, distance);
+    dirty = dirty || added;
+    return added;
+}
+
+bool VersionedCity::setZone(int nodeId, int zoneId)
+{
+    lock_guard<mutex> lock(writerMutex);
+    bool changed = master.setZone(nodeId, zoneId);
+    dirty = dirty || changed;
+    return changed;
+}
+
+bool VersionedCity::setRoadWeight(int from, int to, int distance)
+{
+    lock_guard<mutex> lock(writerMutex);
+    bool changed = master.setRoadWeight(from, to, distance);
+    dirty = dirty || changed;
+    return changed;
+}
+
+bool VersionedCity::removeRoad(int from, int to)
+{
+    lock_guard<mutex> lock(writerMutex);
+    bool removed = master.removeRoad(from, to);
+    dirty = dirty || removed;
+    return removed;
+}
+
+int VersionedCity::applyRoadUpdates(const City::RoadUpdate *updates, int count)
+{
+    lock_guard<mutex> lock(writerMutex);
+    int applied = master.applyRoadUpdates(updates, count);
+    dirty = dirty || applied > 0;
+    return applied;
+}
+
+long long VersionedCity::publish()
+{
+    lock_guard<mutex> lock(writerMutex);
+    if (!dirty)
+    {
+        return current.load()->getVersion();
+    }
+
+    master.prepareForConcurrentReads();
+    const CitySnapshot *next = new CitySnapshot(master, nextVersion++);
+    dirty = false;
+
+    // The only step readers can observe
+    const CitySnapshot *previous = current.exchange(next);
+
+    if (retiredCount == retiredCapacity)
+    {
+        int newCapacity = retiredCapacity * 2;
+        const CitySnapshot **newRetired = new const CitySnapshot *[newCapacity];
+        long long *newEpochs = new long long[newCapacity];
+        for (int i = 0; i < retiredCount; i++)
+        {
+            newRetired[i] = retired[i];
+            newEpochs[i] = retiredEpochs[i];
+        }
+        delete[] retired;
+        delete[] retiredEpochs;
+        retired = newRetired;
+        retiredEpochs = newEpochs;
+        retiredCapacity = newCapacity;
+    }
+
+    // Readers that may hold previous entered at or before this epoch
+    retired[retiredCount] = previous;
+    retiredEpochs[retiredCount] = globalEpoch.fetch_add(1);
+    retiredCount++;
+
+    reclaimLocked();
+    return next->getVersion();
+}
+
+int VersionedCity::reclaimLocked()
+{
+    long long oldestReader = IDLE_SLOT;
+    for (int i = 0; i < MAX_READERS; i++)
+    {
+        long long epoch = readerEpochs[i].load();
+        if (epoch < oldestReader)
+        {
+            oldestReader = epoch;
+        }
+    }
+
+    int freed = 0;
+    int kept = 0;
+    for (int i = 0; i < retiredCount; i++)
+    {
+        if (retiredEpochs[i] < oldestReader)
+        {
+            delete retired[i];
+            freed++;
+        }
+        else
+        {
+            retired[kept] = retired[i];
+            retiredEpochs[kept] = retiredEpochs[i];
+            kept++;
+        }
+    }
+    retiredCount = kept;
+    return freed;
+}
+
+int VersionedCity::reclaim()
+{
+    lock_guard<mutex> lock(writerMutex);
+    return reclaimLocked();
+}
+
+long long VersionedCity::getVersion() const
+{
+    return current.load()->getVersion();
+}
+
+int VersionedCity::getRetiredCount()
+{
+    lock_guard<mutex> lock(writerMutex);
+    return retiredCount;
+}
+
+void VersionedCity::printStatus()
+{
+    lock_guard<mutex> lock(writerMutex);
+    int activeReaders = 0;
+    for (int i = 0; i < MAX_READERS; i++)
+    {
+        if (readerEpochs[i].load() != IDLE_SLOT)
+        {
+            activeReaders++;
+        }
+    }
+
+    cout << "\n=== Versioned City Status ===" << endl;
+    cout << "Current version: " << current.load()->getVersion()
+         << (dirty ? " (unpublished edits pending)" : "") << endl;
+    cout << "Epoch: " << globalEpoch.load() << ", Active readers: " << activeReaders << endl;
+    cout << "Retired snapshots awaiting reclamation: " << retiredCount << endl;
+    cout << "=============================" << endl;
+}
+
+// ==================== SnapshotReader Implementation ====================
+
+SnapshotReader::SnapshotReader(VersionedCity &city) : owner(city), slot(-1), snapshot(nullptr)
+{
+    // Announce the epoch before loading the pointer, so publish() cannot free what we load
+    while (slot == -1)
+    {
+        for (int i = 0; i < VersionedCity::MAX_READERS; i++)
+        {
+            long long idle = VersionedCity::IDLE_SLOT;
+            if (owner.readerEpochs[i].compare_exchange_strong(idle, owner.globalEpoch.load()))
+            {
+                slot = i;
+                break;
+            }
+        }
+        if (slot == -1)
+        {
+            this_thread::yield(); // Every slot busy; readers are short-lived
+        }
+    }
+    snapshot = owner.current.load();
+}
+
+SnapshotReader::~SnapshotReader()
+{
+    owner.readerEpochs[slot].store(VersionedCity::IDLE_SLOT);
+}
+
+const CitySnapshot &SnapshotReader::get() const
+{
+    return *snapshot;
+}
+
+const CitySnapshot *SnapshotReader::operator->() const
+{
+    return snapshot;
+}
@@ -0,0 +1,448 @@
+#include "WriteAheadLog.h"
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const int INITIAL_BUFFER_CAPACITY = 4096;
+const int CHECKSUM_OFFSET = 32;
+
+/**
+ * @brief Forces a stdio stream's bytes to stable storage
+ * @return false if the flush or sync failed
+ */
+static bool syncFile(FILE *file)
+{
+    if (fflush(file) != 0)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+/**
+ * @brief Cuts a file back to a given size
+ * @return false if the file could not be truncated
+ */
+static bool truncateFile(FILE *file, long long size)
+{
+    clearerr(file);
+#ifdef _WIN32
+    return _chsize_s(_fileno(file), size) == 0;
+#else
+    return ftruncate(fileno(file), (off_t)size) == 0;
+#endif
+}
+
+/**
+ * @brief FNV-1a over a byte range
+ */
+static unsigned int checksum(const unsigned char *bytes, int count)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < count; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void writeInt(unsigned char *out, unsigned int value)
+{
+    for (int b = 0; b < 4; b++)
+    {
+        out[b] = (unsigned char)(value >> (8 * b));
+    }
+}
+
+static unsigned int readInt(const unsigned char *in)
+{
+    unsigned int value = 0;
+    for (int b = 0; b < 4; b++)
+    {
+        value |= (unsigned int)in[b] << (8 * b);
+    }
+    return value;
+}
+
+// ==================== WriteAheadLog Implementation ====================
+
+WriteAheadLog::WriteAheadLog(const char *path, WalSyncPolicy syncPolicy,
+                             int recordsPerGroup, int flushInterval)
+    : file(nullptr), policy(syncPolicy),
+      groupSize(syncPolicy == WAL_SYNC_ALWAYS || recordsPerGroup < 1 ? 1 : recordsPerGroup),
+      bufferBytes(0), bufferCapacity(INITIAL_BUFFER_CAPACITY),
+      commitCapacity(INITIAL_BUFFER_CAPACITY), pendingRecords(0),
+      lastLsn(0), durableLsn(0), fileBytes(0), commitCount(0), syncCount(0),
+      flushIntervalMs(flushInterval > 0 ? flushInterval : 0), stopping(false)
+{
+    buffer = new unsigned char[bufferCapacity];
+    commitBuffer = new unsigned char[commitCapacity];
+
+    // Continue after the last valid record, dropping any torn tail
+    long long validBytes = 0;
+    {
+        WalReader reader(path);
+        WalRecord record;
+        while (reader.next(record))
+        {
+            lastLsn = record.lsn;
+        }
+        validBytes = reader.getValidBytes();
+        if (reader.hasTornTail())
+        {
+            cout << "Warning: Discarding torn tail of log " << path << " after LSN "
+                 << lastLsn << endl;
+            error_code ignored;
+            filesystem::resize_file(path, (uintmax_t)validBytes, ignored);
+        }
+    }
+    durableLsn = lastLsn;
+    fileBytes = validBytes;
+
+    file = fopen(path, "ab");
+    if (file == nullptr)
+    {
+        cout << "Error: Cannot open log file " << path << "!" << endl;
+        return;
+    }
+    // Groups are written whole; without a stdio buffer a failed write leaves nothing behind to flush later
+    setvbuf(file, nullptr, _IONBF, 0);
+
+    if (flushIntervalMs > 0 && groupSize > 1)
+    {
+        flusher = thread(&WriteAheadLog::flusherLoop, this);
+    }
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        stopping = true;
+    }
+    flusherWake.notify_all();
+    if (flusher.joinable())
+    {
+        flusher.join();
+    }
+
+    if (file != nullptr)
+    {
+        commit();
+        fclose(file);
+    }
+    delete[] buffer;
+    delete[] commitBuffer;
+}
+
+bool WriteAheadLog::isOpen() const
+{
+    return file != nullptr;
+}
+
+void WriteAheadLog::flusherLoop()
+{
+    unique_lock<mutex> lock(bufferMutex);
+    while (!stopping)
+    {
+        flusherWake.wait_for(lock, chrono::milliseconds(flushIntervalMs));
+        if (pendingRecords > 0 && !stopping)
+        {
+            lock.unlock();
+            commit();
+            lock.lock();
+        }
+    }
+}
+
+long long WriteAheadLog::append(WalRecordType type, int f0, int f1, int f2, int f3, int f4)
+{
+    if (file == nullptr)
+    {
+        return -1;
+    }
+
+    WalRecord record;
+    record.type = type;
+    record.fields[0] = f0;
+    record.fields[1] = f1;
+    record.fields[2] = f2;
+    record.fields[3] = f3;
+    record.fields[4] = f4;
+
+    bool groupFull = false;
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        if (bufferBytes + RECORD_SIZE > bufferCapacity)
+        {
+            int newCapacity = bufferCapacity * 2;
+            unsigned char *newBuffer = new unsigned char[newCapacity];
+            for (int i = 0; i < bufferBytes; i++)
+            {
+                newBuffer[i] = buffer[i];
+            }
+            delete[] buffer;
+            buffer = newBuffer;
+            bufferCapacity = newCapacity;
+        }
+
+        // LSN and buffer position are assigned together, so the buffer is in LSN order
+        record.lsn = ++lastLsn;
+        encode(record, buffer + bufferBytes);
+        bufferBytes += RECORD_SIZE;
+        pendingRecords++;
+        groupFull = pendingRecords >= groupSize;
+    }
+
+    if (groupFull)
+    {
+        commit();
+    }
+    return record.lsn;
+}
+
+long long WriteAheadLog::commit()
+{
+    if (file == nullptr)
+    {
+        return durableLsn;
+    }
+
+    lock_guard<mutex> commitLock(commitMutex);
+
+    int bytes;
+    long long upTo;
+    {
+        // Take the whole group; appenders continue into the other buffer
+        lock_guard<mutex> lock(bufferMutex);
+        if (pendingRecords == 0)
+        {
+            return durableLsn;
+        }
+        unsigned char *swapBuffer = commitBuffer;
+        int swapCapacity = commitCapacity;
+        commitBuffer = buffer;
+        commitCapacity = bufferCapacity;
+        buffer = swapBuffer;
+        bufferCapacity = swapCapacity;
+
+        bytes = bufferBytes;
+        upTo = lastLsn;
+        bufferBytes = 0;
+        pendingRecords = 0;
+    }
+
+    bool synced = policy != WAL_SYNC_NONE;
+    bool written = fwrite(commitBuffer, 1, (size_t)bytes, file) == (size_t)bytes;
+    if (written)
+    {
+        written = synced ? syncFile(file) : fflush(file) == 0;
+    }
+
+    if (!written)
+    {
+        // Drop whatever part reached the file, so no later record follows a torn one
+        cout << "Error: Cannot write log records up to LSN " << upTo << "; keeping them pending!" << endl;
+        if (!truncateFile(file, fileBytes))
+        {
+            cout << "Error: Cannot cut the log back to " << fileBytes << " bytes!" << endl;
+        }
+        requeueGroup(bytes);
+        lock_guard<mutex> lock(bufferMutex);
+        return durableLsn;
+    }
+
+    lock_guard<mutex> lock(bufferMutex);
+    fileBytes += bytes;
+    durableLsn = upTo;
+    commitCount++;
+    if (synced)
+    {
+        syncCount++;
+    }
+    return durableLsn;
+}
+
+void WriteAheadLog::requeueGroup(int bytes)
+{
+    lock_guard<mutex> lock(bufferMutex);
+
+    // Records appended meanwhile have higher LSNs, so they go after the group
+    if (bytes + bufferBytes > commitCapacity)
+    {
+        int newCapacity = commitCapacity * 2;
+        while (newCapacity < bytes + bufferBytes)
+        {
+            newCapacity *= 2;
+        }
+        unsigned char *newBuffer = new unsigned char[newCapacity];
+        for (int i = 0; i < bytes; i++)
+        {
+            newBuffer[i] = commitBuffer[i];
+        }
+        delete[] commitBuffer;
+        commitBuffer = newBuffer;
+        commitCapacity = newCapacity;
+    }
+    for (int i = 0; i < bufferBytes; i++)
+    {
+        commitBuffer[bytes + i] = buffer[i];
+    }
+
+    unsigned char *swapBuffer = buffer;
+    int swapCapacity = bufferCapacity;
+    buffer = commitBuffer;
+    bufferCapacity = commitCapacity;
+    commitBuffer = swapBuffer;
+    commitCapacity = swapCapacity;
+
+    bufferBytes += bytes;
+    pendingRecords += bytes / RECORD_SIZE;
+}
+
+bool WriteAheadLog::waitDurable(long long lsn)
+{
+    {
+        lock_guard<mutex> lock(bufferMutex);
+        if (durableLsn >= lsn)
+        {
+            return true;
+        }
+    }
+    // Whoever commits next writes every pending record, so one commit is enough
+    return commit() >= lsn;
+}
+
+void WriteAheadLog::continueAfter(long long lsn)
+{
+    // Commit first so no buffered record keeps a number below the new ones
+    commit();
+
+    lock_guard<mutex> lock(bufferMutex);
+    if (lastLsn < lsn && pendingRecords == 0)
+    {
+        lastLsn = lsn;
+        durableLsn = lsn;
+    }
+}
+
+long long WriteAheadLog::getLastLsn()
+{
+    lock_guard<mutex> lock(bufferMutex);
+    return lastLsn;
+}
+
+long long WriteAheadLog::getDurableLsn()
+{
+    lock_guard<mutex> lock(bufferMutex);
+    return durableLsn;
+}
+
+long long WriteAheadLog::getCommitCount()
+{
+    lock_guard<mutex> lock(bufferMutex);
+    return commitCount;
+}
+
+long long WriteAheadLog::getSyncCount()
+{
+    lock_guard<mutex> lock(bufferMutex);
+    return syncCount;
+}
+
+void WriteAheadLog::encode(const WalRecord &record, unsigned char *out)
+{
+    out[0] = (unsigned char)record.type;
+    out[1] = out[2] = out[3] = 0;
+    writeInt(out + 4, (unsigned int)(record.lsn & 0xFFFFFFFFLL));
+    writeInt(out + 8, (unsigned int)(record.lsn >> 32));
+    for (int i = 0; i < WalRecord::FIELD_COUNT; i++)
+    {
+        writeInt(out + 12 + 4 * i, (unsigned int)record.fields[i]);
+    }
+    writeInt(out + CHECKSUM_OFFSET, checksum(out, CHECKSUM_OFFSET));
+}
+
+bool WriteAheadLog::decode(const unsigned char *in, WalRecord &record)
+{
+    if (readInt(in + CHECKSUM_OFFSET) != checksum(in, CHECKSUM_OFFSET))
+    {
+        return false;
+    }
+    if (in[0] < WAL_DRIVER_REGISTERED || in[0] > WAL_TRIP_TOLL)
+    {
+        return false;
+    }
+
+    record.type = (WalRecordType)in[0];
+    record.lsn = (long long)readInt(in + 4) | ((long long)readInt(in + 8) << 32);
+    for (int i = 0; i < WalRecord::FIELD_COUNT; i++)
+    {
+        record.fields[i] = (int)readInt(in + 12 + 4 * i);
+    }
+    return true;
+}
+
+// ==================== WalReader Implementation ====================
+
+WalReader::WalReader(const char *path) : file(nullptr), validBytes(0), tornTail(false)
+{
+    file = fopen(path, "rb");
+}
+
+WalReader::~WalReader()
+{
+    if (file != nullptr)
+    {
+        fclose(file);
+    }
+}
+
+bool WalReader::isOpen() const
+{
+    return file != nullptr;
+}
+
+bool WalReader::next(WalRecord &record)
+{
+    if (file == nullptr || tornTail)
+    {
+        return false;
+    }
+
+    unsigned char bytes[WriteAheadLog::RECORD_SIZE];
+    size_t got = fread(bytes, 1, sizeof(bytes), file);
+    if (got == 0)
+    {
+        return false; // Clean end of log
+    }
+    if (got < sizeof(bytes) || !WriteAheadLog::decode(bytes, record))
+    {
+        tornTail = true;
+        return false;
+    }
+
+    validBytes += WriteAheadLog::RECORD_SIZE;
+    return true;
+}
+
+long long WalReader::getValidBytes() const
+{
+    return validBytes;
+}
+
+bool WalReader::hasTornTail() const
+{
+    return tornTail;
+}
@@ -0,0 +1,278 @@
+#include "ZoneDistanceMatrix.h"
+#include "Citydj.h"
+#include "MinHeap.h"
+#include <iostream>
+#include <climits>
+
+using namespace std;
+
+// ==================== ZoneDistanceMatrix Implementation ====================
+
+ZoneDistanceMatrix::ZoneDistanceMatrix(const City *cityPtr)
+    : city(cityPtr), zoneCount(0), nodeCount(0), bounds(nullptr),
+      rowDistances(nullptr), zones(nullptr), stale(true),
+      scratchNeighbors(nullptr), scratchDistances(nullptr), scratchCapacity(0) {}
+
+ZoneDistanceMatrix::~ZoneDistanceMatrix()
+{
+    release();
+    delete[] scratchNeighbors;
+    delete[] scratchDistances;
+}
+
+int ZoneDistanceMatrix::loadRoads(int nodeId)
+{
+    int degree = city->getRoadCount(nodeId);
+    if (degree > scratchCapacity)
+    {
+        delete[] scratchNeighbors;
+        delete[] scratchDistances;
+        scratchCapacity = degree * 2;
+        scratchNeighbors = new int[scratchCapacity];
+        scratchDistances = new int[scratchCapacity];
+    }
+    return city->getRoads(nodeId, scratchNeighbors, scratchDistances);
+}
+
+void ZoneDistanceMatrix::release()
+{
+    for (int z = 0; z < zoneCount; z++)
+    {
+        delete[] rowDistances[z];
+    }
+    delete[] rowDistances;
+    delete[] bounds;
+    delete[] zones;
+
+    rowDistances = nullptr;
+    bounds = nullptr;
+    zones = nullptr;
+    zoneCount = 0;
+    nodeCount = 0;
+}
+
+void ZoneDistanceMatrix::invalidate()
+{
+    stale = true;
+}
+
+void ZoneDistanceMatrix::refresh()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+}
+
+void ZoneDistanceMatrix::rebuild()
+{
+    release();
+
+    nodeCount = city->getNodeCount();
+    zones = new int[nodeCount > 0 ? nodeCount : 1];
+
+    int maxZone = -1;
+    for (int i = 0; i < nodeCount; i++)
+    {
+        zones[i] = city->getZone(i);
+        if (zones[i] > maxZone)
+        {
+            maxZone = zones[i];
+        }
+    }
+
+    zoneCount = maxZone + 1;
+    bounds = new int[zoneCount * zoneCount > 0 ? zoneCount * zoneCount : 1];
+    rowDistances = new int *[zoneCount > 0 ? zoneCount : 1];
+    for (int z = 0; z < zoneCount; z++)
+    {
+        rowDistances[z] = new int[nodeCount > 0 ? nodeCount : 1];
+    }
+
+    for (int z = 0; z < zoneCount; z++)
+    {
+        recomputeRow(z);
+    }
+    stale = false;
+}
+
+void ZoneDistanceMatrix::recomputeRow(int zone)
+{
+    int *distance = rowDistances[zone];
+    MinHeap heap(64);
+
+    // Every location of the zone is a source at distance 0
+    for (int i = 0; i < nodeCount; i++)
+    {
+        distance[i] = INT_MAX;
+        if (zones[i] == zone)
+        {
+            distance[i] = 0;
+            heap.push(0, i);
+        }
+    }
+
+    int d, u;
+    while (heap.pop(d, u))
+    {
+        if (d > distance[u])
+        {
+            continue;
+        }
+        int degree = loadRoads(u);
+        for (int j = 0; j < degree; j++)
+        {
+            int v = scratchNeighbors[j];
+            if (d + scratchDistances[j] < distance[v])
+            {
+                distance[v] = d + scratchDistances[j];
+                heap.push(distance[v], v);
+            }
+        }
+    }
+
+    // Minimum over each target zone, mirrored into the column
+    for (int b = 0; b < zoneCount; b++)
+    {
+        bounds[zone * zoneCount + b] = INT_MAX;
+    }
+    for (int i = 0; i < nodeCount; i++)
+    {
+        int b = zones[i];
+        if (b >= 0 && distance[i] < bounds[zone * zoneCount + b])
+        {
+            bounds[zone * zoneCount + b] = distance[i];
+        }
+    }
+    for (int b = 0; b < zoneCount; b++)
+    {
+        bounds[b * zoneCount + zone] = bounds[zone * zoneCount + b];
+    }
+}
+
+void ZoneDistanceMatrix::repairRow(int zone, int seed)
+{
+    int *distance = rowDistances[zone];
+    MinHeap heap(16);
+    heap.push(distance[seed], seed);
+
+    // Only locations whose distance improved are ever pushed
+    int d, u;
+    while (heap.pop(d, u))
+    {
+        if (d > distance[u])
+        {
+            continue;
+        }
+
+        int b = zones[u];
+        if (b >= 0 && d < bounds[zone * zoneCount + b])
+        {
+            bounds[zone * zoneCount + b] = d;
+            bounds[b * zoneCount + zone] = d;
+        }
+
+        int degree = loadRoads(u);
+        for (int j = 0; j < degree; j++)
+        {
+            int v = scratchNeighbors[j];
+            if (d + scratchDistances[j] < distance[v])
+            {
+                distance[v] = d + scratchDistances[j];
+                heap.push(distance[v], v);
+            }
+        }
+    }
+}
+
+void ZoneDistanceMatrix::onRoadAdded(int from, int to, int distance)
+{
+    if (stale)
+    {
+        return; // Will be rebuilt anyway
+    }
+    if (from < 0 || to < 0 || from >= nodeCount || to >= nodeCount)
+    {
+        invalidate();
+        return;
+    }
+
+    for (int z = 0; z < zoneCount; z++)
+    {
+        int *row = rowDistances[z];
+        if (row[from] != INT_MAX && row[from] + distance < row[to])
+        {
+            row[to] = row[from] + distance;
+            repairRow(z, to);
+        }
+        else if (row[to] != INT_MAX && row[to] + distance < row[from])
+        {
+            row[from] = row[to] + distance;
+            repairRow(z, from);
+        }
+    }
+}
+
+void ZoneDistanceMatrix::onZoneChanged(int nodeId, int oldZone, int newZone)
+{
+    if (stale)
+    {
+        return;
+    }
+    if (nodeId < 0 || nodeId >= nodeCount || newZone >= zoneCount)
+    {
+        invalidate(); // New zone ID or unknown location: matrix must grow
+        return;
+    }
+
+    zones[nodeId] = newZone;
+    if (oldZone >= 0 && oldZone != newZone)
+    {
+        recomputeRow(oldZone);
+    }
+    if (newZone >= 0)
+    {
+        recomputeRow(newZone);
+    }
+}
+
+int ZoneDistanceMatrix::getLowerBound(int zoneA, int zoneB)
+{
+    if (zoneA < 0 || zoneB < 0 || zoneA == zoneB)
+    {
+        return 0;
+    }
+    if (stale)
+    {
+        rebuild();
+    }
+    if (zoneA >= zoneCount || zoneB >= zoneCount)
+    {
+        return 0;
+    }
+    return bounds[zoneA * zoneCount + zoneB];
+}
+
+void ZoneDistanceMatrix::print()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+
+    cout << "\n=== Zone Lower-Bound Distances ===" << endl;
+    for (int a = 0; a < zoneCount; a++)
+    {
+        cout << "Zone " << a << ":";
+        for (int b = 0; b < zoneCount; b++)
+        {
+            int value = bounds[a * zoneCount + b];
+            if (value == INT_MAX)
+                cout << " INF";
+            else
+                cout << " " << value;
+        }
+        cout << endl;
+    }
+    cout << "==================================" << endl;
+}